@@ -1,114 +1,413 @@
 #pragma once
-#include <xmemory>
 #include <utility.h>
+#include <platform/platform.h>
+#include <memory/aligned_allocator.h>
+#include <containers/detail/bulk_memory.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
 
 namespace audio {
+  /// Sample layout of interleaved float PCM.
+  struct audio_format {
+    std::uint32_t sample_rate = 0; // Hz; 0 when unknown (durations are then 0)
+    std::uint16_t channels = 1;    // interleaved channels per frame
 
-  template<typename Alloc = std::allocator<float>>
+    /// Time covered by n frames, truncated to whole nanoseconds.
+    NODISCARD CONSTEXPR std::chrono::nanoseconds duration(std::size_t n) const noexcept {
+      if (sample_rate == 0) return std::chrono::nanoseconds{ 0 };
+      return std::chrono::nanoseconds{ static_cast<std::int64_t>(
+        (static_cast<std::uint64_t>(n) * 1'000'000'000ull) / sample_rate) };
+    }
+
+    /// Whole frames that fit in d.
+    NODISCARD CONSTEXPR std::size_t frames_in(std::chrono::nanoseconds d) const noexcept {
+      if (d.count() <= 0) return 0;
+      return static_cast<std::size_t>((static_cast<std::uint64_t>(d.count()) * sample_rate) / 1'000'000'000ull);
+    }
+
+    NODISCARD CONSTEXPR bool operator==(const audio_format&) const noexcept = default;
+  };
+
+  /**
+   * @brief Non-owning window of interleaved float frames: where it starts in its source
+   *        buffer, how many frames it covers, their format and capture time.
+   *
+   * @details Two pointers and a few integers, so stages pass it by value. The timestamp is the
+   *          one of the source buffer's first frame; start_time() adds the offset, so a slice
+   *          keeps its position on the capture clock. A view is invalidated by anything that
+   *          reallocates or clears its source.
+   */
+  class audio_view {
+  public:
+    using value_type = float;
+    using size_type = std::size_t;
+    using const_pointer = const float*;
+    using const_iterator = const float*;
+
+    CONSTEXPR audio_view() noexcept = default;
+
+    /// @param base First frame of the source; offset and frames are in frames from there.
+    CONSTEXPR audio_view(const float* base, size_type offset, size_type frames, audio_format format,
+                         std::chrono::nanoseconds base_time = {}) noexcept
+      : _base(base), _offset(offset), _frames(frames), _format(format), _base_time(base_time) {
+    }
+
+    NODISCARD CONSTEXPR const float* data() const noexcept { return _base + _offset * _format.channels; }
+    NODISCARD CONSTEXPR size_type offset() const noexcept { return _offset; }
+    NODISCARD CONSTEXPR size_type frames() const noexcept { return _frames; }
+    NODISCARD CONSTEXPR size_type size() const noexcept { return _frames * _format.channels; }
+    NODISCARD CONSTEXPR bool empty() const noexcept { return _frames == 0; }
+
+    NODISCARD CONSTEXPR const audio_format& format() const noexcept { return _format; }
+    NODISCARD CONSTEXPR std::uint32_t sample_rate() const noexcept { return _format.sample_rate; }
+    NODISCARD CONSTEXPR std::uint16_t channels() const noexcept { return _format.channels; }
+
+    NODISCARD CONSTEXPR std::chrono::nanoseconds start_time() const noexcept { return _base_time + _format.duration(_offset); }
+    NODISCARD CONSTEXPR std::chrono::nanoseconds end_time() const noexcept { return _base_time + _format.duration(_offset + _frames); }
+    NODISCARD CONSTEXPR std::chrono::nanoseconds duration() const noexcept { return end_time() - start_time(); }
+
+    /// Sample of one channel in a frame relative to the view.
+    NODISCARD CONSTEXPR float sample(size_type frame, std::uint16_t channel = 0) const noexcept {
+      ASSERT_ABORT(frame < _frames && channel < _format.channels, "audio_view: sample out of range");
+      return data()[frame * _format.channels + channel];
+    }
+    NODISCARD CONSTEXPR float operator[](size_type i) const noexcept {
+      ASSERT_ABORT(i < size(), "audio_view: index out of range");
+      return data()[i];
+    }
+
+    NODISCARD CONSTEXPR const_iterator begin() const noexcept { return data(); }
+    NODISCARD CONSTEXPR const_iterator end() const noexcept { return data() + size(); }
+    NODISCARD CONSTEXPR std::span<const float> samples() const noexcept { return { data(), size() }; }
+
+    /// Frames [offset, offset + count) of this view; count is clamped to what is left.
+    NODISCARD CONSTEXPR audio_view subview(size_type offset, size_type count = static_cast<size_type>(-1)) const noexcept {
+      ASSERT_ABORT(offset <= _frames, "audio_view: subview offset out of range");
+      return audio_view(_base, _offset + offset, std::min(count, _frames - offset), _format, _base_time);
+    }
+    NODISCARD CONSTEXPR audio_view first(size_type count) const noexcept { return subview(0, count); }
+    NODISCARD CONSTEXPR audio_view last(size_type count) const noexcept {
+      return subview(_frames - std::min(count, _frames));
+    }
+
+    /// Frames inside [from, to) of the capture clock, clamped to the view.
+    NODISCARD CONSTEXPR audio_view between(std::chrono::nanoseconds from, std::chrono::nanoseconds to) const noexcept {
+      const std::chrono::nanoseconds start = start_time();
+      const size_type lo = std::min(from > start ? _format.frames_in(from - start) : 0, _frames);
+      const size_type hi = std::min(to > start ? _format.frames_in(to - start) : 0, _frames);
+      return subview(lo, hi > lo ? hi - lo : 0);
+    }
+
+  private:
+    const float* _base = nullptr;
+    size_type _offset = 0;
+    size_type _frames = 0;
+    audio_format _format{};
+    std::chrono::nanoseconds _base_time{ 0 };
+  };
+
+  /**
+   * @brief Growable buffer of interleaved float PCM with its format and capture timestamp.
+   *
+   * @details Storage comes from Alloc, by default 64 B aligned and padded to whole cache lines,
+   *          so SIMD kernels can load full vectors at the start and the tail. Sizes are in
+   *          samples; the *_frames members and view() work in frames of format().channels.
+   *          Samples added by resize() are silence (0.0f).
+   */
+  template<typename Alloc = voxory::memory::aligned_allocator<float>>
   class audio_buffer {
     using FirstOneSecondArgs = utility::detail::FirstOneSecondArgs;
     using FirstZeroSecondArgs = utility::detail::FirstZeroSecondArgs;
   public:
     using allocator_type = Alloc;
     using allocator_traits = std::allocator_traits<allocator_type>;
-    using value_type = typename allocator_traits::value_type;        //   float
+    using value_type = typename allocator_traits::value_type;
     using size_type = typename allocator_traits::size_type;
     using pointer = typename allocator_traits::pointer;
     using const_pointer = typename allocator_traits::const_pointer;
     using reference = value_type&;
     using const_reference = const value_type&;
-    using iterator = pointer;
-    using const_iterator = const_pointer;
+    using iterator = value_type*;
+    using const_iterator = const value_type*;
 
     static_assert(std::is_same_v<value_type, float>, "Allocator::value_type must be float");
 
-    audio_buffer() noexcept(std::is_nothrow_constructible_v<utility::compressed_pair<allocator_type, pointer>, FirstZeroSecondArgs>) : pair_(FirstZeroSecondArgs{}) {};
-    explicit audio_buffer(size_type n, const allocator_type& alloc = allocator_type())
-      noexcept(std::is_nothrow_default_constructible_v<allocator_type>&& std::is_nothrow_copy_assignable_v<allocator_type>)
-      : pair_(FirstOneSecondArgs{}, std::forward<allocator_type&>(alloc)) 
-    {
-      pair_.second() = allocate_block(n);
-      capacity_ = n;
-
-      utility::uninitialized_default_construct_n(pair_.first(), pair_.second(), frames);
-    };
-    audio_buffer(const_pointer src, size_type n, const allocator_type& alloc = allocator_type()) noexcept(std::is_nothrow_default_constructible_v<allocator_type>) {
-      
-    };
-    audio_buffer(const audio_buffer& other) noexcept();
-    audio_buffer(audio_buffer&& other) noexcept(std::is_nothrow_move_constructible_v<allocator_type>);
-    audio_buffer(size_type n, allocator_type&& alloc) noexcept(std::is_nothrow_move_constructible_v<allocator_type>);
-    audio_buffer& operator=(const audio_buffer& other) noexcept(std::is_nothrow_copy_assignable_v<allocator_type>);
-    audio_buffer& operator=(audio_buffer&& other) noexcept(std::is_nothrow_move_assignable_v<allocator_type>);
-    void operator>>(const value_type& v) noexcept();
-    void operator>>(value_type&& v) noexcept();
-    void operator<<(const value_type& v) noexcept();
-    void operator<<(value_type&& v) noexcept();
-    ~audio_buffer();
-
-    //  
-    _CONSTEXPR20 void reserve(size_type n);
-    _CONSTEXPR20 void resize(size_type n);
-    _CONSTEXPR20 void shrink_to_fit();
-    _CONSTEXPR20 void clear() noexcept;
-
-    _NODISCARD _CONSTEXPR20 size_type size() const noexcept { return size_; }
-    _NODISCARD _CONSTEXPR20 size_type capacity() const noexcept { return capacity_; }
-    _NODISCARD _CONSTEXPR20 bool empty() const noexcept { return size_ == 0; }
-
-    _NODISCARD _CONSTEXPR20 pointer data() noexcept;
-    _NODISCARD _CONSTEXPR20 const_pointer data() const noexcept;
-
-    // Random access
-    _NODISCARD _CONSTEXPR20 reference operator[](size_type i);
-    _NODISCARD _CONSTEXPR20 const_reference operator[](size_type i) const;
-    _NODISCARD _CONSTEXPR20 reference at(size_type i);
-    _NODISCARD _CONSTEXPR20 const_reference at(size_type i) const;
-
-    // Iterators
-    _NODISCARD _CONSTEXPR20 iterator begin() noexcept;
-    _NODISCARD _CONSTEXPR20 const_iterator begin() const noexcept;
-    _NODISCARD _CONSTEXPR20 iterator end() noexcept;
-    _NODISCARD _CONSTEXPR20 const_iterator end() const noexcept;
-    _NODISCARD _CONSTEXPR20 const_iterator cbegin() const noexcept;
-    _NODISCARD _CONSTEXPR20 const_iterator cend() const noexcept;
-
-    // 
-    _CONSTEXPR20 void push_back(const value_type& v);
-    _CONSTEXPR20 void push_back(value_type&& v);
+    audio_buffer() noexcept(std::is_nothrow_default_constructible_v<allocator_type>) : _pair(FirstZeroSecondArgs{}, nullptr) {}
+
+    explicit audio_buffer(const allocator_type& alloc) noexcept : _pair(FirstOneSecondArgs{}, alloc, nullptr) {}
+
+    /// n samples of silence, mono, unknown rate.
+    explicit audio_buffer(size_type n, const allocator_type& alloc = allocator_type()) : _pair(FirstOneSecondArgs{}, alloc, nullptr) {
+      resize(n);
+    }
+
+    /// frames frames of silence in the given format.
+    audio_buffer(audio_format format, size_type frames, const allocator_type& alloc = allocator_type())
+      : _pair(FirstOneSecondArgs{}, alloc, nullptr), _format(format) {
+      resize_frames(frames);
+    }
+
+    /// Copies n interleaved samples of the given format.
+    audio_buffer(const float* src, size_type n, audio_format format = {}, const allocator_type& alloc = allocator_type())
+      : _pair(FirstOneSecondArgs{}, alloc, nullptr), _format(format) {
+      append(src, n);
+    }
+
+    /// Copies the frames of a view, with its format and start time.
+    explicit audio_buffer(const audio_view& view, const allocator_type& alloc = allocator_type())
+      : _pair(FirstOneSecondArgs{}, alloc, nullptr), _format(view.format()), _timestamp(view.start_time()) {
+      append(view.data(), view.size());
+    }
+
+    audio_buffer(const audio_buffer& other)
+      : _pair(FirstOneSecondArgs{}, allocator_traits::select_on_container_copy_construction(other._pair.first()), nullptr),
+        _format(other._format), _timestamp(other._timestamp) {
+      append(other.data(), other._size);
+    }
+
+    audio_buffer(audio_buffer&& other) noexcept
+      : _pair(FirstOneSecondArgs{}, std::move(other._pair.first()), std::exchange(other._pair._second, nullptr)),
+        _size(std::exchange(other._size, 0)), _capacity(std::exchange(other._capacity, 0)),
+        _format(other._format), _timestamp(other._timestamp) {
+    }
+
+    audio_buffer& operator=(const audio_buffer& other) {
+      if (this == &other) return *this;
+      if constexpr (allocator_traits::propagate_on_container_copy_assignment::value) {
+        if (_pair.first() != other._pair.first()) _tidy();
+        _pair.first() = other._pair.first();
+      }
+      _size = 0;
+      append(other.data(), other._size);
+      _format = other._format;
+      _timestamp = other._timestamp;
+      return *this;
+    }
+
+    audio_buffer& operator=(audio_buffer&& other) noexcept(allocator_traits::propagate_on_container_move_assignment::value ||
+                                                           allocator_traits::is_always_equal::value) {
+      if (this == &other) return *this;
+      if constexpr (allocator_traits::propagate_on_container_move_assignment::value || allocator_traits::is_always_equal::value) {
+        _tidy();
+        if constexpr (allocator_traits::propagate_on_container_move_assignment::value) _pair.first() = std::move(other._pair.first());
+        _take(other);
+      }
+      else {
+        if (_pair.first() == other._pair.first()) {
+          _tidy();
+          _take(other);
+        }
+        else {
+          _size = 0;
+          append(other.data(), other._size);
+          _format = other._format;
+          _timestamp = other._timestamp;
+        }
+      }
+      return *this;
+    }
+
+    ~audio_buffer() { _tidy(); }
+
+    /// Appends one sample.
+    audio_buffer& operator<<(value_type v) {
+      push_back(v);
+      return *this;
+    }
+    /// Appends the samples of a view of the same format.
+    audio_buffer& operator<<(const audio_view& view) {
+      append(view);
+      return *this;
+    }
+
+    CONSTEXPR void reserve(size_type n) {
+      if (n > _capacity) _reallocate(n);
+    }
+    CONSTEXPR void reserve_frames(size_type frames) { reserve(frames * _format.channels); }
+
+    /// Grows with silence or truncates to n samples.
+    CONSTEXPR void resize(size_type n) {
+      reserve(n);
+      if (n > _size) voxory::containers::internal::bulk_zero(data() + _size, (n - _size) * sizeof(value_type));
+      _size = n;
+    }
+    CONSTEXPR void resize_frames(size_type frames) { resize(frames * _format.channels); }
+
+    /// Grows to n samples without touching the new ones; the caller overwrites them.
+    CONSTEXPR void resize_for_overwrite(size_type n) {
+      reserve(n);
+      _size = n;
+    }
+
+    CONSTEXPR void shrink_to_fit() {
+      if (_capacity == _size) return;
+      if (_size == 0) _tidy();
+      else _reallocate(_size);
+    }
+
+    /// Drops the samples and keeps capacity, format and timestamp.
+    CONSTEXPR void clear() noexcept { _size = 0; }
+
+    NODISCARD CONSTEXPR size_type size() const noexcept { return _size; }
+    NODISCARD CONSTEXPR size_type capacity() const noexcept { return _capacity; }
+    NODISCARD CONSTEXPR bool empty() const noexcept { return _size == 0; }
+
+    NODISCARD CONSTEXPR value_type* data() noexcept { return std::to_address(_pair._second); }
+    NODISCARD CONSTEXPR const value_type* data() const noexcept { return std::to_address(_pair._second); }
+
+    NODISCARD CONSTEXPR allocator_type get_allocator() const noexcept { return _pair.first(); }
+
+    NODISCARD CONSTEXPR reference operator[](size_type i) noexcept {
+      ASSERT_ABORT(i < _size, "audio_buffer: index out of range");
+      return data()[i];
+    }
+    NODISCARD CONSTEXPR const_reference operator[](size_type i) const noexcept {
+      ASSERT_ABORT(i < _size, "audio_buffer: index out of range");
+      return data()[i];
+    }
+    NODISCARD CONSTEXPR reference at(size_type i) {
+      if (i >= _size) throw std::out_of_range("index out of range");
+      return data()[i];
+    }
+    NODISCARD CONSTEXPR const_reference at(size_type i) const {
+      if (i >= _size) throw std::out_of_range("index out of range");
+      return data()[i];
+    }
+
+    NODISCARD CONSTEXPR iterator begin() noexcept { return data(); }
+    NODISCARD CONSTEXPR const_iterator begin() const noexcept { return data(); }
+    NODISCARD CONSTEXPR iterator end() noexcept { return data() + _size; }
+    NODISCARD CONSTEXPR const_iterator end() const noexcept { return data() + _size; }
+    NODISCARD CONSTEXPR const_iterator cbegin() const noexcept { return begin(); }
+    NODISCARD CONSTEXPR const_iterator cend() const noexcept { return end(); }
+
+    CONSTEXPR void push_back(value_type v) {
+      if (_size == _capacity) _reallocate(_grown(_size + 1));
+      data()[_size++] = v;
+    }
+
     template<typename InputIt>
-    _CONSTEXPR20 void append(InputIt first, InputIt last);
-    _CONSTEXPR20 void append(const_pointer src, size_type n);
-    _CONSTEXPR20 void assign(size_type n, const value_type& v);
+    CONSTEXPR void append(InputIt first, InputIt last) {
+      if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>) {
+        const size_type n = static_cast<size_type>(std::distance(first, last));
+        if (_size + n > _capacity) _reallocate(_grown(_size + n));
+        std::copy(first, last, data() + _size);
+        _size += n;
+      }
+      else {
+        for (; first != last; ++first) push_back(static_cast<value_type>(*first));
+      }
+    }
+
+    CONSTEXPR void append(const float* src, size_type n) {
+      if (n == 0) return;
+      if (_size + n > _capacity) _reallocate(_grown(_size + n));
+      voxory::containers::internal::bulk_copy(data() + _size, src, n * sizeof(value_type));
+      _size += n;
+    }
+
+    /// Appends the frames of a view; its format must match format().
+    CONSTEXPR void append(const audio_view& view) {
+      ASSERT_ABORT(view.empty() || view.channels() == _format.channels, "audio_buffer: channel count mismatch");
+      append(view.data(), view.size());
+    }
+
+    /// Replaces the contents with n copies of v.
+    CONSTEXPR void assign(size_type n, value_type v) {
+      _size = 0;
+      reserve(n);
+      voxory::containers::internal::bulk_fill(data(), n, v);
+      _size = n;
+    }
+
+    CONSTEXPR void swap(audio_buffer& other) noexcept {
+      if constexpr (allocator_traits::propagate_on_container_swap::value) {
+        using std::swap;
+        swap(_pair.first(), other._pair.first());
+      }
+      std::swap(_pair._second, other._pair._second);
+      std::swap(_size, other._size);
+      std::swap(_capacity, other._capacity);
+      std::swap(_format, other._format);
+      std::swap(_timestamp, other._timestamp);
+    }
+
+    NODISCARD CONSTEXPR const audio_format& format() const noexcept { return _format; }
+    /// Changes how the samples are interpreted; they are not converted.
+    CONSTEXPR void set_format(audio_format format) noexcept { _format = format; }
+
+    NODISCARD CONSTEXPR std::uint32_t sample_rate() const noexcept { return _format.sample_rate; }
+    CONSTEXPR void set_sample_rate(std::uint32_t sr) noexcept { _format.sample_rate = sr; }
 
-    _CONSTEXPR20 void swap(audio_buffer& other) noexcept(
-      std::is_nothrow_swappable_v<utility::compressed_pair<allocator_type, pointer>>&&
-      std::is_nothrow_swappable_v<size_type>);
+    NODISCARD CONSTEXPR std::uint16_t channels() const noexcept { return _format.channels; }
+    CONSTEXPR void set_channels(std::uint16_t ch) noexcept { _format.channels = ch; }
 
-    _NODISCARD _CONSTEXPR20 std::uint32_t sample_rate() const noexcept { return sample_rate_; }
-    _CONSTEXPR20 void set_sample_rate(std::uint32_t sr) noexcept { sample_rate_ = sr; }
+    NODISCARD CONSTEXPR size_type frames() const noexcept {
+      return _format.channels == 0 ? 0 : (_size / static_cast<size_type>(_format.channels));
+    }
 
-    _NODISCARD _CONSTEXPR20 std::uint16_t channels() const noexcept { return channels_; }
-    _CONSTEXPR20 void set_channels(std::uint16_t ch) noexcept { channels_ = ch; }
+    /// Capture time of the first frame, on whatever clock the producer uses.
+    NODISCARD CONSTEXPR std::chrono::nanoseconds timestamp() const noexcept { return _timestamp; }
+    CONSTEXPR void set_timestamp(std::chrono::nanoseconds t) noexcept { _timestamp = t; }
+    NODISCARD CONSTEXPR std::chrono::nanoseconds duration() const noexcept { return _format.duration(frames()); }
 
-    _NODISCARD _CONSTEXPR20 size_type frames() const noexcept {
-      return channels_ == 0 ? 0 : (size_ / static_cast<size_type>(channels_));
+    /// All frames.
+    NODISCARD CONSTEXPR audio_view view() const noexcept {
+      return audio_view(data(), 0, frames(), _format, _timestamp);
+    }
+    /// Frames [offset, offset + count), count clamped to the end.
+    NODISCARD CONSTEXPR audio_view view(size_type offset, size_type count = static_cast<size_type>(-1)) const noexcept {
+      return view().subview(offset, count);
     }
+    CONSTEXPR operator audio_view() const noexcept { return view(); }
 
   private:
-    utility::compressed_pair<allocator_type, pointer> pair_;
-    size_type size_ = 0;
-    size_type capacity_ = 0;
-    std::uint32_t sample_rate_ = 0;
-    std::uint16_t channels_ = 0;
-
-    //   
-    pointer allocate_block(size_type n);
-    void deallocate_block(pointer p, size_type n) noexcept;
-    void destroy_and_deallocate() noexcept;
+    NODISCARD CONSTEXPR size_type _grown(size_type min_size) const noexcept {
+      return std::max(min_size, _capacity + _capacity / 2);
+    }
+
+    CONSTEXPR void _reallocate(size_type n) {
+      pointer fresh = allocator_traits::allocate(_pair.first(), n);
+      if (_size != 0) voxory::containers::internal::bulk_copy(std::to_address(fresh), data(), _size * sizeof(value_type));
+      if (_pair._second) allocator_traits::deallocate(_pair.first(), _pair._second, _capacity);
+      _pair._second = fresh;
+      _capacity = n;
+    }
+
+    CONSTEXPR void _tidy() noexcept {
+      if (_pair._second) allocator_traits::deallocate(_pair.first(), _pair._second, _capacity);
+      _pair._second = nullptr;
+      _size = 0;
+      _capacity = 0;
+    }
+
+    CONSTEXPR void _take(audio_buffer& other) noexcept {
+      _pair._second = std::exchange(other._pair._second, nullptr);
+      _size = std::exchange(other._size, 0);
+      _capacity = std::exchange(other._capacity, 0);
+      _format = other._format;
+      _timestamp = other._timestamp;
+    }
+
+    utility::compressed_pair<allocator_type, pointer> _pair;
+    size_type _size = 0;
+    size_type _capacity = 0;
+    audio_format _format{};
+    std::chrono::nanoseconds _timestamp{ 0 };
   };
 
-  int foo() {
-    audio_buffer<std::allocator<float>> a();
-  }
-} // namespace audio
\ No newline at end of file
+  template<typename Alloc>
+  CONSTEXPR void swap(audio_buffer<Alloc>& a, audio_buffer<Alloc>& b) noexcept { a.swap(b); }
+} // namespace audio
+
+namespace type_traits {
+  template<typename Alloc>
+  struct is_trivially_relocatable<audio::audio_buffer<Alloc>> : is_trivially_relocatable<Alloc> {};
+}
@@ -0,0 +1,386 @@
+#pragma once
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <platform/platform.h>
+#include <audio/sample_format.h>
+#include <audio/realtime/capture_ring.h>
+#include <containers/impl/ring_buffer.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+namespace audio {
+  /// Interleaved PCM layouts a capture device hands out.
+  enum class source_format : uint8_t {
+    unsupported,
+    f32, // IEEE float
+    s16,
+    s24, // packed, 3 bytes per sample
+    s32
+  };
+
+  namespace detail {
+    template<source_format F>
+    inline constexpr std::size_t source_sample_bytes = F == source_format::s16 ? 2 : F == source_format::s24 ? 3 : 4;
+
+    template<source_format F>
+    FORCE_INLINE float load_source_sample(const unsigned char* p) noexcept {
+      if constexpr (F == source_format::f32) {
+        float v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+      }
+      else if constexpr (F == source_format::s16) {
+        int16_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return static_cast<float>(v) * (1.0f / 32768.0f);
+      }
+      else if constexpr (F == source_format::s24) {
+        const int32_t v = static_cast<int32_t>(uint32_t(p[0]) << 8 | uint32_t(p[1]) << 16 | uint32_t(p[2]) << 24) >> 8;
+        return static_cast<float>(v) * (1.0f / 8388608.0f);
+      }
+      else {
+        int32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return static_cast<float>(v) * (1.0f / 2147483648.0f);
+      }
+    }
+
+    inline constexpr std::size_t converter_tile_frames = 256;
+    inline constexpr std::size_t converter_tile_samples = 1024; // interleaved; caps the channel count
+
+    // resampler state carried from one packet to the next
+    struct converter_state {
+      uint32_t src_rate = 0;
+      uint32_t dst_rate = 0;
+      uint16_t channels = 0;
+      uint32_t phase = 0;  // in 1/dst_rate source samples: exact, so the output rate never drifts
+      float acc = 0.0f;    // decimation: sum of the frames of the pending output sample (of their
+                           // samples, unscaled, for an integer ratio)
+      uint32_t count = 0;  //             and their number
+      float prev = 0.0f;   // interpolation: last frame of the previous packet
+    };
+
+    // writes into a ring's (up to) two free spans in order. Single samples are gathered on the
+    // stack and stored a block at a time, so int16 output goes through f32_to_s16() (SIMD).
+    template<typename Sample>
+    class span_writer {
+    public:
+      static constexpr std::size_t stage_size = 256;
+
+      explicit span_writer(const voxory::containers::ring_segments<Sample>& out) noexcept : _out(out) {}
+
+      FORCE_INLINE void put(float v) noexcept {
+        _stage[_staged++] = v;
+        if (_staged == stage_size) [[unlikely]] _flush();
+      }
+
+      /// Stores n samples after the staged ones, without staging them.
+      void write(const float* v, std::size_t n) noexcept {
+        _flush();
+        _store(v, n);
+      }
+
+      /// Flushes the stage; returns the samples written in total.
+      std::size_t finish() noexcept {
+        _flush();
+        return _done;
+      }
+
+    private:
+      void _flush() noexcept {
+        _store(_stage, _staged);
+        _staged = 0;
+      }
+
+      void _store(const float* v, std::size_t n) noexcept {
+        const std::size_t first = _out.first.size();
+        const std::size_t head = _done < first ? std::min(n, first - _done) : 0;
+        if (head != 0) convert_samples(v, _out.first.data() + _done, head);
+        if (n != head) convert_samples(v + head, _out.second.data() + (_done + head - first), n - head);
+        _done += n;
+      }
+
+      const voxory::containers::ring_segments<Sample>& _out;
+      std::size_t _done = 0;
+      std::size_t _staged = 0;
+      float _stage[stage_size];
+    };
+
+    // Integer-ratio decimation straight from interleaved samples: every output is the mean of
+    // the ratio * channels samples of its period, so downmix and box filter are one sum.
+    // P == 0 takes the period at runtime. Returns the outputs written to out (n / period).
+    template<uint32_t P>
+    FORCE_INLINE std::size_t decimate_periods(const float* x, std::size_t n, uint32_t period, float inv_period, float* out) noexcept {
+      const uint32_t r = P != 0 ? P : period;
+      const std::size_t m = n / r;
+      for (std::size_t k = 0; k < m; ++k) {
+        float sum = 0.0f;
+        for (uint32_t j = 0; j < r; ++j) sum += x[k * r + j];
+        out[k] = sum * inv_period;
+      }
+      return m;
+    }
+
+    // sum of the channels of one interleaved float frame
+    template<uint16_t Channels>
+    FORCE_INLINE float downmix_frame(const float* frame, std::size_t ch) noexcept {
+      if constexpr (Channels == 1) {
+        return frame[0];
+      }
+      else if constexpr (Channels == 2) {
+        return frame[0] + frame[1];
+      }
+      else {
+        float m = 0.0f;
+        for (std::size_t c = 0; c < ch; ++c) m += frame[c];
+        return m;
+      }
+    }
+
+    /**
+     * @brief Convert, downmix and resample one packet in a single pass over it.
+     * @details The packet is walked in tiles of up to 256 frames. A tile is converted to float
+     *          (s16_to_f32() for int16 sources; float packets are used in place) and averaged to
+     *          mono on the stack, where it never leaves L1, then resampled from there into the
+     *          output spans. The device buffer is read once; nothing but the ring is written.
+     *
+     *          Downsampling averages the frames of each output period (a box filter); with an
+     *          integer ratio (48 -> 16 kHz) that average is taken over the interleaved samples
+     *          directly, which folds the downmix into it and needs no division.
+     *          Upsampling interpolates linearly. Channels == 0 reads the count from the state.
+     */
+    template<source_format F, uint16_t Channels, typename Sample>
+    std::size_t fused_capture_kernel(converter_state& s, const void* packet, std::size_t frames,
+                                     const voxory::containers::ring_segments<Sample>& out) noexcept {
+      constexpr std::size_t bytes = source_sample_bytes<F>;
+      const std::size_t ch = Channels != 0 ? Channels : s.channels;
+      const std::size_t tile = std::min<std::size_t>(converter_tile_frames, converter_tile_samples / ch);
+      const std::size_t stride = ch * bytes;
+      const float inv_ch = 1.0f / static_cast<float>(ch);
+      const unsigned char* src = static_cast<const unsigned char*>(packet);
+      const uint32_t src_rate = s.src_rate;
+      const uint32_t dst_rate = s.dst_rate;
+      const uint32_t ratio = src_rate > dst_rate && src_rate % dst_rate == 0 ? src_rate / dst_rate : 0;
+      const uint32_t period = ratio * static_cast<uint32_t>(ch);
+      const float inv_period = ratio != 0 ? 1.0f / static_cast<float>(period) : 0.0f;
+      const float inv_dst = 1.0f / static_cast<float>(dst_rate);
+      span_writer<Sample> w(out);
+
+      uint32_t phase = s.phase;
+      float acc = s.acc;
+      uint32_t count = s.count;
+      float prev = s.prev;
+      float interleaved[converter_tile_samples];
+      float downmixed[converter_tile_frames];
+
+      for (std::size_t base = 0; base < frames; base += tile) {
+        const std::size_t n = std::min(tile, frames - base);
+        const float* x = interleaved;
+        if constexpr (F == source_format::f32) x = reinterpret_cast<const float*>(src);
+        else if constexpr (F == source_format::s16) s16_to_f32(reinterpret_cast<const int16_t*>(src), interleaved, n * ch);
+        else for (std::size_t k = 0; k < n * ch; ++k) interleaved[k] = load_source_sample<F>(src + k * bytes);
+        src += n * stride;
+
+        if (ratio != 0) {
+          // acc holds the raw sum of the count frames of the pending output (phase == count *
+          // dst_rate), added sample by sample in the order decimate_periods() would use
+          std::size_t i = 0;
+          for (; count != 0 && i < n; ++i) {
+            for (std::size_t c = 0; c < ch; ++c) acc += x[i * ch + c];
+            if (++count == ratio) {
+              w.put(acc * inv_period);
+              acc = 0.0f;
+              count = 0;
+            }
+          }
+          const float* rest = x + i * ch;
+          const std::size_t samples = (n - i) * ch;
+          std::size_t m;
+          switch (period) { // the common ones unrolled: 2 or 3 to 1, mono or stereo
+          case 2: m = decimate_periods<2>(rest, samples, period, inv_period, downmixed); break;
+          case 3: m = decimate_periods<3>(rest, samples, period, inv_period, downmixed); break;
+          case 4: m = decimate_periods<4>(rest, samples, period, inv_period, downmixed); break;
+          case 6: m = decimate_periods<6>(rest, samples, period, inv_period, downmixed); break;
+          default: m = decimate_periods<0>(rest, samples, period, inv_period, downmixed); break;
+          }
+          w.write(downmixed, m);
+          for (i += m * ratio; i < n; ++i) {
+            for (std::size_t c = 0; c < ch; ++c) acc += x[i * ch + c];
+            ++count;
+          }
+          phase = count * dst_rate;
+          continue;
+        }
+
+        const float* mono = downmixed;
+        if constexpr (Channels == 1) {
+          mono = x;
+        }
+        else {
+          for (std::size_t i = 0; i < n; ++i) downmixed[i] = downmix_frame<Channels>(x + i * ch, ch) * inv_ch;
+        }
+
+        if (src_rate == dst_rate) {
+          w.write(mono, n);
+        }
+        else if (src_rate > dst_rate) {
+          for (std::size_t i = 0; i < n; ++i) {
+            acc += mono[i];
+            ++count;
+            phase += dst_rate;
+            if (phase >= src_rate) {
+              phase -= src_rate;
+              w.put(acc / static_cast<float>(count));
+              acc = 0.0f;
+              count = 0;
+            }
+          }
+        }
+        else {
+          // phase: position of the next output past prev, in 1/dst_rate of a source sample
+          for (std::size_t i = 0; i < n; ++i) {
+            const float x = mono[i];
+            for (; phase < dst_rate; phase += src_rate) w.put(prev + (x - prev) * (static_cast<float>(phase) * inv_dst));
+            phase -= dst_rate;
+            prev = x;
+          }
+        }
+      }
+
+      s.phase = phase;
+      s.acc = acc;
+      s.count = count;
+      s.prev = prev;
+      return w.finish();
+    }
+  } // namespace detail
+
+  /**
+   * @brief Turns raw device packets into mono samples at a fixed rate (16 kHz for Whisper),
+   *        written straight into a capture ring.
+   *
+   * @details The kernel is picked once, at construction, from the source format and channel
+   *          count (mono and stereo get their own loops, other counts a generic one). process()
+   *          then reads each packet exactly once: tile by tile, frames are converted, downmixed
+   *          and resampled on the stack and the result is stored into the ring's free space. No
+   *          per-stage buffer is written, so the capture callback does one cache pass per packet.
+   *
+   *          Resampling keeps its phase (and a partial output sample or the last input frame)
+   *          across packets, so splitting a stream into packets differently gives the same
+   *          output. Ratios are exact integers; the output rate does not drift.
+   *
+   * @tparam Sample Storage type of the target ring: float or int16_t.
+   */
+  template<typename Sample>
+  class capture_converter {
+    static_assert(is_sample_type_v<Sample>, "capture_converter writes float or int16_t samples");
+    using _kernel_fn = std::size_t (*)(detail::converter_state&, const void*, std::size_t,
+                                       const voxory::containers::ring_segments<Sample>&) noexcept;
+  public:
+    using ring_type = basic_capture_ring<Sample>;
+
+    /// Converts nothing; supported() is false.
+    capture_converter() noexcept = default;
+
+    /**
+     * @param format   Sample layout of the device packets.
+     * @param channels Interleaved channels per frame.
+     * @param src_rate Device sample rate in Hz.
+     * @param dst_rate Output rate in Hz.
+     */
+    capture_converter(source_format format, uint16_t channels, uint32_t src_rate, uint32_t dst_rate = 16000) noexcept {
+      if (channels == 0 || channels > detail::converter_tile_samples || src_rate == 0 || dst_rate == 0) return;
+      _state.src_rate = src_rate;
+      _state.dst_rate = dst_rate;
+      _state.channels = channels;
+      switch (format) {
+      case source_format::f32: _kernel = _select<source_format::f32>(channels); break;
+      case source_format::s16: _kernel = _select<source_format::s16>(channels); break;
+      case source_format::s24: _kernel = _select<source_format::s24>(channels); break;
+      case source_format::s32: _kernel = _select<source_format::s32>(channels); break;
+      default: break;
+      }
+    }
+
+    /// False for unknown formats; such packets can only be recorded as silence (skip()).
+    NODISCARD FORCE_INLINE bool supported() const noexcept { return _kernel != nullptr; }
+
+    /// Upper bound of the samples one packet of the given size produces.
+    NODISCARD FORCE_INLINE std::size_t max_output(std::size_t frames) const noexcept {
+      if (_state.src_rate == 0) return 0;
+      return static_cast<std::size_t>(uint64_t(frames) * _state.dst_rate / _state.src_rate) + 2;
+    }
+
+    /**
+     * @brief Converts one device packet and appends the result to ring.
+     * @param packet Interleaved frames in the format given at construction.
+     * @return Samples appended.
+     */
+    std::size_t process(const void* packet, std::size_t frames, ring_type& ring) {
+      if (!supported() || frames == 0) return 0;
+      const std::size_t n = _kernel(_state, packet, frames, ring.write_spans(max_output(frames)));
+      ring.commit_write(n);
+      return n;
+    }
+
+    /**
+     * @brief Advances the resampler over a packet of silence without reading it.
+     * @details A pending partially averaged sample is dropped, as is the interpolation history.
+     * @return Samples of silence the packet amounts to; record them with ring.append_silence().
+     */
+    std::size_t skip(std::size_t frames) noexcept {
+      if (_state.src_rate == 0) return 0;
+      if (_state.src_rate == _state.dst_rate) return frames;
+      const uint64_t src_rate = _state.src_rate;
+      const uint64_t dst_rate = _state.dst_rate;
+      uint64_t n = 0;
+      if (src_rate > dst_rate) {
+        const uint64_t total = _state.phase + uint64_t(frames) * dst_rate;
+        n = total / src_rate;
+        _state.phase = static_cast<uint32_t>(total % src_rate);
+        // the silent frames past the last output boundary join the next average as zeros
+        _state.acc = n != 0 ? 0.0f : _state.acc;
+        _state.count = static_cast<uint32_t>(_state.phase / dst_rate);
+      }
+      else {
+        // outputs at phase, phase + src, ... below frames * dst
+        const uint64_t span = uint64_t(frames) * dst_rate;
+        if (_state.phase < span) {
+          n = (span - _state.phase + src_rate - 1) / src_rate;
+          _state.phase = static_cast<uint32_t>(_state.phase + n * src_rate - span);
+        }
+        else {
+          _state.phase = static_cast<uint32_t>(_state.phase - span);
+        }
+        _state.prev = 0.0f;
+      }
+      return static_cast<std::size_t>(n);
+    }
+
+    /// Forgets the carried resampler state (after a device restart or a gap).
+    void reset() noexcept {
+      _state.phase = 0;
+      _state.acc = 0.0f;
+      _state.count = 0;
+      _state.prev = 0.0f;
+    }
+
+  private:
+    template<source_format F>
+    static _kernel_fn _select(uint16_t channels) noexcept {
+      switch (channels) {
+      case 1: return &detail::fused_capture_kernel<F, 1, Sample>;
+      case 2: return &detail::fused_capture_kernel<F, 2, Sample>;
+      default: return &detail::fused_capture_kernel<F, 0, Sample>;
+      }
+    }
+
+    detail::converter_state _state;
+    _kernel_fn _kernel = nullptr;
+  };
+} // namespace audio
@@ -0,0 +1,366 @@
+#pragma once
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <platform/platform.h>
+#include <containers/impl/ring_buffer.h>
+#include <containers/detail/bulk_memory.h>
+#include <audio/sample_format.h>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <type_traits>
+
+namespace audio {
+  /**
+   * @brief Mono capture FIFO that records silence as run lengths instead of samples.
+   *
+   * @details Audible samples live in a sample ring; the timeline is a second ring of runs, each
+   *          either "n audible samples" (the next n in the sample ring) or "n silent samples"
+   *          (nothing stored). A packet flagged silent by the device costs one run, or nothing
+   *          if it extends the previous silent run, so an idle overnight loopback capture holds
+   *          a handful of runs instead of megabytes of zeros.
+   *
+   *          Readers that need PCM (copy_front(), read()) get the zeros written out on the fly.
+   *          Analysis that only cares whether there is signal (for_each_segment(), energy(),
+   *          is_silent(), leading_silence()) steps over a silent run in O(1), so gating a window
+   *          that is mostly silence costs O(runs), not O(samples).
+   *
+   *          Samples are stored as Sample: float, or int16_t for half the memory and bandwidth
+   *          per second held. Both append() and copy_front() / read() accept either format and
+   *          convert at the boundary (SIMD), so an int16 ring is filled from float device
+   *          packets and drained straight into the float window handed to inference.
+   *
+   * @note Single-threaded like ring_buffer; both rings grow as needed, so drain it regularly.
+   * @tparam Sample float or int16_t (full scale is 1.0f / 32768).
+   */
+  template<typename Sample>
+  class basic_capture_ring {
+    static_assert(is_sample_type_v<Sample>, "basic_capture_ring stores float or int16_t samples");
+  public:
+    using value_type = Sample;
+    using size_type = std::size_t;
+
+    basic_capture_ring() = default;
+
+    /**
+     * @param sample_capacity Audible samples to reserve up front.
+     * @param run_capacity Runs to reserve up front; each switch between silence and signal adds one.
+     */
+    explicit basic_capture_ring(size_type sample_capacity, size_type run_capacity = 64)
+      : _samples(sample_capacity), _runs(run_capacity) {}
+
+    // --- producer ---
+
+    /// Appends audible samples; extends the last run if it is audible too.
+    void append(std::span<const float> samples) { _append(samples); }
+    /// @copydoc append
+    void append(std::span<const int16_t> samples) { _append(samples); }
+
+    /**
+     * @brief Free storage for at least n more audible samples, as up to two spans (wrap point).
+     * @details For producers that compute samples in place; commit_write() then appends the
+     *          first n written (first span, then second). Grows the sample ring if needed.
+     */
+    NODISCARD voxory::containers::ring_segments<Sample> write_spans(size_type n) {
+      if (_samples.capacity() - _samples.size() < n) {
+        _samples.reserve(std::max(_samples.size() + n, _samples.capacity() * 2));
+      }
+      const auto [head, tail] = _samples.write_spans_for_push_back();
+      return { head, tail };
+    }
+
+    /// Appends n samples written through write_spans() as audible.
+    void commit_write(size_type n) {
+      if (n == 0) return;
+      _samples.commit_write(n);
+      _extend(n, false);
+    }
+
+    /// Appends n zero samples as (part of) one silent run; O(1), nothing is stored per sample.
+    void append_silence(size_type n) {
+      if (n == 0) return;
+      _extend(n, true);
+      _silent += n;
+    }
+
+    // --- state ---
+
+    /// Samples in the FIFO, silent ones included.
+    NODISCARD FORCE_INLINE size_type size() const noexcept { return _size; }
+    NODISCARD FORCE_INLINE bool empty() const noexcept { return _size == 0; }
+    /// Samples actually held in memory (the audible ones).
+    NODISCARD FORCE_INLINE size_type stored() const noexcept { return _samples.size(); }
+    /// Samples recorded as silence.
+    NODISCARD FORCE_INLINE size_type silent() const noexcept { return _silent; }
+    /// Number of runs; the cost of a scan that skips silence.
+    NODISCARD FORCE_INLINE size_type runs() const noexcept { return _runs.size(); }
+
+    /// Length of the silent run at the front (0 if the front is audible); O(1).
+    NODISCARD size_type leading_silence() const noexcept {
+      const _run* front = _runs.peek_front();
+      return front != nullptr && front->silent ? front->length : 0;
+    }
+
+    /// True if the first n samples (clamped to size()) were all recorded as silence.
+    NODISCARD bool is_silent(size_type n) const noexcept {
+      n = std::min(n, _size);
+      for (size_type i = 0; i < _runs.size() && n != 0; ++i) {
+        const _run& r = _runs[i];
+        if (!r.silent) return false;
+        n -= std::min(n, r.length);
+      }
+      return true;
+    }
+
+    /**
+     * @brief Sum of squares of the first n samples (clamped to size()) at float scale.
+     * @details Silent runs add nothing and cost O(1).
+     */
+    NODISCARD double energy(size_type n) const noexcept {
+      double sum = 0.0;
+      for_each_segment(n, [&](const Sample* samples, size_type count) {
+        if (samples == nullptr) return;
+        for (size_type i = 0; i < count; ++i) sum += static_cast<double>(samples[i]) * samples[i];
+      });
+      if constexpr (std::is_same_v<Sample, int16_t>) sum *= double(detail::s16_inv_scale) * detail::s16_inv_scale;
+      return sum;
+    }
+
+    /**
+     * @brief Visits the first n samples (clamped to size()) oldest first, as contiguous pieces.
+     * @param fn Called as fn(const Sample* samples, size_type count); samples is nullptr for a
+     *           silent piece. An audible run split by the ring's wrap point arrives as two calls.
+     */
+    template<typename Fn>
+    void for_each_segment(size_type n, Fn&& fn) const {
+      n = std::min(n, _size);
+      size_type offset = 0; // into _samples
+      for (size_type i = 0; i < _runs.size() && n != 0; ++i) {
+        const _run& r = _runs[i];
+        const size_type take = std::min(n, r.length);
+        if (r.silent) {
+          fn(static_cast<const Sample*>(nullptr), take);
+        }
+        else {
+          _visit_samples(offset, take, fn);
+          offset += r.length;
+        }
+        n -= take;
+      }
+    }
+
+    // --- consumer ---
+
+    /**
+     * @brief Copies the first out.size() samples (clamped to size()) into out without removing them.
+     * @return Number of samples written; silent runs are written as zeros.
+     */
+    size_type copy_front(std::span<float> out) const noexcept { return _copy_front(out); }
+    /// @copydoc copy_front
+    size_type copy_front(std::span<int16_t> out) const noexcept { return _copy_front(out); }
+
+    /// copy_front() followed by discard() of the same amount.
+    size_type read(std::span<float> out) noexcept { return discard(_copy_front(out)); }
+    /// @copydoc read
+    size_type read(std::span<int16_t> out) noexcept { return discard(_copy_front(out)); }
+
+    /**
+     * @brief Removes the first n samples (clamped to size()).
+     * @return Number of samples removed.
+     */
+    size_type discard(size_type n) noexcept {
+      n = std::min(n, _size);
+      size_type left = n;
+      while (left != 0) {
+        _run& front = *_runs.peek_front();
+        const size_type take = std::min(left, front.length);
+        if (front.silent) _silent -= take;
+        else _samples.discard_front(take);
+        if (take == front.length) _runs.discard_front(1);
+        else front.length -= take;
+        left -= take;
+      }
+      _size -= n;
+      return n;
+    }
+
+    /// Removes everything; keeps the capacity of both rings.
+    void clear() noexcept {
+      _samples.clear();
+      _runs.clear();
+      _size = 0;
+      _silent = 0;
+    }
+
+  private:
+    struct _run {
+      size_type length;
+      bool silent;
+    };
+
+    template<typename T>
+    using _ring = voxory::containers::ring_buffer<T, std::allocator<T>, voxory::containers::ring_policy::dynamic_capacity,
+                                                  voxory::containers::ring_policy::overflow_grow>;
+
+    template<typename In>
+    void _append(std::span<const In> samples) {
+      if (samples.empty()) return;
+      if constexpr (std::is_same_v<In, Sample>) {
+        _samples.append(samples);
+        _extend(samples.size(), false);
+      }
+      else {
+        // convert straight into the free space: no temporary
+        const size_type n = samples.size();
+        const auto spans = write_spans(n);
+        const size_type first = std::min(n, spans.first.size());
+        convert_samples(samples.data(), spans.first.data(), first);
+        convert_samples(samples.data() + first, spans.second.data(), n - first);
+        commit_write(n);
+      }
+    }
+
+    template<typename Out>
+    size_type _copy_front(std::span<Out> out) const noexcept {
+      Out* dst = out.data();
+      for_each_segment(out.size(), [&](const Sample* samples, size_type count) {
+        if (samples == nullptr) voxory::containers::internal::bulk_zero(dst, count * sizeof(Out));
+        else convert_samples(samples, dst, count);
+        dst += count;
+      });
+      return static_cast<size_type>(dst - out.data());
+    }
+
+    void _extend(size_type n, bool silent) {
+      _run* back = _runs.empty() ? nullptr : &_runs[_runs.size() - 1];
+      if (back != nullptr && back->silent == silent) back->length += n;
+      else _runs.push_back(_run{ n, silent });
+      _size += n;
+    }
+
+    // samples [offset, offset + count) of the sample ring, split at its wrap point
+    template<typename Fn>
+    void _visit_samples(size_type offset, size_type count, Fn& fn) const {
+      const auto seg = _samples.segments();
+      if (offset < seg.first.size()) {
+        const size_type head = std::min(count, seg.first.size() - offset);
+        fn(seg.first.data() + offset, head);
+        count -= head;
+        offset = 0;
+      }
+      else {
+        offset -= seg.first.size();
+      }
+      if (count != 0) fn(seg.second.data() + offset, count);
+    }
+
+    _ring<Sample> _samples;
+    _ring<_run> _runs;
+    size_type _size = 0;   // audible + silent
+    size_type _silent = 0;
+  };
+
+  /**
+   * @brief Fixed-size, lock-free hand-off of captured audio from one producer to one consumer.
+   *
+   * @details Carries the contents of a basic_capture_ring across threads with silence still as
+   *          run lengths: audible samples go through one preallocated ring, runs through another.
+   *          Both are overflow_block ring_buffers, whose element count is the only shared state
+   *          (atomic); the producer checks for room first, so it never waits and never allocates.
+   *          A batch that does not fit is dropped whole and added to dropped().
+   *
+   *          Samples of a run are committed before the run itself, so a consumer that sees a run
+   *          also sees its samples.
+   *
+   * @note One producer thread and one consumer thread.
+   */
+  template<typename Sample>
+  class basic_capture_handoff {
+    static_assert(is_sample_type_v<Sample>, "basic_capture_handoff carries float or int16_t samples");
+  public:
+    using value_type = Sample;
+    using size_type = std::size_t;
+
+    /**
+     * @param sample_capacity Audible samples in flight before batches are dropped.
+     * @param run_capacity Runs in flight; an audible run split at a wrap point takes two.
+     */
+    basic_capture_handoff(size_type sample_capacity, size_type run_capacity)
+      : _samples(sample_capacity), _runs(run_capacity) {}
+
+    basic_capture_handoff(const basic_capture_handoff&) = delete;
+    basic_capture_handoff& operator=(const basic_capture_handoff&) = delete;
+
+    // --- producer ---
+
+    /**
+     * @brief Publishes all of src, or nothing if it does not fit; src is left untouched.
+     * @return False if the batch was dropped (counted in dropped()).
+     */
+    bool push(const basic_capture_ring<Sample>& src) noexcept {
+      if (src.empty()) return true;
+      // one more run than src holds: its sample ring may split an audible run at the wrap point
+      const bool fits = _runs.capacity() - _runs.size() >= src.runs() + 1 &&
+                        _samples.capacity() - _samples.size() >= src.stored();
+      if (!fits) {
+        _dropped.fetch_add(src.size(), std::memory_order_relaxed);
+        return false;
+      }
+      src.for_each_segment(src.size(), [&](const Sample* samples, size_type count) {
+        if (samples != nullptr) (void)_samples.append(std::span<const Sample>(samples, count));
+        (void)_runs.push_back(_run{ count, samples == nullptr });
+      });
+      return true;
+    }
+
+    // --- consumer ---
+
+    /**
+     * @brief Moves everything published so far to the back of dst.
+     * @return Samples moved, silent ones included.
+     */
+    size_type drain_into(basic_capture_ring<Sample>& dst) {
+      size_type moved = 0;
+      while (std::optional<_run> r = _runs.try_pop_front()) {
+        if (r->silent) {
+          dst.append_silence(r->length);
+        }
+        else {
+          const auto [head, tail] = _samples.read_spans_for_pop_front();
+          const size_type first = std::min(r->length, static_cast<size_type>(head.size()));
+          dst.append(head.first(first));
+          dst.append(tail.first(r->length - first));
+          _samples.commit_read(r->length);
+        }
+        moved += r->length;
+      }
+      return moved;
+    }
+
+    /// Samples (silent ones included) dropped because the consumer fell behind.
+    NODISCARD size_type dropped() const noexcept { return _dropped.load(std::memory_order_relaxed); }
+
+  private:
+    struct _run {
+      size_type length;
+      bool silent;
+    };
+
+    template<typename T>
+    using _spsc = voxory::containers::ring_buffer<T, std::allocator<T>, voxory::containers::ring_policy::dynamic_capacity,
+                                                  voxory::containers::ring_policy::overflow_block>;
+
+    _spsc<Sample> _samples;
+    _spsc<_run> _runs;
+    std::atomic<size_type> _dropped{ 0 };
+  };
+
+  using capture_ring = basic_capture_ring<float>;
+  using capture_ring_s16 = basic_capture_ring<int16_t>;
+  using capture_handoff_s16 = basic_capture_handoff<int16_t>;
+} // namespace audio
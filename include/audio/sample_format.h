@@ -0,0 +1,154 @@
+#pragma once
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <platform/platform.h>
+#include <platform/cpu_features.h>
+#include <containers/detail/bulk_memory.h>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(X64)
+#include <immintrin.h>
+#elif defined(X64_ARM)
+#include <arm_neon.h>
+#endif
+
+namespace audio {
+  // Sample storage formats. Captured audio is kept as int16 where 16 bits is all the source had
+  // (half the bytes of float per second of history) and turned into float only when a window is
+  // handed to inference. The scale is 2^15 both ways, so int16 -> float -> int16 is lossless.
+
+  template<typename Sample>
+  inline constexpr bool is_sample_type_v = std::is_same_v<Sample, float> || std::is_same_v<Sample, int16_t>;
+
+  namespace detail {
+    inline constexpr float s16_scale = 32768.0f;
+    inline constexpr float s16_inv_scale = 1.0f / 32768.0f;
+
+    FORCE_INLINE int16_t f32_to_s16_one(float v) noexcept {
+      v *= s16_scale;
+      if (!(v >= -32768.0f)) v = -32768.0f; // NaN too, like the x64 paths
+      if (v > 32767.0f) v = 32767.0f;
+#if defined(X64)
+      return static_cast<int16_t>(_mm_cvtss_si32(_mm_set_ss(v))); // lrintf is a libm call on MSVC
+#else
+      return static_cast<int16_t>(std::lrintf(v));
+#endif
+    }
+
+#if defined(X64)
+    // 8 samples per step; returns the samples done
+    inline std::size_t s16_to_f32_sse2(const int16_t* src, float* dst, std::size_t n) noexcept {
+      const __m128 scale = _mm_set1_ps(s16_inv_scale);
+      std::size_t i = 0;
+      for (; i + 8 <= n; i += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+      }
+      return i;
+    }
+
+    // 16 samples per step
+    TARGET_AVX2 inline std::size_t s16_to_f32_avx2(const int16_t* src, float* dst, std::size_t n) noexcept {
+      const __m256 scale = _mm256_set1_ps(s16_inv_scale);
+      std::size_t i = 0;
+      for (; i + 16 <= n; i += 16) {
+        const __m256i lo = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+        const __m256i hi = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8)));
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(lo), scale));
+        _mm256_storeu_ps(dst + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(hi), scale));
+      }
+      return i;
+    }
+
+    // clamp before converting: cvtps2dq turns out-of-range values into INT_MIN
+    inline std::size_t f32_to_s16_sse2(const float* src, int16_t* dst, std::size_t n) noexcept {
+      const __m128 scale = _mm_set1_ps(s16_scale);
+      const __m128 lo = _mm_set1_ps(-32768.0f);
+      const __m128 hi = _mm_set1_ps(32767.0f);
+      std::size_t i = 0;
+      for (; i + 8 <= n; i += 8) {
+        const __m128 a = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + i), scale), lo), hi);
+        const __m128 b = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + i + 4), scale), lo), hi);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b)));
+      }
+      return i;
+    }
+
+    TARGET_AVX2 inline std::size_t f32_to_s16_avx2(const float* src, int16_t* dst, std::size_t n) noexcept {
+      const __m256 scale = _mm256_set1_ps(s16_scale);
+      const __m256 lo = _mm256_set1_ps(-32768.0f);
+      const __m256 hi = _mm256_set1_ps(32767.0f);
+      std::size_t i = 0;
+      for (; i + 16 <= n; i += 16) {
+        const __m256 a = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(src + i), scale), lo), hi);
+        const __m256 b = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(src + i + 8), scale), lo), hi);
+        // packs works per 128-bit lane: a0 b0 a1 b1 -> a0 a1 b0 b1
+        const __m256i packed = _mm256_packs_epi32(_mm256_cvtps_epi32(a), _mm256_cvtps_epi32(b));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_permute4x64_epi64(packed, 0xD8));
+      }
+      return i;
+    }
+#elif defined(X64_ARM)
+    inline std::size_t s16_to_f32_neon(const int16_t* src, float* dst, std::size_t n) noexcept {
+      std::size_t i = 0;
+      for (; i + 8 <= n; i += 8) {
+        const int16x8_t v = vld1q_s16(src + i);
+        vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), s16_inv_scale));
+        vst1q_f32(dst + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), s16_inv_scale));
+      }
+      return i;
+    }
+
+    // vcvtnq rounds to nearest even and saturates; vqmovn saturates to int16
+    inline std::size_t f32_to_s16_neon(const float* src, int16_t* dst, std::size_t n) noexcept {
+      std::size_t i = 0;
+      for (; i + 8 <= n; i += 8) {
+        const int32x4_t a = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(src + i), s16_scale));
+        const int32x4_t b = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(src + i + 4), s16_scale));
+        vst1q_s16(dst + i, vcombine_s16(vqmovn_s32(a), vqmovn_s32(b)));
+      }
+      return i;
+    }
+#endif
+  } // namespace detail
+
+  /// dst[i] = src[i] / 32768 for n samples; AVX2, SSE2 or NEON, chosen at runtime.
+  inline void s16_to_f32(const int16_t* src, float* dst, std::size_t n) noexcept {
+    std::size_t i = 0;
+#if defined(X64)
+    if (voxory::platform::cpu_features::get().avx2) i = detail::s16_to_f32_avx2(src, dst, n);
+    else i = detail::s16_to_f32_sse2(src, dst, n);
+#elif defined(X64_ARM)
+    i = detail::s16_to_f32_neon(src, dst, n);
+#endif
+    for (; i < n; ++i) dst[i] = static_cast<float>(src[i]) * detail::s16_inv_scale;
+  }
+
+  /// dst[i] = src[i] * 32768, rounded to nearest and saturated to int16, for n samples.
+  inline void f32_to_s16(const float* src, int16_t* dst, std::size_t n) noexcept {
+    std::size_t i = 0;
+#if defined(X64)
+    if (voxory::platform::cpu_features::get().avx2) i = detail::f32_to_s16_avx2(src, dst, n);
+    else i = detail::f32_to_s16_sse2(src, dst, n);
+#elif defined(X64_ARM)
+    i = detail::f32_to_s16_neon(src, dst, n);
+#endif
+    for (; i < n; ++i) dst[i] = detail::f32_to_s16_one(src[i]);
+  }
+
+  /// Copies n samples, converting between storage formats if From and To differ.
+  template<typename From, typename To>
+  inline void convert_samples(const From* src, To* dst, std::size_t n) noexcept {
+    static_assert(is_sample_type_v<From> && is_sample_type_v<To>, "samples are float or int16_t");
+    if constexpr (std::is_same_v<From, To>) voxory::containers::internal::bulk_copy(dst, src, n * sizeof(To));
+    else if constexpr (std::is_same_v<To, float>) s16_to_f32(src, dst, n);
+    else f32_to_s16(src, dst, n);
+  }
+} // namespace audio
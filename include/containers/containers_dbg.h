@@ -1,69 +1,91 @@
 #pragma once
 #include <utility.h>
-#include <multithreading/spin_lock.h>
-#include <mutex>
-#include <containers/impl/list.h>
+#include <platform/platform.h>
+#include <atomic>
+#include <cstdint>
 
 namespace voxory {
   namespace containers {
     namespace debug {
-      class iterator_base_dbg;
+      // Checked iterators without registration: the container owns a generation counter
+      // that it bumps whenever it invalidates iterators (reallocation, clear, move, destruction);
+      // an iterator remembers the container and the generation it was created in and compares
+      // them on dereference. Creating, copying and destroying an iterator is two stores,
+      // so DEBUG_ITERATORS builds stay close to release speed.
+
+      // out of line so the checks stay small enough to inline
+      [[noreturn]] void report_invalid_iterator(const char* what) noexcept;
+
+      // Starting generation of a new container. A container built where another one was destroyed
+      // (a loop-scoped local, placement new) must not start where the old one stopped, or the old
+      // iterators would validate against it: seeds come from a process-wide counter, spread over
+      // the 32-bit range (golden-ratio stride) so they land far from any live generation.
+      NODISCARD inline uint32_t next_generation_seed() noexcept {
+        static std::atomic<uint32_t> counter{ 0 };
+        return (counter.fetch_add(1, std::memory_order_relaxed) + 1) * 0x9E3779B9u;
+      }
+
       class container_base_dbg {
-      public: 
-        using list = list<iterator_base_dbg*> ;
-        container_base_dbg() noexcept(std::is_nothrow_default_constructible_v<list>) = default;
-        container_base_dbg(const container_base_dbg&) noexcept(std::is_nothrow_default_constructible_v<list>) : container_base_dbg() {}; // no work to do
-        container_base_dbg(container_base_dbg&& o) noexcept(noexcept(std::declval<list&>() = std::move(std::declval<list&>())));
-        void _release_proxy() noexcept;
-        void _lock() noexcept;
-        void _unlock() noexcept;
-        void _swap_proxies(container_base_dbg& o);
-        void _move_proxies(container_base_dbg& o);
+      public:
+        container_base_dbg() noexcept : _gen(next_generation_seed()) {}
+        container_base_dbg(const container_base_dbg&) noexcept : _gen(next_generation_seed()) {}; // a copy starts its own history
+        container_base_dbg(container_base_dbg&& o) noexcept : _gen(next_generation_seed()) { o._invalidate_iterators(); }
+        container_base_dbg& operator=(const container_base_dbg&) noexcept { return *this; }
+        container_base_dbg& operator=(container_base_dbg&&) noexcept { return *this; }
+        ~container_base_dbg() { _invalidate_iterators(); }
+
+        FORCE_INLINE void _invalidate_iterators() noexcept {
+          _gen.fetch_add(1, std::memory_order_relaxed);
+        }
 
-        list _list;
-        multithreading::spin_lock _sl;
-        std::atomic<uint32_t> _ver;
+        NODISCARD FORCE_INLINE uint32_t _generation() const noexcept {
+          return _gen.load(std::memory_order_relaxed);
+        }
+
+      private:
+        // relaxed atomic: a plain load/store on x64 and ARM64, but no data race for the
+        // (incorrect, yet common in canaries) case of a reader checking while a writer resizes
+        std::atomic<uint32_t> _gen;
       };
 
-      //TODO:     
       class iterator_base_dbg {
       public:
-        iterator_base_dbg(const iterator_base_dbg& o);
-        iterator_base_dbg(iterator_base_dbg&& o);
-        iterator_base_dbg(container_base_dbg* container);
-        iterator_base_dbg(const container_base_dbg* container);
-        void _release();
-        void _copy_proxy(const iterator_base_dbg& o);
+        iterator_base_dbg() noexcept : _container(nullptr), _gen(0) {}
+        iterator_base_dbg(const container_base_dbg* container) noexcept
+          : _container(container), _gen(container ? container->_generation() : 0) {}
 
-        const container_base_dbg* _container = nullptr;
-        container_base_dbg::list::node_type* _proxy = nullptr;
-      private:
-        void _register_to_container(const container_base_dbg* container);
+        // the iterator is still valid for its container
+        FORCE_INLINE void _verify() const noexcept {
+          if (_container == nullptr) [[unlikely]] report_invalid_iterator("dereferencing a singular iterator");
+          if (_container->_generation() != _gen) [[unlikely]] report_invalid_iterator("iterator used after invalidation");
+        }
+
+        // the check _verify() makes, without aborting (for tests)
+        NODISCARD FORCE_INLINE bool _is_valid() const noexcept {
+          return _container != nullptr && _container->_generation() == _gen;
+        }
+
+        // both iterators belong to the same container
+        FORCE_INLINE void _verify_compatible(const iterator_base_dbg& o) const noexcept {
+          if (_container != o._container) [[unlikely]] report_invalid_iterator("comparing iterators of different containers");
+        }
+
+        const container_base_dbg* _container;
+        uint32_t _gen;
       };
 
-      class container_base_rls;
-      class iterator_base_rls {
+      class iterator_base_rls;
+      class container_base_rls {
       public:
-        iterator_base_rls(const iterator_base_rls&) noexcept {};
-        iterator_base_rls(iterator_base_rls&&) noexcept {};
-        iterator_base_rls(container_base_rls*) noexcept {};
-        iterator_base_rls(const container_base_rls*) noexcept {};
-        FORCE_INLINE void _release() noexcept {};
-        FORCE_INLINE void _copy_proxy(const iterator_base_rls&) noexcept {};
-      private:
-        FORCE_INLINE void _register_to_container(const container_base_rls*) noexcept {};
+        FORCE_INLINE void _invalidate_iterators() noexcept {};
       };
 
-      class container_base_rls {
+      class iterator_base_rls {
       public:
-        container_base_rls() noexcept {};
-        container_base_rls(const container_base_rls&) noexcept {}; // no work to do
-        container_base_rls(container_base_rls&&) noexcept {};
-        FORCE_INLINE void _release_proxy() noexcept {};
-        FORCE_INLINE void _lock() noexcept {};
-        FORCE_INLINE void _unlock() noexcept {};
-        FORCE_INLINE void _swap_proxies(container_base_rls&) noexcept {};
-        FORCE_INLINE void _move_proxies(container_base_rls&) noexcept {};
+        iterator_base_rls() noexcept {};
+        iterator_base_rls(const container_base_rls*) noexcept {};
+        FORCE_INLINE void _verify() const noexcept {};
+        FORCE_INLINE void _verify_compatible(const iterator_base_rls&) const noexcept {};
       };
     }
 #ifdef DEBUG_ITERATORS
@@ -75,4 +97,4 @@ namespace voxory {
 #endif // DEBUG
 
   }
-}
\ No newline at end of file
+}
@@ -0,0 +1,230 @@
+#pragma once
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <platform/platform.h>
+#include <platform/cpu_features.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(X64)
+#include <immintrin.h>
+#elif defined(X64_ARM)
+#include <arm_neon.h>
+#endif
+
+namespace voxory {
+  namespace containers {
+    namespace internal {
+      // Bulk zero / fill / copy for trivially copyable storage.
+      //
+      // Below simd_fill_threshold the plain loop or libc call is cheapest. From
+      // streaming_store_threshold on, x64 writes with non-temporal stores: a 30 s window
+      // (1.9 MB of float) that is zero-padded or copied then bypasses the cache instead of
+      // evicting the model weights the next inference pass reads. In between, non-zero fills
+      // use AVX2 (or NEON) stores when the CPU has them. The SIMD paths are chosen at runtime,
+      // so a baseline build still uses AVX2 where it exists.
+      //
+      // AArch64 has no non-temporal store intrinsic; large zeroing and copying stay with
+      // memset / memcpy there, which already use DC ZVA and paired stores.
+
+      inline constexpr std::size_t simd_fill_threshold = 256;           // bytes
+      inline constexpr std::size_t streaming_store_threshold = 1 << 20; // bytes; about an L2 worth
+
+#if defined(X64)
+      // d is 16 B aligned, bytes is a multiple of 16
+      inline void stream_fill_sse2(char* d, std::size_t bytes, uint64_t pattern) noexcept {
+        const __m128i v = _mm_set1_epi64x(static_cast<long long>(pattern));
+        for (; bytes >= 64; bytes -= 64, d += 64) {
+          _mm_stream_si128(reinterpret_cast<__m128i*>(d), v);
+          _mm_stream_si128(reinterpret_cast<__m128i*>(d + 16), v);
+          _mm_stream_si128(reinterpret_cast<__m128i*>(d + 32), v);
+          _mm_stream_si128(reinterpret_cast<__m128i*>(d + 48), v);
+        }
+        for (; bytes != 0; bytes -= 16, d += 16) _mm_stream_si128(reinterpret_cast<__m128i*>(d), v);
+      }
+
+      // d is 32 B aligned, bytes is a multiple of 32
+      TARGET_AVX2 inline void stream_fill_avx2(char* d, std::size_t bytes, uint64_t pattern) noexcept {
+        const __m256i v = _mm256_set1_epi64x(static_cast<long long>(pattern));
+        for (; bytes >= 128; bytes -= 128, d += 128) {
+          _mm256_stream_si256(reinterpret_cast<__m256i*>(d), v);
+          _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 32), v);
+          _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 64), v);
+          _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 96), v);
+        }
+        for (; bytes != 0; bytes -= 32, d += 32) _mm256_stream_si256(reinterpret_cast<__m256i*>(d), v);
+      }
+
+      // d is 32 B aligned, bytes is a multiple of 32
+      TARGET_AVX2 inline void store_fill_avx2(char* d, std::size_t bytes, uint64_t pattern) noexcept {
+        const __m256i v = _mm256_set1_epi64x(static_cast<long long>(pattern));
+        for (; bytes >= 128; bytes -= 128, d += 128) {
+          _mm256_store_si256(reinterpret_cast<__m256i*>(d), v);
+          _mm256_store_si256(reinterpret_cast<__m256i*>(d + 32), v);
+          _mm256_store_si256(reinterpret_cast<__m256i*>(d + 64), v);
+          _mm256_store_si256(reinterpret_cast<__m256i*>(d + 96), v);
+        }
+        for (; bytes != 0; bytes -= 32, d += 32) _mm256_store_si256(reinterpret_cast<__m256i*>(d), v);
+      }
+
+      // d is 16 B aligned, bytes is a multiple of 64; the source is read once, so keep it out of L2 too
+      inline void stream_copy_sse2(char* d, const char* s, std::size_t bytes) noexcept {
+        for (; bytes != 0; bytes -= 64, d += 64, s += 64) {
+          _mm_prefetch(s + 1024, _MM_HINT_NTA);
+          const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+          const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+          const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+          const __m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 48));
+          _mm_stream_si128(reinterpret_cast<__m128i*>(d), a);
+          _mm_stream_si128(reinterpret_cast<__m128i*>(d + 16), b);
+          _mm_stream_si128(reinterpret_cast<__m128i*>(d + 32), c);
+          _mm_stream_si128(reinterpret_cast<__m128i*>(d + 48), e);
+        }
+      }
+
+      // d is 32 B aligned, bytes is a multiple of 128
+      TARGET_AVX2 inline void stream_copy_avx2(char* d, const char* s, std::size_t bytes) noexcept {
+        for (; bytes != 0; bytes -= 128, d += 128, s += 128) {
+          _mm_prefetch(s + 1024, _MM_HINT_NTA);
+          _mm_prefetch(s + 1088, _MM_HINT_NTA);
+          const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s));
+          const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 32));
+          const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 64));
+          const __m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 96));
+          _mm256_stream_si256(reinterpret_cast<__m256i*>(d), a);
+          _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 32), b);
+          _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 64), c);
+          _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 96), e);
+        }
+      }
+
+      FORCE_INLINE std::size_t bytes_to_alignment(const void* p, std::size_t alignment) noexcept {
+        return static_cast<std::size_t>(-reinterpret_cast<std::uintptr_t>(p)) & (alignment - 1);
+      }
+#elif defined(X64_ARM)
+      // bytes is a multiple of 64
+      inline void store_fill_neon(char* d, std::size_t bytes, uint64_t pattern) noexcept {
+        const uint8x16_t v = vreinterpretq_u8_u64(vdupq_n_u64(pattern));
+        for (; bytes != 0; bytes -= 64, d += 64) {
+          vst1q_u8(reinterpret_cast<uint8_t*>(d), v);
+          vst1q_u8(reinterpret_cast<uint8_t*>(d + 16), v);
+          vst1q_u8(reinterpret_cast<uint8_t*>(d + 32), v);
+          vst1q_u8(reinterpret_cast<uint8_t*>(d + 48), v);
+        }
+      }
+#endif
+
+      /// memset(dst, 0, bytes), with non-temporal stores from streaming_store_threshold on (x64).
+      inline void bulk_zero(void* dst, std::size_t bytes) noexcept {
+#if defined(X64)
+        if (bytes >= streaming_store_threshold) {
+          char* d = static_cast<char*>(dst);
+          const bool avx2 = platform::cpu_features::get().avx2;
+          const std::size_t alignment = avx2 ? 32 : 16;
+          const std::size_t head = bytes_to_alignment(d, alignment);
+          std::memset(d, 0, head);
+          const std::size_t body = (bytes - head) & ~(alignment - 1);
+          if (avx2) stream_fill_avx2(d + head, body, 0);
+          else stream_fill_sse2(d + head, body, 0);
+          std::memset(d + head + body, 0, bytes - head - body);
+          _mm_sfence(); // streaming stores are weakly ordered
+          return;
+        }
+#endif
+        std::memset(dst, 0, bytes);
+      }
+
+      /// memcpy for non-overlapping ranges, with non-temporal stores from streaming_store_threshold on (x64).
+      inline void bulk_copy(void* dst, const void* src, std::size_t bytes) noexcept {
+#if defined(X64)
+        if (bytes >= streaming_store_threshold) {
+          char* d = static_cast<char*>(dst);
+          const char* s = static_cast<const char*>(src);
+          const bool avx2 = platform::cpu_features::get().avx2;
+          const std::size_t head = bytes_to_alignment(d, avx2 ? 32 : 16);
+          std::memcpy(d, s, head);
+          const std::size_t step = avx2 ? 128 : 64;
+          const std::size_t body = (bytes - head) / step * step;
+          if (avx2) stream_copy_avx2(d + head, s + head, body);
+          else stream_copy_sse2(d + head, s + head, body);
+          std::memcpy(d + head + body, s + head + body, bytes - head - body);
+          _mm_sfence();
+          return;
+        }
+#endif
+        std::memcpy(dst, src, bytes);
+      }
+
+      /// memmove that takes the bulk_copy path when the ranges do not overlap.
+      inline void bulk_move(void* dst, const void* src, std::size_t bytes) noexcept {
+        const auto d = reinterpret_cast<std::uintptr_t>(dst);
+        const auto s = reinterpret_cast<std::uintptr_t>(src);
+        if (bytes >= streaming_store_threshold && (d + bytes <= s || s + bytes <= d)) {
+          bulk_copy(dst, src, bytes);
+        }
+        else {
+          std::memmove(dst, src, bytes);
+        }
+      }
+
+      /**
+       * @brief std::fill_n(dst, n, value) for 4 and 8 byte trivially copyable values.
+       * @details All-zero values go to bulk_zero(). Otherwise the body is written with AVX2
+       *          (non-temporal from streaming_store_threshold on) or NEON stores; small fills
+       *          and CPUs without those stay with the compiler's loop.
+       */
+      template<typename T>
+      inline void bulk_fill(T* dst, std::size_t n, const T& value) noexcept {
+        static_assert(std::is_trivially_copyable_v<T> && (sizeof(T) == 4 || sizeof(T) == 8),
+                      "bulk_fill handles 4 and 8 byte trivially copyable values");
+        const std::size_t bytes = n * sizeof(T);
+        uint64_t pattern = 0;
+        std::memcpy(&pattern, &value, sizeof(T));
+        if constexpr (sizeof(T) == 4) pattern |= pattern << 32;
+
+        if (pattern == 0) {
+          bulk_zero(dst, bytes);
+          return;
+        }
+        if (bytes < simd_fill_threshold || reinterpret_cast<std::uintptr_t>(dst) % sizeof(T) != 0) {
+          std::fill_n(dst, n, value);
+          return;
+        }
+#if defined(X64)
+        const bool streaming = bytes >= streaming_store_threshold;
+        const bool avx2 = platform::cpu_features::get().avx2;
+        if (!avx2 && !streaming) {
+          std::fill_n(dst, n, value); // SSE2 is what the compiler vectorizes for anyway
+          return;
+        }
+        const std::size_t alignment = avx2 ? 32 : 16;
+        const std::size_t head = bytes_to_alignment(dst, alignment) / sizeof(T);
+        std::fill_n(dst, head, value);
+        char* body_start = reinterpret_cast<char*>(dst + head);
+        const std::size_t body = (bytes - head * sizeof(T)) & ~(alignment - 1);
+        if (streaming) {
+          if (avx2) stream_fill_avx2(body_start, body, pattern);
+          else stream_fill_sse2(body_start, body, pattern);
+        }
+        else {
+          store_fill_avx2(body_start, body, pattern);
+        }
+        const std::size_t done = head + body / sizeof(T);
+        std::fill_n(dst + done, n - done, value);
+        if (streaming) _mm_sfence();
+#elif defined(X64_ARM)
+        const std::size_t body = bytes & ~std::size_t(63);
+        store_fill_neon(reinterpret_cast<char*>(dst), body, pattern);
+        const std::size_t done = body / sizeof(T);
+        std::fill_n(dst + done, n - done, value);
+#else
+        std::fill_n(dst, n, value);
+#endif
+      }
+    } // namespace internal
+  } // namespace containers
+}
@@ -1,5 +1,6 @@
 #pragma once 
 #include <utility.h>
+#include <containers/detail/bulk_memory.h>
 
 #ifdef DEBUG_ITERATORS
 #define ITER_DEBUG_WRAP(iterator_name, pointer) iterator_name(this, pointer) 
@@ -10,6 +11,12 @@
 namespace voxory
 {
   namespace containers {
+    /// Selects default-initialization (no zero-fill for trivial types), like std::make_unique_for_overwrite.
+    struct default_init_t {
+      explicit default_init_t() = default;
+    };
+    inline constexpr default_init_t default_init{};
+
     namespace internal {
       using utility::unfancy;
 
@@ -183,7 +190,7 @@ namespace voxory
           pointer src_end = unfancy(unwrap(end));
           std::size_t count = static_cast<std::size_t>(src_end - src_raw);
           std::size_t bytes = count * sizeof(value_type);
-          std::memmove(unfancy(dest), src_raw, bytes);
+          bulk_move(unfancy(dest), src_raw, bytes);
           dest += count;
           return dest;
         }
@@ -216,7 +223,7 @@ namespace voxory
           pointer src_end = unfancy(unwrap(end));
           std::size_t count = static_cast<std::size_t>(src_end - src_raw);
           std::size_t bytes = count * sizeof(value_type);
-          std::memmove(unfancy(dest), src_raw, bytes);
+          bulk_move(unfancy(dest), src_raw, bytes);
           dest += count;
           return dest;
         }
@@ -240,6 +247,19 @@ namespace voxory
         return std::memcmp(&val, &zero, sizeof(T)) == 0;
       }
 
+      // 4 and 8 byte scalars (float, int32_t, double, pointers) go through bulk_fill / bulk_zero,
+      // unless the allocator constructs the elements itself
+      template<typename Alloc, typename FwdIt>
+      inline constexpr bool use_bulk_fill_v =
+        type_traits::use_zero_memset_value_construct_v<FwdIt> &&
+        (sizeof(typename std::allocator_traits<Alloc>::value_type) == 4 || sizeof(typename std::allocator_traits<Alloc>::value_type) == 8) &&
+        !type_traits::has_construct_v<Alloc, typename std::allocator_traits<Alloc>::pointer, const typename std::allocator_traits<Alloc>::value_type&>;
+
+      template<typename Alloc, typename FwdIt>
+      inline constexpr bool use_bulk_zero_v =
+        type_traits::use_zero_memset_value_construct_v<FwdIt> &&
+        !type_traits::has_construct_v<Alloc, typename std::allocator_traits<Alloc>::pointer>;
+
       template<typename Alloc, typename FwdIt>
       NODISCARD CONSTEXPR typename std::allocator_traits<Alloc>::pointer uninitialized_fill(const FwdIt first, const FwdIt end, const typename std::allocator_traits<Alloc>::value_type& val, Alloc& alloc)
         noexcept(type_traits::use_memmove_copy_construct_v<FwdIt> || std::is_nothrow_copy_constructible_v<typename std::allocator_traits<Alloc>::value_type>)
@@ -257,14 +277,20 @@ namespace voxory
           std::size_t bytes = count * sizeof(value_type);
           if (is_zeroed(val))
           {
-            std::memset(src_raw, 0, bytes);
+            bulk_zero(src_raw, bytes);
             return src_raw + count;
           }
           else {
-            std::memset(src_raw, &val, bytes);
+            std::memset(src_raw, static_cast<unsigned char>(val), bytes);
             return src_raw + count;
           }
         }
+        else if constexpr (use_bulk_fill_v<Alloc, FwdIt>) {
+          pointer src_raw = unfancy(unwrap(first));
+          std::size_t count = static_cast<std::size_t>(unfancy(unwrap(end)) - src_raw);
+          bulk_fill(src_raw, count, val);
+          return src_raw + count;
+        }
         else {
           // generic safe path for forward iterators
           construct_helper<Alloc> c(alloc, unfancy(unwrap(first)));
@@ -293,7 +319,14 @@ namespace voxory
           pointer src_end = unfancy(unwrap(end));
           std::size_t count = static_cast<std::size_t>(src_end - src_raw);
           std::size_t bytes = count * sizeof(value_type);
-          std::memset(src_raw, 0, bytes);
+          bulk_zero(src_raw, bytes);
+          return src_raw + count;
+        }
+        else if constexpr (use_bulk_zero_v<Alloc, FwdIt>) {
+          // value-initialized scalars are all-zero bits
+          pointer src_raw = unfancy(unwrap(first));
+          std::size_t count = static_cast<std::size_t>(unfancy(unwrap(end)) - src_raw);
+          bulk_zero(src_raw, count * sizeof(value_type));
           return src_raw + count;
         }
         else {
@@ -322,7 +355,7 @@ namespace voxory
           // assume contiguous / pointer-like: get raw pointers
           pointer src_raw = unfancy(unwrap(first));
           size_t bytes = count * sizeof(value_type);
-          std::memmove(unfancy(dest), src_raw, bytes);
+          bulk_move(unfancy(dest), src_raw, bytes);
           dest += count;
           return dest;
         }
@@ -353,7 +386,7 @@ namespace voxory
           pointer src_raw = unfancy(unwrap(first));
           pointer src_end = src_raw + count;
           size_t bytes = count * sizeof(value_type);
-          std::memmove(unfancy(dest), src_raw, bytes);
+          bulk_move(unfancy(dest), src_raw, bytes);
           dest += count;
           return dest;
         }
@@ -386,18 +419,20 @@ namespace voxory
           std::size_t bytes = count * sizeof(value_type);
           if (is_zeroed(val))
           {
-            std::memset(src_raw, 0, bytes);
+            bulk_zero(src_raw, bytes);
             return src_raw + count;
           }
           else {
-            std::memset(src_raw, val, bytes);
+            std::memset(src_raw, static_cast<unsigned char>(val), bytes);
             return src_raw + count;
           }
         }
+        else if constexpr (use_bulk_fill_v<Alloc, FwdIt>) {
+          pointer src_raw = unfancy(unwrap(first));
+          bulk_fill(src_raw, count, val);
+          return src_raw + count;
+        }
         else {
-          if constexpr (type_traits::use_zero_memset_value_construct_v<FwdIt>) {
-
-          }
           // generic safe path for forward iterators
           construct_helper<Alloc> c(alloc, unfancy(unwrap(first)));
           pointer it = unfancy(unwrap(first));
@@ -423,7 +458,12 @@ namespace voxory
           // assume contiguous / pointer-like: get raw pointers
           pointer src_raw = unfancy(unwrap(first));
           std::size_t bytes = count * sizeof(value_type);
-          std::memset(src_raw, 0, bytes);
+          bulk_zero(src_raw, bytes);
+          return src_raw + count;
+        }
+        else if constexpr (use_bulk_zero_v<Alloc, FwdIt>) {
+          pointer src_raw = unfancy(unwrap(first));
+          bulk_zero(src_raw, count * sizeof(value_type));
           return src_raw + count;
         }
         else {
@@ -439,6 +479,46 @@ namespace voxory
         }
       }
 
+      /**
+       * @brief Default-initializes count elements: trivial types are left untouched (no store at all),
+       *        others get `new (p) T`. An allocator with its own construct() is still honoured.
+       */
+      template<typename Alloc, typename FwdIt>
+      NODISCARD CONSTEXPR typename std::allocator_traits<Alloc>::pointer uninitialized_default_init_n(const FwdIt first, size_t count, Alloc& alloc)
+        noexcept(std::is_nothrow_default_constructible_v<typename std::allocator_traits<Alloc>::value_type>)
+      {
+        using value_type = typename std::allocator_traits<Alloc>::value_type;
+        using pointer = typename std::allocator_traits<Alloc>::pointer;
+
+        if constexpr (type_traits::has_construct_v<Alloc, pointer>) {
+          return uninitialized_default_construct_n(first, count, alloc);
+        }
+        else if constexpr (std::is_trivially_default_constructible_v<value_type>) {
+          return unfancy(unwrap(first)) + count;
+        }
+        else {
+          pointer begin = unfancy(unwrap(first));
+          pointer it = begin;
+          if constexpr (std::is_nothrow_default_constructible_v<value_type>) {
+            for (pointer end = begin + count; it != end; ++it) {
+              ::new (static_cast<void*>(std::addressof(*it))) value_type;
+            }
+          }
+          else {
+            try {
+              for (pointer end = begin + count; it != end; ++it) {
+                ::new (static_cast<void*>(std::addressof(*it))) value_type;
+              }
+            }
+            catch (...) {
+              std::destroy(begin, it);
+              throw;
+            }
+          }
+          return it;
+        }
+      }
+
       template<typename Alloc>
       class realloc_guard {
       public:
@@ -478,7 +558,7 @@ namespace voxory
           // assume contiguous / pointer-like: get raw pointers
           pointer src_raw = unfancy(unwrap(first));
           size_t bytes = count * sizeof(value_type);
-          std::memmove(unfancy(dest), src_raw, bytes);
+          bulk_move(unfancy(dest), src_raw, bytes);
           dest += count;
           return dest;
         }
@@ -509,7 +589,7 @@ namespace voxory
           pointer src_raw = unfancy(unwrap(first));
           pointer src_end = src_raw + count;
           size_t bytes = count * sizeof(value_type);
-          std::memmove(unfancy(dest), src_raw, bytes);
+          bulk_move(unfancy(dest), src_raw, bytes);
           dest += count;
           return dest;
         }
@@ -551,6 +631,53 @@ namespace voxory
         return at + 1;
       }
       
+      /// Relocation may bypass Alloc: the type is trivially relocatable and Alloc does not customize construct/destroy.
+      template<typename Alloc>
+      inline constexpr bool is_memcpy_relocatable_v =
+        type_traits::is_trivially_relocatable_v<typename std::allocator_traits<Alloc>::value_type> &&
+        !type_traits::has_construct_v<Alloc, typename std::allocator_traits<Alloc>::pointer, typename std::allocator_traits<Alloc>::value_type&&> &&
+        !type_traits::has_destroy_v<Alloc, typename std::allocator_traits<Alloc>::pointer>;
+
+      /**
+       * @brief Moves [first, last) to uninitialized dest and ends the lifetime of the sources.
+       *
+       * @details Trivially relocatable types are copied with one memcpy and never destroyed;
+       *          others are moved (copied if the move may throw) and then destroyed. If a copy
+       *          throws, the constructed part of dest is destroyed and the sources are intact.
+       *          The ranges must not overlap.
+       * @return One past the last relocated element in dest.
+       */
+      template<typename Alloc>
+      NODISCARD CONSTEXPR typename std::allocator_traits<Alloc>::pointer uninitialized_relocate(
+        typename std::allocator_traits<Alloc>::pointer first, typename std::allocator_traits<Alloc>::pointer last,
+        typename std::allocator_traits<Alloc>::pointer dest, Alloc& alloc)
+        noexcept(is_memcpy_relocatable_v<Alloc> || std::is_nothrow_move_constructible_v<typename std::allocator_traits<Alloc>::value_type> ||
+                 std::is_nothrow_copy_constructible_v<typename std::allocator_traits<Alloc>::value_type>)
+      {
+        using value_type = typename std::allocator_traits<Alloc>::value_type;
+        using pointer = typename std::allocator_traits<Alloc>::pointer;
+        if constexpr (is_memcpy_relocatable_v<Alloc>) {
+          std::size_t count = static_cast<std::size_t>(last - first);
+          if (count != 0) {
+            bulk_copy(static_cast<void*>(unfancy(dest)), static_cast<const void*>(unfancy(first)), count * sizeof(value_type));
+          }
+          return dest + count;
+        }
+        else {
+          pointer new_last;
+          if constexpr (std::is_nothrow_move_constructible_v<value_type> || !std::is_copy_constructible_v<value_type>) {
+            new_last = uninitialized_move(first, last, dest, alloc);
+          }
+          else {
+            new_last = uninitialized_copy(first, last, dest, alloc);
+          }
+          if constexpr (!std::is_trivially_destructible_v<value_type>) {
+            for (; first != last; ++first) (void)destroy_at(first, alloc);
+          }
+          return new_last;
+        }
+      }
+
       template<typename Alloc, typename FwdIt>
       constexpr bool is_nothrow_uninitialized_moveable_v = noexcept(internal::uninitialized_move(
         std::declval<FwdIt>(), std::declval<FwdIt>(),
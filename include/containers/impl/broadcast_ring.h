@@ -0,0 +1,373 @@
+#pragma once
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <containers/impl/ring_buffer.h>
+#include <memory/aligned_allocator.h>
+#include <utility.h>
+#include <platform/platform.h>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <type_traits>
+
+namespace voxory {
+  namespace containers {
+    /**
+     * @brief Lock-free single-producer, multi-consumer broadcast ring.
+     *
+     * @details Every reader sees every element: the producer writes a run once and each reader
+     *          walks the same storage with its own cursor, so fan-out to N consumers costs one
+     *          write plus N cursor loads instead of N copies. Positions are monotonic 64-bit
+     *          counters; the storage is a power of two and a position maps to a slot with a mask.
+     *
+     *          Writes and reads use the two-span API of ring_buffer (write_spans / commit_write,
+     *          read_spans / commit_read) and hand out ring_segments, so consumers process the
+     *          data in place.
+     *
+     *          What happens when the slowest reader is a full ring behind is picked by the policy:
+     *          - ring_policy::overflow_block:     the producer waits for the slowest reader.
+     *          - ring_policy::overflow_reject:    elements that do not fit are dropped and counted.
+     *          - ring_policy::overflow_overwrite: the producer never waits; a lapped reader finds
+     *            out in read_spans() (skips to the oldest intact element) or in commit_read()
+     *            (the spans were overwritten while it was reading them and must be discarded).
+     *            Readers are never scanned by the producer in this mode.
+     *
+     * @note One producer thread; each reader id is used by one thread at a time.
+     *       add_reader() / remove_reader() may run concurrently with everything else.
+     *
+     * @tparam T             Trivially copyable element type; lapped readers may observe torn values.
+     * @tparam SlowestPolicy ring_policy::overflow_block, overflow_reject or overflow_overwrite.
+     * @tparam Alloc         Allocator for the element storage.
+     */
+    template<typename T, typename SlowestPolicy = ring_policy::overflow_overwrite,
+             typename Alloc = memory::aligned_allocator<T>>
+    class broadcast_ring {
+      using FirstOneSecondArgs = utility::detail::FirstOneSecondArgs;
+      using overflow_mode = ring_policy::overflow_mode;
+      static_assert(std::is_trivially_copyable_v<T>, "broadcast_ring requires trivially copyable elements");
+      static_assert(SlowestPolicy::mode == overflow_mode::block || SlowestPolicy::mode == overflow_mode::reject ||
+                    SlowestPolicy::mode == overflow_mode::overwrite,
+                    "broadcast_ring supports overflow_block, overflow_reject and overflow_overwrite");
+    public:
+      using allocator_type = Alloc;
+      using allocator_traits = std::allocator_traits<Alloc>;
+      using value_type = T;
+      using size_type = std::size_t;
+      using pointer = typename allocator_traits::pointer;
+      using reader_id = size_type;
+
+      static constexpr overflow_mode overflow = SlowestPolicy::mode;
+      static constexpr reader_id npos = static_cast<reader_id>(-1);
+
+      /**
+       * @param capacity    Elements kept for the slowest reader, rounded up to a power of two.
+       * @param max_readers Number of reader slots.
+       */
+      explicit broadcast_ring(size_type capacity, size_type max_readers, const allocator_type& alloc = allocator_type())
+        : _pair(FirstOneSecondArgs{}, alloc, nullptr),
+          _capacity(std::bit_ceil(std::max<size_type>(capacity, 1))),
+          _max_readers(max_readers),
+          _cursors(std::make_unique<_cursor[]>(max_readers)) {
+        _pair._second = allocator_traits::allocate(_pair.first(), _capacity);
+        std::memset(static_cast<void*>(utility::unfancy(_pair._second)), 0, _capacity * sizeof(T));
+      }
+
+      broadcast_ring(const broadcast_ring&) = delete;
+      broadcast_ring& operator=(const broadcast_ring&) = delete;
+
+      ~broadcast_ring() {
+        allocator_traits::deallocate(_pair.first(), _pair._second, _capacity);
+      }
+
+      // --- producer ---
+
+      /**
+       * @brief Writable storage for up to max elements after the newest one.
+       * @details With overflow_block / overflow_reject the spans never cover elements an active
+       *          reader has not consumed yet (empty when the slowest reader is a full ring behind).
+       *          With overflow_overwrite they are min(max, capacity()) long and readers that still
+       *          need those slots will see themselves lapped.
+       */
+      ring_segments<T> write_spans(size_type max = npos) noexcept {
+        const uint64_t w = _writer._write.load(std::memory_order_relaxed);
+        size_type n = std::min(max, _capacity);
+        if constexpr (overflow == overflow_mode::overwrite) {
+          if (w + n > _writer._claimed) {
+            // announce the slots about to be overwritten before touching them (seqlock style)
+            _writer._claimed = w + n;
+            _writer._claim.store(w + n, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+          }
+        }
+        else {
+          n = std::min(n, _free(w));
+        }
+        return _segments<T>(w, n);
+      }
+
+      /// Publishes n elements written through write_spans() to every reader.
+      void commit_write(size_type n) noexcept {
+        const uint64_t w = _writer._write.load(std::memory_order_relaxed) + n;
+        _writer._write.store(w, std::memory_order_seq_cst);
+        if (_signal._sleeping_readers.load(std::memory_order_seq_cst) != 0) {
+          _signal._data_epoch.fetch_add(1, std::memory_order_release);
+          _signal._data_epoch.notify_all();
+        }
+      }
+
+      /**
+       * @brief Copies n elements into the ring.
+       * @return Elements published: n, except with overflow_reject (what fit) and with
+       *         overflow_block after close().
+       */
+      size_type push(const T* src, size_type n) noexcept {
+        size_type done = 0;
+        while (done < n) {
+          if constexpr (overflow == overflow_mode::block) {
+            if (_wait_for_space() == 0) break;
+          }
+          ring_segments<T> spans = write_spans(n - done);
+          if (spans.empty()) break;
+          spans.for_each([&](std::span<T> s) {
+            std::memcpy(static_cast<void*>(s.data()), src + done, s.size() * sizeof(T));
+            done += s.size();
+          });
+          commit_write(spans.size());
+          if constexpr (overflow == overflow_mode::reject) break;
+        }
+        if constexpr (overflow == overflow_mode::reject) {
+          _writer._dropped.fetch_add(n - done, std::memory_order_relaxed);
+        }
+        return done;
+      }
+
+      size_type push(std::span<const T> src) noexcept { return push(src.data(), src.size()); }
+
+      /// Wakes every blocked producer and reader; waits return immediately from now on.
+      void close() noexcept {
+        _signal._closed.store(true, std::memory_order_seq_cst);
+        _signal._data_epoch.fetch_add(1, std::memory_order_release);
+        _signal._data_epoch.notify_all();
+        _signal._space_epoch.fetch_add(1, std::memory_order_release);
+        _signal._space_epoch.notify_all();
+      }
+
+      // --- readers ---
+
+      /**
+       * @brief Claims a reader slot; the reader starts at the newest element.
+       * @return The reader id, or npos if all slots are taken.
+       */
+      reader_id add_reader() noexcept {
+        for (reader_id id = 0; id < _max_readers; ++id) {
+          _cursor& c = _cursors[id];
+          bool expected = false;
+          if (!c._active.compare_exchange_strong(expected, true, std::memory_order_seq_cst)) continue;
+          // the producer may still see a stale position until this store; that only makes it
+          // more conservative. Loading the position after activation means no write the
+          // producer sized without this reader can reach its unread slots.
+          c._pos.store(_writer._write.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+          c._lapped.store(0, std::memory_order_relaxed);
+          _wake_producer();
+          return id;
+        }
+        return npos;
+      }
+
+      /// Releases a reader slot; a producer blocked on this reader continues.
+      void remove_reader(reader_id id) noexcept {
+        _cursor& c = _cursors[id];
+        c._pos.store(_writer._write.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+        c._active.store(false, std::memory_order_seq_cst);
+        _wake_producer();
+      }
+
+      /**
+       * @brief Readable spans over up to max unread elements of reader id.
+       * @details With overflow_overwrite a reader that fell more than capacity() behind first
+       *          skips to the oldest slot the producer has not claimed (see lapped()).
+       */
+      ring_segments<const T> read_spans(reader_id id, size_type max = npos) noexcept {
+        _cursor& c = _cursors[id];
+        uint64_t r = c._pos.load(std::memory_order_relaxed);
+        const uint64_t w = _writer._write.load(std::memory_order_acquire);
+        if constexpr (overflow == overflow_mode::overwrite) {
+          const uint64_t claim = _writer._claim.load(std::memory_order_acquire);
+          if (claim - r > _capacity) {
+            c._lapped.fetch_add(claim - _capacity - r, std::memory_order_relaxed);
+            r = claim - _capacity;
+            c._pos.store(r, std::memory_order_relaxed);
+          }
+        }
+        return _segments<const T>(r, std::min<size_type>(static_cast<size_type>(w - r), max));
+      }
+
+      /**
+       * @brief Consumes n elements returned by read_spans().
+       * @return False with overflow_overwrite if the producer claimed any of those slots while
+       *         they were being read: the data seen must be discarded and the reader has been
+       *         moved to the oldest intact element. Always true otherwise.
+       */
+      bool commit_read(reader_id id, size_type n) noexcept {
+        _cursor& c = _cursors[id];
+        const uint64_t r = c._pos.load(std::memory_order_relaxed);
+        if constexpr (overflow == overflow_mode::overwrite) {
+          // order the payload loads before the claim re-check
+          std::atomic_thread_fence(std::memory_order_acquire);
+          const uint64_t claim = _writer._claim.load(std::memory_order_relaxed);
+          if (claim - r > _capacity) {
+            c._lapped.fetch_add(claim - _capacity - r, std::memory_order_relaxed);
+            c._pos.store(claim - _capacity, std::memory_order_relaxed);
+            return false;
+          }
+          c._pos.store(r + n, std::memory_order_relaxed);
+        }
+        else {
+          c._pos.store(r + n, std::memory_order_seq_cst);
+          if constexpr (overflow == overflow_mode::block) {
+            if (_signal._producer_sleeping.load(std::memory_order_seq_cst)) _wake_producer();
+          }
+        }
+        return true;
+      }
+
+      /**
+       * @brief Copies up to n unread elements of reader id into dst and consumes them.
+       * @return Elements copied; lapped runs are retried from the oldest intact element.
+       */
+      size_type pop(reader_id id, T* dst, size_type n) noexcept {
+        for (;;) {
+          ring_segments<const T> spans = read_spans(id, n);
+          size_type done = 0;
+          spans.for_each([&](std::span<const T> s) {
+            std::memcpy(static_cast<void*>(dst + done), s.data(), s.size() * sizeof(T));
+            done += s.size();
+          });
+          if (commit_read(id, done)) return done;
+        }
+      }
+
+      size_type pop(reader_id id, std::span<T> dst) noexcept { return pop(id, dst.data(), dst.size()); }
+
+      /**
+       * @brief Blocks until reader id has at least n unread elements or the ring is closed.
+       * @return The number of unread elements.
+       */
+      size_type wait_for_data(reader_id id, size_type n) noexcept {
+        n = std::min(n, _capacity);
+        for (;;) {
+          size_type avail = available(id);
+          if (avail >= n || closed()) return avail;
+          const uint32_t epoch = _signal._data_epoch.load(std::memory_order_acquire);
+          _signal._sleeping_readers.fetch_add(1, std::memory_order_seq_cst);
+          avail = available(id);
+          if (avail < n && !closed()) _signal._data_epoch.wait(epoch, std::memory_order_acquire);
+          _signal._sleeping_readers.fetch_sub(1, std::memory_order_relaxed);
+        }
+      }
+
+      // --- diagnostics ---
+
+      /// Unread elements of reader id (may exceed capacity() for a lapped reader).
+      NODISCARD size_type available(reader_id id) const noexcept {
+        return static_cast<size_type>(_writer._write.load(std::memory_order_seq_cst) -
+                                      _cursors[id]._pos.load(std::memory_order_relaxed));
+      }
+
+      /// Elements reader id skipped because the producer overwrote them (overflow_overwrite).
+      NODISCARD uint64_t lapped(reader_id id) const noexcept {
+        return _cursors[id]._lapped.load(std::memory_order_relaxed);
+      }
+
+      /// Elements push() refused because the slowest reader was a full ring behind (overflow_reject).
+      NODISCARD uint64_t dropped() const noexcept { return _writer._dropped.load(std::memory_order_relaxed); }
+      /// Elements published so far.
+      NODISCARD uint64_t written() const noexcept { return _writer._write.load(std::memory_order_acquire); }
+
+      NODISCARD size_type readers() const noexcept {
+        size_type n = 0;
+        for (size_type i = 0; i < _max_readers; ++i) n += _cursors[i]._active.load(std::memory_order_relaxed);
+        return n;
+      }
+
+      NODISCARD CONSTEXPR size_type capacity() const noexcept { return _capacity; }
+      NODISCARD CONSTEXPR size_type max_readers() const noexcept { return _max_readers; }
+      NODISCARD bool closed() const noexcept { return _signal._closed.load(std::memory_order_acquire); }
+
+    private:
+      // each reader's cursor is written by that reader only and sits on its own cache line
+      struct alignas(64) _cursor {
+        std::atomic<uint64_t> _pos{ 0 };    // next position to read
+        std::atomic<uint64_t> _lapped{ 0 };
+        std::atomic<bool> _active{ false };
+      };
+
+      // written by the producer only
+      struct alignas(64) _producer_state {
+        std::atomic<uint64_t> _write{ 0 };   // elements published
+        std::atomic<uint64_t> _claim{ 0 };   // slots below this may be overwritten (overflow_overwrite)
+        std::atomic<uint64_t> _dropped{ 0 };
+        uint64_t _claimed = 0;               // producer-private copy of _claim
+      };
+
+      struct alignas(64) _wait_state {
+        std::atomic<uint32_t> _data_epoch{ 0 };
+        std::atomic<uint32_t> _space_epoch{ 0 };
+        std::atomic<uint32_t> _sleeping_readers{ 0 };
+        std::atomic<bool> _producer_sleeping{ false };
+        std::atomic<bool> _closed{ false };
+      };
+
+      template<typename U>
+      ring_segments<U> _segments(uint64_t pos, size_type n) const noexcept {
+        T* data = utility::unfancy(_pair._second);
+        const size_type offset = static_cast<size_type>(pos) & (_capacity - 1);
+        const size_type head = std::min(n, _capacity - offset);
+        return { std::span<U>(data + offset, head), std::span<U>(data, n - head) };
+      }
+
+      // free slots behind the slowest active reader: one cursor load per reader slot
+      size_type _free(uint64_t w) const noexcept {
+        uint64_t slowest = w;
+        for (size_type i = 0; i < _max_readers; ++i) {
+          const _cursor& c = _cursors[i];
+          if (c._active.load(std::memory_order_seq_cst)) slowest = std::min(slowest, c._pos.load(std::memory_order_seq_cst));
+        }
+        const uint64_t used = w - slowest;
+        return used >= _capacity ? 0 : static_cast<size_type>(_capacity - used);
+      }
+
+      // returns the free space, or 0 once closed
+      size_type _wait_for_space() noexcept requires (overflow == overflow_mode::block) {
+        for (;;) {
+          const uint64_t w = _writer._write.load(std::memory_order_relaxed);
+          size_type free = _free(w);
+          if (free != 0 || closed()) return closed() ? 0 : free;
+          const uint32_t epoch = _signal._space_epoch.load(std::memory_order_acquire);
+          _signal._producer_sleeping.store(true, std::memory_order_seq_cst);
+          if (_free(w) == 0 && !closed()) _signal._space_epoch.wait(epoch, std::memory_order_acquire);
+          _signal._producer_sleeping.store(false, std::memory_order_relaxed);
+        }
+      }
+
+      void _wake_producer() noexcept {
+        if constexpr (overflow == overflow_mode::block) {
+          _signal._space_epoch.fetch_add(1, std::memory_order_release);
+          _signal._space_epoch.notify_one();
+        }
+      }
+
+      utility::compressed_pair<allocator_type, pointer> _pair;
+      size_type _capacity;
+      size_type _max_readers;
+      std::unique_ptr<_cursor[]> _cursors;
+      _producer_state _writer;
+      _wait_state _signal;
+    };
+  } // namespace containers
+}
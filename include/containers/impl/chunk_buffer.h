@@ -1,114 +1,198 @@
 #pragma once
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <algorithm>
+#include <memory>
+#include <new>
 #include <stdexcept>
-#include <string>
-#include <windows.h>
-#include <iostream>
-#include <vector>
-#include <platform/VirtualAlloc.h>
+#include <platform/locked_memory.h>
 namespace voxory {
+  /**
+   * @brief Lossy single-producer / single-consumer ring of fixed-size float chunks.
+   *
+   * @details The producer never waits: when the consumer falls behind, the oldest chunks
+   *          are overwritten. Every slot carries a sequence number (seqlock): while chunk w is
+   *          being written the slot holds 2w+1, once published 2w+2. The consumer checks the
+   *          number before and after reading, so a chunk overwritten mid-read is detected and
+   *          counted as dropped instead of being returned torn.
+   *
+   *          Producer: acquire_write() -> fill the slot in place -> publish(), or push_chunk().
+   *          Consumer: begin_read() -> process in place -> end_read() tells whether the data
+   *          stayed intact; or pop_chunk() which copies out and retries on tearing.
+   *
+   * @note Chunk payloads are read while the producer may be writing them (seqlock); the
+   *       result is discarded in that case, which is why end_read() must be checked.
+   */
   class ChunkRing {
   public:
+    /// Consumer-side handle to one published chunk.
+    struct read_view {
+      const float* data = nullptr;
+      size_t count = 0;
+      uint64_t index = 0; // chunk number, monotonic
+      uint64_t seq = 0;   // slot sequence observed by begin_read()
+
+      explicit operator bool() const noexcept { return data != nullptr; }
+    };
+
     // capacity_slots must be >= 2; chunk_samples > 0
     ChunkRing(size_t capacity_slots, size_t chunk_samples)
       : slots(capacity_slots), chunk_sz(chunk_samples),
       total_samples(capacity_slots* chunk_samples),
       buffer(nullptr), is_buffer_locked(false)
     {
+      if (slots < 2 || chunk_sz == 0) {
+        throw std::invalid_argument("ChunkRing: need at least 2 slots and non-empty chunks");
+      }
       size_t bytes = total_samples * sizeof(float);
 
-      //     /
-      buffer = static_cast<float*>(VirtualAlloc(
-        nullptr, bytes,
-        MEM_RESERVE | MEM_COMMIT,
-        PAGE_READWRITE
-      ));
-
-      if (!buffer) {
+      // locked and prefaulted when the OS allows it; otherwise a plain mapping
+      platform::locked_region region = platform::allocate_locked(bytes);
+      if (!region.ptr) {
         throw std::bad_alloc();
       }
-
-      //    RAM,       
-      if (!TryVirtualLock(buffer, bytes, is_buffer_locked)) {
-        DWORD err = GetLastError();
-        VirtualFree(buffer, 0, MEM_RELEASE);
-        throw std::runtime_error("VirtualLock failed with code " + std::to_string(err));
-      }
+      buffer = static_cast<float*>(region.ptr);
+      is_buffer_locked = region.locked;
 
       std::fill_n(buffer, total_samples, 0.0f);
 
-      write_index.store(0, std::memory_order_relaxed);
-      read_index.store(0, std::memory_order_relaxed);
+      // chunk w lives in slot w % slots; 0 never matches a published chunk (>= 2)
+      sequences = std::make_unique<slot_seq[]>(slots);
+      for (size_t s = 0; s < slots; ++s) {
+        sequences[s].value.store(0, std::memory_order_relaxed);
+      }
+
+      write_index.value.store(0, std::memory_order_relaxed);
+      read_index.value.store(0, std::memory_order_relaxed);
+      dropped_chunks.value.store(0, std::memory_order_relaxed);
     }
 
+    ChunkRing(const ChunkRing&) = delete;
+    ChunkRing& operator=(const ChunkRing&) = delete;
+
     ~ChunkRing() {
       if (buffer) {
-        //   
-        if (is_buffer_locked)
-        {
-          VirtualUnlock(buffer, total_samples * sizeof(float));
-        }
-        VirtualFree(buffer, 0, MEM_RELEASE);
+        platform::free_locked(buffer, total_samples * sizeof(float));
         buffer = nullptr;
       }
     }
 
-    // Producer: write 'count' samples (count must == chunk_sz). returns false if stop flag set.
-    // We copy into the slot; (we could try to avoid even this memcpy if capture could write directly to slot)
-    bool push_chunk(const float* src, std::atomic<bool>& stop_flag) {
-      if (stop_flag.load(std::memory_order_relaxed)) return false;
-
-      // reserve a slot by incrementing write_index (we'll write into slot idx)
-      uint64_t w = write_index.load(std::memory_order_relaxed);
-      uint64_t r = read_index.load(std::memory_order_acquire); // ensure we see latest read
-
-      // detect overwrite: if write - read >= slots, advance read to keep distance < slots
-      if ((w - r) >= slots) {
-        // Drop oldest
-        uint64_t new_r = w - (slots - 1);
-        read_index.store(new_r, std::memory_order_release);
-        r = new_r;
+    // --- producer ---
+
+    /**
+     * @brief Claims the next slot for writing; the oldest chunk is overwritten if unread.
+     * @return Pointer to chunk_samples floats, valid until publish().
+     */
+    float* acquire_write() noexcept {
+      uint64_t w = write_index.value.load(std::memory_order_relaxed);
+      auto& seq = sequences[slot_of(w)].value;
+      seq.store(2 * w + 1, std::memory_order_relaxed);
+      // the odd sequence must be visible before any payload store
+      std::atomic_thread_fence(std::memory_order_release);
+      return buffer + slot_of(w) * chunk_sz;
+    }
+
+    /// Publishes the slot returned by the last acquire_write().
+    void publish() noexcept {
+      uint64_t w = write_index.value.load(std::memory_order_relaxed);
+      sequences[slot_of(w)].value.store(2 * w + 2, std::memory_order_release);
+      write_index.value.store(w + 1, std::memory_order_release);
+    }
+
+    /// Copies one chunk (chunk_samples floats) into the ring; never blocks.
+    void push_chunk(const float* src) noexcept {
+      std::memcpy(acquire_write(), src, chunk_sz * sizeof(float));
+      publish();
+    }
+
+    // --- consumer ---
+
+    /**
+     * @brief Returns the oldest chunk that has not been overwritten yet.
+     * @return Empty view if nothing is available. Skipped chunks are added to dropped().
+     */
+    read_view begin_read() noexcept {
+      uint64_t r = read_index.value.load(std::memory_order_relaxed);
+      for (;;) {
+        uint64_t head = write_index.value.load(std::memory_order_acquire);
+        if (r >= head) {
+          read_index.value.store(r, std::memory_order_relaxed);
+          return {};
+        }
+        // keep one slot between us and the producer, which may be writing chunk `head`
+        if (head - r >= slots) {
+          uint64_t oldest = head - (slots - 1);
+          dropped_chunks.value.fetch_add(oldest - r, std::memory_order_relaxed);
+          r = oldest;
+        }
+        uint64_t seq = sequences[slot_of(r)].value.load(std::memory_order_acquire);
+        if (seq == 2 * r + 2) {
+          read_index.value.store(r, std::memory_order_relaxed);
+          return { buffer + slot_of(r) * chunk_sz, chunk_sz, r, seq };
+        }
+        // the producer lapped us after we read head
+        dropped_chunks.value.fetch_add(1, std::memory_order_relaxed);
+        ++r;
       }
+    }
 
-      size_t slot = (size_t)(w % slots);
-      float* dst = buffer + slot * chunk_sz;
-      // copy chunk_sz floats into dst
-      std::memcpy(dst, src, chunk_sz * sizeof(float));
-      // publish the write by incrementing write_index (release so consumer sees data)
-      write_index.store(w + 1, std::memory_order_release);
+    /**
+     * @brief Releases a view from begin_read().
+     * @return True if the chunk was not touched by the producer while it was being read;
+     *         false means the data seen through the view must be discarded (counted as dropped).
+     */
+    bool end_read(const read_view& v) noexcept {
+      // order the payload loads before the sequence re-check
+      std::atomic_thread_fence(std::memory_order_acquire);
+      uint64_t seq = sequences[slot_of(v.index)].value.load(std::memory_order_relaxed);
+      read_index.value.store(v.index + 1, std::memory_order_relaxed);
+      if (seq != v.seq) {
+        dropped_chunks.value.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
       return true;
     }
 
-    // Consumer: if there is a chunk available, return pointer to chunk and advance read index.
-    // Returns nullptr if none available.
-    // The pointer is valid until that slot is overwritten by producer (i.e. until write_index advances enough).
-    const float* try_pop_chunk(size_t& out_count) {
-      uint64_t r = read_index.load(std::memory_order_relaxed);
-      uint64_t w = write_index.load(std::memory_order_acquire);
-      if (r >= w) {
-        out_count = 0;
-        return nullptr; // no data
+    /**
+     * @brief Copies the oldest intact chunk into dst (chunk_samples floats).
+     * @return False if no chunk is available.
+     */
+    bool pop_chunk(float* dst) noexcept {
+      for (;;) {
+        read_view v = begin_read();
+        if (!v) return false;
+        std::memcpy(dst, v.data, chunk_sz * sizeof(float));
+        if (end_read(v)) return true;
       }
-      size_t slot = (size_t)(r % slots);
-      const float* ptr = buffer + slot * chunk_sz;
-      out_count = chunk_sz;
-      // advance read index (release): consumer finished this chunk and claims it
-      read_index.store(r + 1, std::memory_order_release);
-      return ptr;
     }
 
     size_t get_chunk_samples() const { return chunk_sz; }
     size_t get_slots() const { return slots; }
+    bool is_locked() const { return is_buffer_locked; }
+
+    /// Chunks overwritten before the consumer could read them intact.
+    uint64_t dropped() const noexcept { return dropped_chunks.value.load(std::memory_order_relaxed); }
+    /// Chunks published so far.
+    uint64_t written() const noexcept { return write_index.value.load(std::memory_order_acquire); }
 
   private:
+    // producer and consumer counters live on separate cache lines
+    struct alignas(64) slot_seq {
+      std::atomic<uint64_t> value;
+    };
+
+    size_t slot_of(uint64_t chunk) const noexcept { return static_cast<size_t>(chunk % slots); }
+
     const size_t slots;
     const size_t chunk_sz;
     const size_t total_samples;
     float* buffer;
-    std::atomic<uint64_t> write_index; // monotonic increasing
-    std::atomic<uint64_t> read_index;  // monotonic increasing
+    std::unique_ptr<slot_seq[]> sequences;
+    slot_seq write_index;    // chunks published; written by the producer only
+    slot_seq read_index;     // next chunk to read; written by the consumer only
+    slot_seq dropped_chunks; // written by the consumer only
     bool is_buffer_locked;
   };
-}
\ No newline at end of file
+}
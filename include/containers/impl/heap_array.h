@@ -5,6 +5,8 @@
 #include <stdexcept>
 #include <containers/detail/containers_internal.h>
 #include <containers/containers_dbg.h>
+#include <memory/aligned_allocator.h>
+#include <memory/mapped_allocator.h>
 
 namespace voxory {
   namespace containers {
@@ -40,18 +42,29 @@ namespace voxory {
         using difference_type = std::ptrdiff_t;
         using iterator_category = std::random_access_iterator_tag;
 #ifdef DEBUG_ITERATORS
+        CONSTEXPR ConstHeapArrayIterator() noexcept : iterator_base(), _ptr(nullptr) {}
         CONSTEXPR ConstHeapArrayIterator(const container_base* container) noexcept : iterator_base(container), _ptr(nullptr) {}
         CONSTEXPR explicit ConstHeapArrayIterator(const container_base* container, pointer p) noexcept : iterator_base(container), _ptr(p) {}
-        ~ConstHeapArrayIterator() {
-          _release();
-        }
 #else
         CONSTEXPR ConstHeapArrayIterator() noexcept : _ptr(nullptr) {}
         CONSTEXPR explicit ConstHeapArrayIterator(pointer p) noexcept : _ptr(p) {}
 #endif // DEBUG_ITERATORS
+#ifdef DEBUG_ITERATORS
+        using iterator_base::_is_valid;
+#endif // DEBUG_ITERATORS
 
-        NODISCARD CONSTEXPR reference operator*() const noexcept { return *_ptr; }
-        NODISCARD CONSTEXPR pointer operator->() const noexcept { return _ptr; }
+        NODISCARD CONSTEXPR reference operator*() const noexcept {
+#ifdef DEBUG_ITERATORS
+          this->_verify();
+#endif // DEBUG_ITERATORS
+          return *_ptr;
+        }
+        NODISCARD CONSTEXPR pointer operator->() const noexcept {
+#ifdef DEBUG_ITERATORS
+          this->_verify();
+#endif // DEBUG_ITERATORS
+          return _ptr;
+        }
 
         CONSTEXPR ConstHeapArrayIterator& operator++() noexcept {
           ++_ptr;
@@ -94,17 +107,28 @@ namespace voxory {
         }
 
         CONSTEXPR difference_type operator-(const ConstHeapArrayIterator& other) const noexcept {
+#ifdef DEBUG_ITERATORS
+          this->_verify_compatible(other);
+#endif // DEBUG_ITERATORS
           return static_cast<difference_type>(_ptr - other._ptr);
         }
 
-        CONSTEXPR bool operator==(const ConstHeapArrayIterator& other) const noexcept { return _ptr == other._ptr; }
-        CONSTEXPR bool operator!=(const ConstHeapArrayIterator& other) const noexcept { return _ptr != other._ptr; }
+        CONSTEXPR bool operator==(const ConstHeapArrayIterator& other) const noexcept {
+#ifdef DEBUG_ITERATORS
+          this->_verify_compatible(other);
+#endif // DEBUG_ITERATORS
+          return _ptr == other._ptr;
+        }
+        CONSTEXPR bool operator!=(const ConstHeapArrayIterator& other) const noexcept { return !(*this == other); }
         CONSTEXPR bool operator<(const ConstHeapArrayIterator& other) const noexcept { return _ptr < other._ptr; }
         CONSTEXPR bool operator>(const ConstHeapArrayIterator& other) const noexcept { return _ptr > other._ptr; }
         CONSTEXPR bool operator<=(const ConstHeapArrayIterator& other) const noexcept { return _ptr <= other._ptr; }
         CONSTEXPR bool operator>=(const ConstHeapArrayIterator& other) const noexcept { return _ptr >= other._ptr; }
 
         NODISCARD CONSTEXPR reference operator[](difference_type off) const noexcept {
+#ifdef DEBUG_ITERATORS
+          this->_verify();
+#endif // DEBUG_ITERATORS
           return *(_ptr + off);
         }
 
@@ -121,9 +145,9 @@ namespace voxory {
         using difference_type = typename base_type::difference_type;
         using iterator_category = std::random_access_iterator_tag;
 #ifdef DEBUG_ITERATORS
+        CONSTEXPR HeapArrayIterator() noexcept : base_type() {}
         CONSTEXPR HeapArrayIterator(container_base* container) noexcept : base_type(container, nullptr) {}
         CONSTEXPR explicit HeapArrayIterator(container_base* container, pointer p) noexcept : base_type(container, p) {}
-        ~HeapArrayIterator() = default;
 #else
         CONSTEXPR HeapArrayIterator() noexcept : base_type(nullptr) {}
         CONSTEXPR explicit HeapArrayIterator(pointer p) noexcept : base_type(p) {}
@@ -134,7 +158,7 @@ namespace voxory {
           return const_cast<reference>(base_type::operator*());
         }
         NODISCARD CONSTEXPR pointer operator->() const noexcept {
-          return const_cast<pointer>(this->_ptr);
+          return const_cast<pointer>(base_type::operator->());
         }
 
         CONSTEXPR HeapArrayIterator& operator++() noexcept {
@@ -191,10 +215,7 @@ namespace voxory {
     }
 
     template<typename T, typename Alloc = std::allocator<T>>
-    class heap_array
-#ifdef DEBUG_ITERATORS
-      : container_base
-#endif // DEBUG
+    class heap_array : container_base
     {
       using FirstOneSecondArgs = utility::detail::FirstOneSecondArgs;
       using FirstZeroSecondArgs = utility::detail::FirstZeroSecondArgs;
@@ -231,6 +252,19 @@ namespace voxory {
         _construct_range(count);
       };
 
+      /// count default-initialized elements: trivial types are left unwritten (no zero-fill).
+      heap_array(size_t count, default_init_t, const allocator_type& alloc = allocator_type())
+        : _pair(FirstOneSecondArgs{}, alloc), _capacity(count)
+      {
+        if (count != 0) {
+          _allocate_buffer(count);
+          auto& data = _pair._second;
+          cleanup_guard guard(this);
+          data._last = internal::uninitialized_default_init_n(data._first, count, get_allocator());
+          guard.release();
+        }
+      };
+
       heap_array(const heap_array& o) noexcept(std::is_nothrow_constructible_v<allocator_type, decltype(std::allocator_traits<allocator_type>::select_on_container_copy_construction(std::declval<allocator_type&>()))>) :
         _pair(FirstOneSecondArgs{}, allocator_traits::select_on_container_copy_construction(o._pair.first())), _capacity(o._capacity) {
         _construct_range(o._capacity, o._pair._second._first, o._pair._second._last);
@@ -347,6 +381,14 @@ namespace voxory {
         _resize_buffer(size);
       };
 
+      /**
+       * @brief Like resize(), but new elements are default-initialized: for trivial types their
+       *        memory is not written at all. Meant for buffers that are filled right after.
+       */
+      CONSTEXPR void resize_for_overwrite(size_type size) noexcept(noexcept(_resize_buffer<true>(std::declval<size_type>()))) {
+        _resize_buffer<true>(size);
+      };
+
       CONSTEXPR void reserve(size_t size) noexcept(noexcept(_reallocate(std::declval<size_type>()))) {
         if (size > _capacity)
         {
@@ -401,20 +443,35 @@ namespace voxory {
       }
 
     private:
-      CONSTEXPR inline heap_array& _steal_no_cleanup(heap_array& o) noexcept(
-#ifdef DEBUG_ITERATORS
-        noexcept(_move_proxies(std::declval<heap_array&>())) &&
-#endif // DEBUG_ITERATORS
-        true) {
+      CONSTEXPR inline heap_array& _steal_no_cleanup(heap_array& o) noexcept {
         _pair._second = std::move(o._pair._second);
         _capacity = std::exchange(o._capacity, 0);
-#ifdef DEBUG_ITERATORS
-        _move_proxies(o);
-#endif // DEBUG_ITERATORS
+        o._invalidate_iterators();
         return *this;
         };
 
+      // resizes the block through Alloc::reallocate() (mremap, committing reserved pages) when
+      // the elements may move bytewise; false if a new block and a copy are needed
+      CONSTEXPR bool _reallocate_in_place(size_type new_capacity) noexcept {
+        if constexpr (type_traits::has_reallocate_v<allocator_type, pointer, size_type> && internal::is_memcpy_relocatable_v<allocator_type>) {
+          auto& data = _pair._second;
+          if (data._first == nullptr) return false;
+          size_type size = static_cast<size_type>(data._last - data._first);
+          pointer p = get_allocator().reallocate(data._first, _capacity, new_capacity);
+          if (p == nullptr) return false;
+          data._first = p;
+          data._last = p + size;
+          _capacity = new_capacity;
+          _invalidate_iterators();
+          return true;
+        }
+        else {
+          return false;
+        }
+      };
+
       CONSTEXPR void _reallocate(size_type new_capacity) {
+        if (_reallocate_in_place(new_capacity)) return;
         auto& data = _pair._second;
         auto& alloc = get_allocator();
         auto& first = data._first;
@@ -425,18 +482,13 @@ namespace voxory {
         internal::realloc_guard<allocator_type> guard(alloc, new_data, new_capacity);
         if (first != nullptr)
         {
-          //guard, if exception occurs during move: destroy new_data, leave old intact
-          if constexpr (noexcept(internal::uninitialized_move(std::declval<pointer>(), std::declval<pointer>(), std::declval<pointer>(), std::declval<allocator_type&>())))
-          {
-            new_last = internal::uninitialized_move(first, last, new_data, alloc);
-          }
-          else
-          {
-            new_last = internal::uninitialized_copy(first, last, new_data, alloc);
-          }
+          //guard, if a copy throws: destroy new_data, leave old intact
+          new_last = internal::uninitialized_relocate(first, last, new_data, alloc);
         }
         guard.release();
 
+        // the old elements were relocated: only release their memory
+        last = first;
         _cleanup();
 
         first = new_data;
@@ -444,32 +496,56 @@ namespace voxory {
         _capacity = new_capacity;
       };
 
+      template<bool DefaultInit = false>
       CONSTEXPR void _resize_reallocate(size_type new_capacity) {
         auto& data = _pair._second;
         auto& alloc = get_allocator();
         auto& first = data._first;
         auto& last = data._last;
 
+        if (_reallocate_in_place(new_capacity)) {
+          size_type to_construct = new_capacity - static_cast<size_type>(last - first);
+          if constexpr (DefaultInit) {
+            last = internal::uninitialized_default_init_n(last, to_construct, alloc);
+          }
+          else {
+            last = internal::uninitialized_default_construct_n(last, to_construct, alloc);
+          }
+          return;
+        }
+
         pointer new_data = alloc.allocate(new_capacity);
-        pointer new_last = new_data;
         internal::realloc_guard<allocator_type> guard(alloc, new_data, new_capacity);
+        // construct the new tail first: once the old elements are relocated nothing may throw
+        size_type old_size = static_cast<size_type>(last - first);
+        size_type to_construct = new_capacity > old_size ? (new_capacity - old_size) : 0;
+        pointer tail = new_data + old_size;
+        pointer new_last;
+        if constexpr (DefaultInit) {
+          new_last = internal::uninitialized_default_init_n(tail, to_construct, alloc);
+        }
+        else {
+          new_last = internal::uninitialized_default_construct_n(tail, to_construct, alloc);
+        }
         if (first != nullptr)
         {
-          //guard, if exception occurs during move: destroy new_data, leave old intact
-          if constexpr (noexcept(internal::uninitialized_move(std::declval<pointer>(), std::declval<pointer>(), std::declval<pointer>(), std::declval<allocator_type&>())))
-          {
-            new_last = internal::uninitialized_move(first, last, new_data, alloc);
+          if constexpr (noexcept(internal::uninitialized_relocate(first, last, new_data, alloc))) {
+            (void)internal::uninitialized_relocate(first, last, new_data, alloc);
           }
-          else
-          {
-            new_last = internal::uninitialized_copy(first, last, new_data, alloc);
+          else {
+            try {
+              (void)internal::uninitialized_relocate(first, last, new_data, alloc);
+            }
+            catch (...) {
+              _destroy_range(tail, new_last);
+              throw;
+            }
           }
         }
-        size_type old_size = static_cast<size_type>(last - first);
-        size_type to_construct = new_capacity > old_size ? (new_capacity - old_size) : 0;
-        new_last = internal::uninitialized_default_construct_n(new_last, to_construct, alloc);
         guard.release();
 
+        // the old elements were relocated: only release their memory
+        last = first;
         _cleanup();
 
         first = new_data;
@@ -477,6 +553,7 @@ namespace voxory {
         _capacity = new_capacity;
       };
 
+      template<bool DefaultInit = false>
       CONSTEXPR void _resize_buffer(size_type new_size) {
         size_type old_size = size();
         if (new_size == old_size) return;
@@ -488,7 +565,7 @@ namespace voxory {
 
 
         if (new_size > _capacity) {
-          _resize_reallocate(new_size);
+          _resize_reallocate<DefaultInit>(new_size);
           return;
         }
         if (new_size < old_size) {
@@ -496,17 +573,18 @@ namespace voxory {
           pointer new_last = last - to_destroy;
           _destroy_range(new_last, last);
           last = new_last;
-#ifdef DEBUG_ITERATORS
-          _invalidate_range(first, last);
-#endif // DEBUG_ITERATORS
+          _invalidate_iterators();
         }
         else if (new_size > old_size) {
           size_type to_construct = new_size - old_size;
           pointer new_last = last + to_construct;
-          last = internal::uninitialized_default_construct(last, new_last, alloc);
-#ifdef DEBUG_ITERATORS
-          _invalidate_range(first, last);
-#endif // DEBUG_ITERATORS
+          if constexpr (DefaultInit) {
+            last = internal::uninitialized_default_init_n(last, to_construct, alloc);
+          }
+          else {
+            last = internal::uninitialized_default_construct(last, new_last, alloc);
+          }
+          _invalidate_iterators();
         }
         return;
       };
@@ -544,9 +622,7 @@ namespace voxory {
         auto& data = _pair._second;
         auto& first = data._first;
         auto& last = data._last;
-#ifdef DEBUG_ITERATORS
-       _release_proxy();
-#endif // DEBUG_ITERATORS
+        _invalidate_iterators();
         if (first != nullptr)
         {
           _destroy_range(first, last);
@@ -665,9 +741,7 @@ namespace voxory {
             mid = internal::uninitialized_move_n(o_first + common, rest, mid, alloc);
             last = mid;
           }
-#ifdef DEBUG_ITERATORS
-          _invalidate_range(first, last);
-#endif // DEBUG_ITERATORS
+          _invalidate_iterators();
           return;
         }
         // copy/move-_assign within existing buffer, destroy rest
@@ -685,31 +759,12 @@ namespace voxory {
             _destroy_range(mid, mid + rest);
             last = mid;
           }
-#ifdef DEBUG_ITERATORS
           if (rest != 0) {
-            _invalidate_range(first, last);
+            _invalidate_iterators();
           }
-#endif // DEBUG_ITERATORS
           return;
         }
       }
-#ifdef DEBUG_ITERATORS
-      CONSTEXPR void _invalidate_range(pointer first, pointer last) noexcept {
-        _lock();
-        list::node_type* current = _list.data();
-        while (current != nullptr)
-        {
-          list::node_type* next = current->_next;
-          if (reinterpret_cast<const_iterator*>(current->_data)->_ptr < first || reinterpret_cast<const_iterator*>(current->_data)->_ptr > last)
-          {
-            current->_data->_proxy = nullptr;
-            _list.pop_at(current);
-          }
-          current = next;
-        }
-        _unlock();
-      }
-#endif // DEBUG_ITERATORS
     protected:
       struct _storage {
         _storage(pointer first, pointer last) : _first(first), _last(last) {};
@@ -736,5 +791,21 @@ namespace voxory {
       utility::compressed_pair<allocator_type, _storage> _pair;
       size_type _capacity;
     };
+
+    /// heap_array whose storage starts on an Alignment boundary (64 B: cache line / AVX-512 vector).
+    template<typename T, std::size_t Alignment = 64>
+    using aligned_heap_array = heap_array<T, memory::aligned_allocator<T, Alignment>>;
+
+    /// heap_array whose large (>= 1 MiB) buffers are page mappings that grow without copying.
+    template<typename T>
+    using mapped_heap_array = heap_array<T, memory::mapped_allocator<T>>;
   }
+}
+
+namespace type_traits {
+#ifndef DEBUG_ITERATORS
+  // checked iterators hold the container's address, so only release builds may relocate it
+  template<typename T, typename Alloc>
+  struct is_trivially_relocatable<voxory::containers::heap_array<T, Alloc>> : is_trivially_relocatable<Alloc> {};
+#endif // DEBUG_ITERATORS
 }
\ No newline at end of file
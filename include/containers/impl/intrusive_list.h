@@ -0,0 +1,273 @@
+#pragma once
+#define NOMINMAX
+#include <iterator>
+#include <utility>
+#include <cstddef>
+#include <type_traits>
+#include <platform/platform.h>
+
+namespace voxory {
+  namespace containers {
+    namespace detail {
+      template<typename T, typename Tag, bool IsConst>
+      class IntrusiveListIterator;
+    }
+
+    /**
+     * @brief Link node embedded in the element of an intrusive_list.
+     *
+     * @details An element derives from intrusive_list_hook<Tag> once per list it can be in;
+     *          Tag tells the hooks apart. Copying an element never copies its links.
+     *          A linked hook can be unlinked in O(1) without knowing its list.
+     */
+    template<typename Tag = void>
+    class intrusive_list_hook {
+    public:
+      CONSTEXPR intrusive_list_hook() noexcept : _next(nullptr), _prev(nullptr) {}
+      CONSTEXPR intrusive_list_hook(const intrusive_list_hook&) noexcept : intrusive_list_hook() {}
+      CONSTEXPR intrusive_list_hook& operator=(const intrusive_list_hook&) noexcept { return *this; }
+      ~intrusive_list_hook() {
+#ifdef DEBUG
+        ASSERT_ABORT(!is_linked(), "intrusive_list_hook destroyed while still linked");
+#endif // DEBUG
+      }
+
+      NODISCARD CONSTEXPR bool is_linked() const noexcept { return _next != nullptr; }
+
+      /// Removes the element from whatever list it is in; no-op if not linked.
+      CONSTEXPR void unlink() noexcept {
+        if (!is_linked()) return;
+        _prev->_next = _next;
+        _next->_prev = _prev;
+        _next = nullptr;
+        _prev = nullptr;
+      }
+
+    protected:
+      template<typename, typename> friend class intrusive_list;
+      template<typename, typename, bool> friend class detail::IntrusiveListIterator;
+
+      CONSTEXPR void _link_before(intrusive_list_hook* pos) noexcept {
+        _next = pos;
+        _prev = pos->_prev;
+        pos->_prev->_next = this;
+        pos->_prev = this;
+      }
+
+      intrusive_list_hook* _next;
+      intrusive_list_hook* _prev;
+    };
+
+    namespace detail {
+      template<typename T, typename Tag, bool IsConst>
+      class IntrusiveListIterator {
+        using hook_type = std::conditional_t<IsConst, const intrusive_list_hook<Tag>, intrusive_list_hook<Tag>>;
+      public:
+        using value_type = T;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        CONSTEXPR IntrusiveListIterator() noexcept : _ptr(nullptr) {}
+        CONSTEXPR explicit IntrusiveListIterator(hook_type* ptr) noexcept : _ptr(ptr) {}
+        // iterator -> const_iterator
+        template<bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        CONSTEXPR IntrusiveListIterator(const IntrusiveListIterator<T, Tag, OtherConst>& o) noexcept : _ptr(o.unwrap()) {}
+
+        NODISCARD CONSTEXPR reference operator*() const noexcept { return *operator->(); }
+        NODISCARD CONSTEXPR pointer operator->() const noexcept {
+#ifdef DEBUG_ITERATORS
+          ASSERT_ABORT(_ptr != nullptr, "");
+#endif // DEBUG_ITERATORS
+          return static_cast<pointer>(_ptr);
+        }
+
+        CONSTEXPR IntrusiveListIterator& operator++() noexcept { _ptr = _ptr->_next; return *this; }
+        CONSTEXPR IntrusiveListIterator operator++(int) noexcept { IntrusiveListIterator tmp = *this; ++(*this); return tmp; }
+        CONSTEXPR IntrusiveListIterator& operator--() noexcept { _ptr = _ptr->_prev; return *this; }
+        CONSTEXPR IntrusiveListIterator operator--(int) noexcept { IntrusiveListIterator tmp = *this; --(*this); return tmp; }
+
+        CONSTEXPR bool operator==(const IntrusiveListIterator& other) const noexcept { return _ptr == other._ptr; }
+        CONSTEXPR bool operator!=(const IntrusiveListIterator& other) const noexcept { return _ptr != other._ptr; }
+
+        NODISCARD CONSTEXPR hook_type* unwrap() const noexcept { return _ptr; }
+
+      private:
+        hook_type* _ptr;
+      };
+    }
+
+    /**
+     * @brief Circular doubly linked list over hooks embedded in the elements.
+     *
+     * @details The list never allocates and never owns its elements: push/insert link an
+     *          existing object, erase/pop only unlink it. Insert and unlink are O(1).
+     *          The element count is not tracked (hooks unlink themselves without the list),
+     *          so size() is O(n) and empty() is O(1).
+     *
+     * @note An element must outlive its membership; unlink it before destroying it.
+     *
+     * @tparam T   Element type; must derive from intrusive_list_hook<Tag>.
+     * @tparam Tag Selects the hook when T is in several lists.
+     */
+    template<typename T, typename Tag = void>
+    class intrusive_list {
+    public:
+      using hook_type = intrusive_list_hook<Tag>;
+      using value_type = T;
+      using pointer = T*;
+      using const_pointer = const T*;
+      using reference = T&;
+      using const_reference = const T&;
+      using iterator = detail::IntrusiveListIterator<T, Tag, false>;
+      using const_iterator = detail::IntrusiveListIterator<T, Tag, true>;
+      using size_type = std::size_t;
+      using difference_type = std::ptrdiff_t;
+
+      intrusive_list() noexcept { _reset_root(); }
+      intrusive_list(const intrusive_list&) = delete;
+      intrusive_list& operator=(const intrusive_list&) = delete;
+
+      intrusive_list(intrusive_list&& o) noexcept {
+        _reset_root();
+        _take(o);
+      }
+
+      intrusive_list& operator=(intrusive_list&& o) noexcept {
+        if (this == std::addressof(o)) return *this;
+        clear();
+        _take(o);
+        return *this;
+      }
+
+      ~intrusive_list() { clear(); }
+
+      // --- iterators ---
+      NODISCARD CONSTEXPR iterator begin() noexcept { return iterator(_root._next); }
+      NODISCARD CONSTEXPR const_iterator begin() const noexcept { return const_iterator(_root._next); }
+      NODISCARD CONSTEXPR const_iterator cbegin() const noexcept { return begin(); }
+      NODISCARD CONSTEXPR iterator end() noexcept { return iterator(&_root); }
+      NODISCARD CONSTEXPR const_iterator end() const noexcept { return const_iterator(&_root); }
+      NODISCARD CONSTEXPR const_iterator cend() const noexcept { return end(); }
+
+      /// Iterator to an element known to be in this list; O(1).
+      NODISCARD CONSTEXPR iterator iterator_to(reference v) noexcept { return iterator(static_cast<hook_type*>(&v)); }
+      NODISCARD CONSTEXPR const_iterator iterator_to(const_reference v) const noexcept { return const_iterator(static_cast<const hook_type*>(&v)); }
+
+      // --- capacity ---
+      NODISCARD CONSTEXPR bool empty() const noexcept { return _root._next == &_root; }
+
+      /// O(n): the count is not stored.
+      NODISCARD CONSTEXPR size_type size() const noexcept {
+        return static_cast<size_type>(std::distance(begin(), end()));
+      }
+
+      // --- access ---
+      NODISCARD CONSTEXPR reference front() noexcept { return *begin(); }
+      NODISCARD CONSTEXPR const_reference front() const noexcept { return *begin(); }
+      NODISCARD CONSTEXPR reference back() noexcept { return *iterator(_root._prev); }
+      NODISCARD CONSTEXPR const_reference back() const noexcept { return *const_iterator(_root._prev); }
+
+      // --- modifiers (never allocate) ---
+      CONSTEXPR void push_back(reference v) noexcept { insert(end(), v); }
+      CONSTEXPR void push_front(reference v) noexcept { insert(begin(), v); }
+      CONSTEXPR void pop_back() noexcept { _hook(back()).unlink(); }
+      CONSTEXPR void pop_front() noexcept { _hook(front()).unlink(); }
+
+      /**
+       * @brief Links v before pos.
+       * @note v must not be linked into a list with the same Tag.
+       */
+      CONSTEXPR iterator insert(const_iterator pos, reference v) noexcept {
+        hook_type& h = _hook(v);
+#ifdef DEBUG
+        ASSERT_ABORT(!h.is_linked(), "element is already linked");
+#endif // DEBUG
+        h._link_before(const_cast<hook_type*>(pos.unwrap()));
+        return iterator(&h);
+      }
+
+      /// Unlinks the element at pos; returns the iterator following it.
+      CONSTEXPR iterator erase(const_iterator pos) noexcept {
+        hook_type* h = const_cast<hook_type*>(pos.unwrap());
+        hook_type* next = h->_next;
+        h->unlink();
+        return iterator(next);
+      }
+
+      /// Unlinks v, which must be in this list.
+      CONSTEXPR void erase(reference v) noexcept { _hook(v).unlink(); }
+
+      /// Moves v to the front (LRU touch); v may be in this list or unlinked.
+      CONSTEXPR void move_to_front(reference v) noexcept {
+        _hook(v).unlink();
+        push_front(v);
+      }
+
+      /// Unlinks every element; O(n).
+      CONSTEXPR void clear() noexcept {
+        hook_type* h = _root._next;
+        while (h != &_root) {
+          hook_type* next = h->_next;
+          h->_next = nullptr;
+          h->_prev = nullptr;
+          h = next;
+        }
+        _reset_root();
+      }
+
+      /// Calls fn(element) for each element and unlinks the ones for which it returns true.
+      template<typename Pred>
+      CONSTEXPR size_type remove_if(Pred&& fn) {
+        size_type removed = 0;
+        for (iterator it = begin(); it != end();) {
+          if (fn(*it)) {
+            it = erase(it);
+            ++removed;
+          }
+          else {
+            ++it;
+          }
+        }
+        return removed;
+      }
+
+      CONSTEXPR void swap(intrusive_list& o) noexcept {
+        intrusive_list tmp(std::move(o));
+        o._take(*this);
+        _take(tmp);
+      }
+
+    private:
+      // checked here rather than at class scope so the list can be a member of T's container while T is incomplete
+      static CONSTEXPR hook_type& _hook(reference v) noexcept {
+        static_assert(std::is_base_of_v<hook_type, T>, "T must derive from intrusive_list_hook<Tag>");
+        return static_cast<hook_type&>(v);
+      }
+
+      CONSTEXPR void _reset_root() noexcept {
+        _root._next = &_root;
+        _root._prev = &_root;
+      }
+
+      // this must be empty
+      CONSTEXPR void _take(intrusive_list& o) noexcept {
+        if (o.empty()) return;
+        _root._next = o._root._next;
+        _root._prev = o._root._prev;
+        _root._next->_prev = &_root;
+        _root._prev->_next = &_root;
+        o._reset_root();
+      }
+
+      struct _root_hook : hook_type {
+        ~_root_hook() { this->_next = nullptr; }
+        using hook_type::_next;
+        using hook_type::_prev;
+      };
+
+      _root_hook _root;
+    };
+  }
+}
@@ -0,0 +1,331 @@
+#pragma once
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <containers/detail/containers_internal.h>
+#include <utility.h>
+#include <platform/platform.h>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace voxory {
+  namespace containers {
+    /**
+     * @brief Bounded lock-free multi-producer, multi-consumer queue.
+     *
+     * @details Dmitry Vyukov's bounded MPMC design: every slot carries a sequence number that
+     *          says whose turn it is. A producer at position pos may fill slot pos & mask once its
+     *          sequence equals pos and publishes it as pos + 1; a consumer takes it at pos + 1
+     *          and hands it to the next lap as pos + capacity(). Producers and consumers only
+     *          share a cache line when they touch the same slot, and each operation is one CAS
+     *          on the enqueue or dequeue position.
+     *
+     *          Bulk operations claim a run of consecutive ready slots with a single CAS, so a
+     *          batch of k elements costs one contended RMW instead of k.
+     *
+     *          push() / pop() block: they spin briefly, then sleep with std::atomic::wait.
+     *          The try_ variants never block. Producers only pay for a wake-up when a thread
+     *          announced that it sleeps. close() releases all blocked threads.
+     *
+     * @tparam T     Element type; moves and destruction must not throw.
+     * @tparam Alloc Allocator for the elements, rebound to allocate the slot array.
+     */
+    template<typename T, typename Alloc = std::allocator<T>>
+    class mpmc_queue {
+      using FirstOneSecondArgs = utility::detail::FirstOneSecondArgs;
+      static_assert(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>,
+                    "mpmc_queue requires nothrow move construction and destruction");
+
+      struct _slot {
+        std::atomic<std::size_t> _seq;
+        alignas(T) unsigned char _bytes[sizeof(T)];
+
+        FORCE_INLINE T* _elem() noexcept { return std::launder(reinterpret_cast<T*>(_bytes)); }
+      };
+    public:
+      using allocator_type = Alloc;
+      using allocator_traits = std::allocator_traits<Alloc>;
+      using slot_allocator = typename allocator_traits::template rebind_alloc<_slot>;
+      using slot_traits = std::allocator_traits<slot_allocator>;
+      using value_type = T;
+      using size_type = std::size_t;
+
+      static constexpr uint32_t spin_rounds = 64;
+
+      /// @param capacity Maximum number of queued elements, rounded up to a power of two (at least 2).
+      explicit mpmc_queue(size_type capacity, const allocator_type& alloc = allocator_type())
+        : _pair(FirstOneSecondArgs{}, alloc, nullptr),
+          _capacity(std::bit_ceil(std::max<size_type>(capacity, 2))) {
+        slot_allocator slot_alloc(_pair.first());
+        _slot* slots = std::to_address(slot_traits::allocate(slot_alloc, _capacity));
+        for (size_type i = 0; i < _capacity; ++i) {
+          ::new (static_cast<void*>(slots + i)) _slot;
+          slots[i]._seq.store(i, std::memory_order_relaxed);
+        }
+        _pair._second = slots;
+      }
+
+      mpmc_queue(const mpmc_queue&) = delete;
+      mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+      /// Destroys the elements still queued; no other thread may use the queue any more.
+      ~mpmc_queue() {
+        _slot* slots = _pair._second;
+        const size_type last = _enqueue._pos.load(std::memory_order_acquire);
+        for (size_type pos = _dequeue._pos.load(std::memory_order_acquire); pos != last; ++pos) {
+          _slot& s = slots[pos & (_capacity - 1)];
+          if (s._seq.load(std::memory_order_acquire) == pos + 1) allocator_traits::destroy(_pair.first(), s._elem());
+        }
+        for (size_type i = 0; i < _capacity; ++i) slots[i].~_slot();
+        slot_allocator slot_alloc(_pair.first());
+        slot_traits::deallocate(slot_alloc, slots, _capacity);
+      }
+
+      // --- non-blocking ---
+
+      /// Constructs an element in place; false if the queue is full.
+      template<typename... Args>
+      bool try_emplace(Args&&... args) {
+        if constexpr (!std::is_nothrow_constructible_v<T, Args...>) {
+          // a claimed slot cannot be given back, so build the element before claiming one
+          return try_emplace(T(std::forward<Args>(args)...));
+        }
+        else {
+          auto [pos, n] = _claim(_enqueue._pos, 0, 1);
+          if (n == 0) return false;
+          _slot& s = _slot_at(pos);
+          allocator_traits::construct(_pair.first(), reinterpret_cast<T*>(s._bytes), std::forward<Args>(args)...);
+          s._seq.store(pos + 1, std::memory_order_release);
+          _notify(_signal._item_epoch, _signal._sleeping_consumers, 1);
+          return true;
+        }
+      }
+
+      bool try_push(const T& value) { return try_emplace(value); }
+      bool try_push(T&& value) noexcept { return try_emplace(std::move(value)); }
+
+      /// Moves the oldest element into out; false if the queue is empty.
+      bool try_pop(T& out) noexcept(std::is_nothrow_move_assignable_v<T>) {
+        return try_pop_bulk(&out, 1) == 1;
+      }
+
+      std::optional<T> try_pop() noexcept {
+        auto [pos, n] = _claim(_dequeue._pos, 1, 1);
+        if (n == 0) return std::nullopt;
+        std::optional<T> out(std::in_place, _take(pos));
+        _notify(_signal._space_epoch, _signal._sleeping_producers, 1);
+        return out;
+      }
+
+      /**
+       * @brief Copies up to n elements from first with one CAS.
+       * @return Number of elements enqueued (a prefix of the input); 0 if the queue is full.
+       */
+      template<typename InputIt>
+      size_type try_push_bulk(InputIt first, size_type n) {
+        if (n == 0) return 0;
+        if constexpr (!std::is_nothrow_constructible_v<T, decltype(*first)>) {
+          // claimed slots cannot be given back, so build the batch before claiming them; a
+          // throwing copy then leaves the queue untouched. Only copy what currently fits, so a
+          // push_bulk retry on a nearly full queue does not recopy capacity() elements per slot.
+          const size_type k = std::min(n, std::max<size_type>(_capacity - size_approx(), 1));
+          std::vector<T, allocator_type> batch(_pair.first());
+          batch.reserve(k);
+          for (size_type i = 0; i < k; ++i, ++first) batch.push_back(*first);
+          return try_push_bulk(std::make_move_iterator(batch.begin()), batch.size());
+        }
+        else {
+          auto [pos, count] = _claim(_enqueue._pos, 0, n);
+          if (count == 0) return 0;
+          for (size_type i = 0; i < count; ++i, ++first) {
+            _slot& s = _slot_at(pos + i);
+            allocator_traits::construct(_pair.first(), reinterpret_cast<T*>(s._bytes), *first);
+            s._seq.store(pos + i + 1, std::memory_order_release);
+          }
+          _notify(_signal._item_epoch, _signal._sleeping_consumers, count);
+          return count;
+        }
+      }
+
+      /**
+       * @brief Moves up to max of the oldest elements to out with one CAS.
+       * @return Number of elements dequeued; 0 if the queue is empty.
+       */
+      template<typename OutputIt>
+      size_type try_pop_bulk(OutputIt out, size_type max) noexcept(std::is_nothrow_move_assignable_v<T>) {
+        if (max == 0) return 0;
+        auto [pos, count] = _claim(_dequeue._pos, 1, max);
+        for (size_type i = 0; i < count; ++i, ++out) *out = _take(pos + i);
+        if (count != 0) _notify(_signal._space_epoch, _signal._sleeping_producers, count);
+        return count;
+      }
+
+      // --- blocking ---
+
+      /// Waits for a free slot; false if the queue was closed.
+      bool push(const T& value) { return _push_wait([&] { return try_push(value); }); }
+      bool push(T&& value) { return _push_wait([&] { return try_push(std::move(value)); }); }
+
+      /// Waits for an element; nullopt once the queue is closed and drained.
+      std::optional<T> pop() noexcept {
+        for (;;) {
+          if (std::optional<T> v = try_pop()) return v;
+          if (closed()) return try_pop();
+          _wait(_signal._item_epoch, _signal._sleeping_consumers, [this] { return size_approx() != 0 || closed(); });
+        }
+      }
+
+      /**
+       * @brief Enqueues all n elements, waiting for room as needed.
+       * @return Elements enqueued; less than n only if the queue was closed.
+       */
+      template<typename InputIt>
+      size_type push_bulk(InputIt first, size_type n) {
+        size_type done = 0;
+        while (done < n && !closed()) {
+          const size_type k = try_push_bulk(first, n - done);
+          std::advance(first, k);
+          done += k;
+          if (done < n && k == 0) {
+            _wait(_signal._space_epoch, _signal._sleeping_producers, [this] { return size_approx() < _capacity || closed(); });
+          }
+        }
+        return done;
+      }
+
+      /**
+       * @brief Waits until at least one element is queued, then dequeues up to max.
+       * @return Elements dequeued; 0 only once the queue is closed and drained.
+       */
+      template<typename OutputIt>
+      size_type pop_bulk(OutputIt out, size_type max) noexcept(std::is_nothrow_move_assignable_v<T>) {
+        if (max == 0) return 0;
+        for (;;) {
+          if (size_type k = try_pop_bulk(out, max)) return k;
+          if (closed()) return try_pop_bulk(out, max);
+          _wait(_signal._item_epoch, _signal._sleeping_consumers, [this] { return size_approx() != 0 || closed(); });
+        }
+      }
+
+      /// Fails further blocking pushes and lets blocked pops drain what is left.
+      void close() noexcept {
+        _signal._closed.store(true, std::memory_order_seq_cst);
+        _signal._item_epoch.fetch_add(1, std::memory_order_release);
+        _signal._item_epoch.notify_all();
+        _signal._space_epoch.fetch_add(1, std::memory_order_release);
+        _signal._space_epoch.notify_all();
+      }
+
+      NODISCARD bool closed() const noexcept { return _signal._closed.load(std::memory_order_acquire); }
+
+      // --- diagnostics ---
+
+      /// Claimed minus consumed positions; exact only while the queue is quiescent.
+      NODISCARD size_type size_approx() const noexcept {
+        const size_type head = _dequeue._pos.load(std::memory_order_acquire);
+        const size_type tail = _enqueue._pos.load(std::memory_order_acquire);
+        return tail > head ? std::min(tail - head, _capacity) : 0;
+      }
+
+      NODISCARD CONSTEXPR size_type capacity() const noexcept { return _capacity; }
+      NODISCARD allocator_type get_allocator() const noexcept { return _pair.first(); }
+
+    private:
+      struct alignas(64) _position {
+        std::atomic<size_type> _pos{ 0 };
+      };
+
+      struct alignas(64) _wait_state {
+        std::atomic<uint32_t> _item_epoch{ 0 };
+        std::atomic<uint32_t> _space_epoch{ 0 };
+        std::atomic<uint32_t> _sleeping_consumers{ 0 };
+        std::atomic<uint32_t> _sleeping_producers{ 0 };
+        std::atomic<bool> _closed{ false };
+      };
+
+      FORCE_INLINE _slot& _slot_at(size_type pos) const noexcept { return _pair._second[pos & (_capacity - 1)]; }
+
+      /**
+       * @brief Claims up to n consecutive positions at cursor whose slots read pos + offset.
+       * @details offset 0 claims empty slots (producers), 1 claims filled ones (consumers).
+       * @return The first claimed position and the number claimed (0: full / empty).
+       */
+      std::pair<size_type, size_type> _claim(std::atomic<size_type>& cursor, size_type offset, size_type n) noexcept {
+        size_type pos = cursor.load(std::memory_order_relaxed);
+        for (;;) {
+          size_type k = 0;
+          for (; k < n; ++k) {
+            const size_type seq = _slot_at(pos + k)._seq.load(std::memory_order_acquire);
+            if (seq != pos + k + offset) break;
+          }
+          if (k == 0) {
+            const size_type seq = _slot_at(pos)._seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq - (pos + offset));
+            if (diff < 0) return { pos, 0 };           // full (producer) or empty (consumer)
+            if (diff == 0) continue;                   // became ready in between
+            pos = cursor.load(std::memory_order_relaxed); // another thread took pos
+            continue;
+          }
+          if (cursor.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed, std::memory_order_relaxed)) {
+            return { pos, k };
+          }
+        }
+      }
+
+      // moves the element out of a claimed filled slot and hands the slot to the next lap
+      FORCE_INLINE T _take(size_type pos) noexcept {
+        _slot& s = _slot_at(pos);
+        T value(std::move(*s._elem()));
+        allocator_traits::destroy(_pair.first(), s._elem());
+        s._seq.store(pos + _capacity, std::memory_order_release);
+        return value;
+      }
+
+      // the fence pairs with the one in _wait(): either the sleeper sees our publish or we see it
+      FORCE_INLINE void _notify(std::atomic<uint32_t>& epoch, std::atomic<uint32_t>& sleepers, size_type count) noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers.load(std::memory_order_relaxed) == 0) [[likely]] return;
+        epoch.fetch_add(1, std::memory_order_release);
+        if (count == 1) epoch.notify_one();
+        else epoch.notify_all();
+      }
+
+      template<typename Ready>
+      void _wait(std::atomic<uint32_t>& epoch, std::atomic<uint32_t>& sleepers, Ready ready) noexcept {
+        for (uint32_t i = 0; i < spin_rounds; ++i) {
+          if (ready()) return;
+          mm_pause();
+        }
+        const uint32_t current = epoch.load(std::memory_order_acquire);
+        sleepers.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!ready()) epoch.wait(current, std::memory_order_acquire);
+        sleepers.fetch_sub(1, std::memory_order_relaxed);
+      }
+
+      template<typename TryPush>
+      bool _push_wait(TryPush try_push_once) {
+        for (;;) {
+          if (closed()) return false;
+          if (try_push_once()) return true;
+          _wait(_signal._space_epoch, _signal._sleeping_producers, [this] { return size_approx() < _capacity || closed(); });
+        }
+      }
+
+      utility::compressed_pair<allocator_type, _slot*> _pair;
+      size_type _capacity;
+      _position _enqueue;
+      _position _dequeue;
+      _wait_state _signal;
+    };
+  } // namespace containers
+}
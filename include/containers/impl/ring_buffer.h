@@ -1,14 +1,293 @@
 #pragma once
 #define NOMINMAX
 #include <containers/detail/containers_internal.h>
+#include <containers/containers_dbg.h>
 #include <algorithm>
 #include <utility.h>
 #include <optional>
 #include <xmemory>
 #include <span>
+#include <iterator>
+#include <cstring>
+#include <bit>
+#include <atomic>
 
 namespace voxory {
   namespace containers {
+    /**
+     * @brief The elements of a ring_buffer as its (at most) two contiguous runs, oldest first.
+     * @details Loops over first and second are plain pointer loops the compiler can vectorize,
+     *          unlike per-element wrap-around indexing.
+     */
+    template<typename T>
+    struct ring_segments {
+      std::span<T> first;  // oldest element up to the end of storage (or the newest element)
+      std::span<T> second; // wrapped part at the start of storage; empty if not wrapped
+
+      NODISCARD CONSTEXPR std::size_t size() const noexcept { return first.size() + second.size(); }
+      NODISCARD CONSTEXPR bool empty() const noexcept { return size() == 0; }
+
+      /// Calls fn(std::span<T>) for each non-empty run, oldest first.
+      template<typename Fn>
+      CONSTEXPR void for_each(Fn&& fn) const {
+        if (!first.empty()) fn(first);
+        if (!second.empty()) fn(second);
+      }
+    };
+
+    namespace detail {
+      template<typename Traits>
+      class ConstRingBufferIterator
+#ifdef DEBUG_ITERATORS
+        : iterator_base
+#endif // DEBUG_ITERATORS
+      {
+      protected:
+        using storage_pointer = typename Traits::pointer;
+        using size_type = typename Traits::size_type;
+        using capacity_policy = typename Traits::capacity_policy;
+      public:
+        using value_type = typename Traits::value_type;
+        using pointer = typename Traits::const_pointer;
+        using reference = typename Traits::const_reference;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::random_access_iterator_tag;
+        using iterator_concept = std::random_access_iterator_tag;
+#ifdef DEBUG_ITERATORS
+        CONSTEXPR ConstRingBufferIterator() noexcept : iterator_base(), _data(nullptr), _capacity(0), _head(0), _idx(0) {}
+        CONSTEXPR ConstRingBufferIterator(const container_base* container, storage_pointer data, size_type capacity, size_type head, difference_type idx) noexcept
+          : iterator_base(container), _data(data), _capacity(capacity), _head(head), _idx(idx) {}
+#else
+        CONSTEXPR ConstRingBufferIterator() noexcept : _data(nullptr), _capacity(0), _head(0), _idx(0) {}
+        CONSTEXPR ConstRingBufferIterator(storage_pointer data, size_type capacity, size_type head, difference_type idx) noexcept
+          : _data(data), _capacity(capacity), _head(head), _idx(idx) {}
+#endif // DEBUG_ITERATORS
+
+        NODISCARD CONSTEXPR reference operator*() const noexcept {
+#ifdef DEBUG_ITERATORS
+          this->_verify();
+#endif // DEBUG_ITERATORS
+          return *_at(_idx);
+        }
+        NODISCARD CONSTEXPR pointer operator->() const noexcept {
+#ifdef DEBUG_ITERATORS
+          this->_verify();
+#endif // DEBUG_ITERATORS
+          return _at(_idx);
+        }
+        NODISCARD CONSTEXPR reference operator[](difference_type off) const noexcept {
+#ifdef DEBUG_ITERATORS
+          this->_verify();
+#endif // DEBUG_ITERATORS
+          return *_at(_idx + off);
+        }
+
+        CONSTEXPR ConstRingBufferIterator& operator++() noexcept {
+          ++_idx;
+          return *this;
+        }
+        CONSTEXPR ConstRingBufferIterator operator++(int) noexcept {
+          ConstRingBufferIterator tmp = *this;
+          ++_idx;
+          return tmp;
+        }
+        CONSTEXPR ConstRingBufferIterator& operator--() noexcept {
+          --_idx;
+          return *this;
+        }
+        CONSTEXPR ConstRingBufferIterator operator--(int) noexcept {
+          ConstRingBufferIterator tmp = *this;
+          --_idx;
+          return tmp;
+        }
+
+        CONSTEXPR ConstRingBufferIterator& operator+=(difference_type off) noexcept {
+          _idx += off;
+          return *this;
+        }
+        NODISCARD CONSTEXPR ConstRingBufferIterator operator+(difference_type off) const noexcept {
+          ConstRingBufferIterator tmp = *this;
+          tmp += off;
+          return tmp;
+        }
+        NODISCARD friend CONSTEXPR ConstRingBufferIterator operator+(difference_type off, const ConstRingBufferIterator& it) noexcept {
+          return it + off;
+        }
+        CONSTEXPR ConstRingBufferIterator& operator-=(difference_type off) noexcept {
+          _idx -= off;
+          return *this;
+        }
+        NODISCARD CONSTEXPR ConstRingBufferIterator operator-(difference_type off) const noexcept {
+          ConstRingBufferIterator tmp = *this;
+          tmp -= off;
+          return tmp;
+        }
+
+        NODISCARD CONSTEXPR difference_type operator-(const ConstRingBufferIterator& other) const noexcept {
+#ifdef DEBUG_ITERATORS
+          this->_verify_compatible(other);
+#endif // DEBUG_ITERATORS
+          return _idx - other._idx;
+        }
+
+        CONSTEXPR bool operator==(const ConstRingBufferIterator& other) const noexcept {
+#ifdef DEBUG_ITERATORS
+          this->_verify_compatible(other);
+#endif // DEBUG_ITERATORS
+          return _idx == other._idx;
+        }
+        CONSTEXPR bool operator!=(const ConstRingBufferIterator& other) const noexcept { return !(*this == other); }
+        CONSTEXPR bool operator<(const ConstRingBufferIterator& other) const noexcept { return _idx < other._idx; }
+        CONSTEXPR bool operator>(const ConstRingBufferIterator& other) const noexcept { return _idx > other._idx; }
+        CONSTEXPR bool operator<=(const ConstRingBufferIterator& other) const noexcept { return _idx <= other._idx; }
+        CONSTEXPR bool operator>=(const ConstRingBufferIterator& other) const noexcept { return _idx >= other._idx; }
+
+#ifdef DEBUG_ITERATORS
+        using iterator_base::_is_valid;
+#endif // DEBUG_ITERATORS
+
+      protected:
+        // logical index -> element; head < capacity and idx <= capacity keep the offset in wrap()'s range
+        NODISCARD CONSTEXPR FORCE_INLINE storage_pointer _at(difference_type idx) const noexcept {
+          return _data + capacity_policy::wrap(_head + static_cast<size_type>(idx), _capacity);
+        }
+
+        storage_pointer _data;
+        size_type _capacity;
+        size_type _head;
+        difference_type _idx;
+      };
+
+      template<typename Traits>
+      class RingBufferIterator : public ConstRingBufferIterator<Traits> {
+        using base_type = ConstRingBufferIterator<Traits>;
+      public:
+        using value_type = typename Traits::value_type;
+        using pointer = typename Traits::pointer;
+        using reference = typename Traits::reference;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::random_access_iterator_tag;
+        using iterator_concept = std::random_access_iterator_tag;
+
+        using base_type::base_type;
+
+        NODISCARD CONSTEXPR reference operator*() const noexcept { return const_cast<reference>(base_type::operator*()); }
+        NODISCARD CONSTEXPR pointer operator->() const noexcept { return const_cast<pointer>(base_type::operator->()); }
+        NODISCARD CONSTEXPR reference operator[](difference_type off) const noexcept { return const_cast<reference>(base_type::operator[](off)); }
+
+        CONSTEXPR RingBufferIterator& operator++() noexcept {
+          base_type::operator++();
+          return *this;
+        }
+        CONSTEXPR RingBufferIterator operator++(int) noexcept {
+          RingBufferIterator tmp = *this;
+          base_type::operator++();
+          return tmp;
+        }
+        CONSTEXPR RingBufferIterator& operator--() noexcept {
+          base_type::operator--();
+          return *this;
+        }
+        CONSTEXPR RingBufferIterator operator--(int) noexcept {
+          RingBufferIterator tmp = *this;
+          base_type::operator--();
+          return tmp;
+        }
+
+        CONSTEXPR RingBufferIterator& operator+=(difference_type off) noexcept {
+          base_type::operator+=(off);
+          return *this;
+        }
+        NODISCARD CONSTEXPR RingBufferIterator operator+(difference_type off) const noexcept {
+          RingBufferIterator tmp = *this;
+          tmp += off;
+          return tmp;
+        }
+        NODISCARD friend CONSTEXPR RingBufferIterator operator+(difference_type off, const RingBufferIterator& it) noexcept {
+          return it + off;
+        }
+        CONSTEXPR RingBufferIterator& operator-=(difference_type off) noexcept {
+          base_type::operator-=(off);
+          return *this;
+        }
+        NODISCARD CONSTEXPR RingBufferIterator operator-(difference_type off) const noexcept {
+          RingBufferIterator tmp = *this;
+          tmp -= off;
+          return tmp;
+        }
+        NODISCARD CONSTEXPR difference_type operator-(const RingBufferIterator& other) const noexcept { return base_type::operator-(other); }
+
+        CONSTEXPR bool operator==(const RingBufferIterator& other) const noexcept { return base_type::operator==(other); }
+        CONSTEXPR bool operator!=(const RingBufferIterator& other) const noexcept { return base_type::operator!=(other); }
+      };
+    } // namespace detail
+
+    namespace ring_policy {
+      // --- capacity policies ---
+      // wrap(offset, capacity) maps a physical offset in [0, 2 * capacity] back into
+      // [0, capacity]; callers never advance by more than capacity elements.
+
+      /// Heap storage of any size; wraps with a conditional subtract.
+      struct dynamic_capacity {
+        using size_type = std::size_t;
+        static constexpr bool is_fixed = false;
+
+        static CONSTEXPR FORCE_INLINE size_type round(size_type n) noexcept { return n; }
+        static CONSTEXPR FORCE_INLINE size_type wrap(size_type offset, size_type capacity) noexcept {
+          return offset - (offset >= capacity ? capacity : 0);
+        }
+      };
+
+      /// Heap storage rounded up to a power of two; wraps with a mask.
+      struct pow2_capacity {
+        using size_type = std::size_t;
+        static constexpr bool is_fixed = false;
+
+        static CONSTEXPR FORCE_INLINE size_type round(size_type n) noexcept { return n == 0 ? 0 : std::bit_ceil(n); }
+        static CONSTEXPR FORCE_INLINE size_type wrap(size_type offset, size_type capacity) noexcept {
+          return offset & (capacity - 1);
+        }
+      };
+
+      /// N elements stored inline in the container; never allocates.
+      template<std::size_t N>
+      struct fixed_capacity {
+        static_assert(N > 0, "fixed_capacity requires N > 0");
+        using size_type = std::size_t;
+        using inlined_size = std::integral_constant<size_type, N>;
+        static constexpr bool is_fixed = true;
+
+        static CONSTEXPR FORCE_INLINE size_type round(size_type) noexcept { return N; }
+        static CONSTEXPR FORCE_INLINE size_type wrap(size_type offset, size_type) noexcept {
+          if constexpr (std::has_single_bit(N)) {
+            return offset & (N - 1);
+          }
+          else {
+            return offset - (offset >= N ? N : 0);
+          }
+        }
+      };
+
+      // --- overflow policies (what a push does when the buffer is full) ---
+      enum class overflow_mode : uint8_t {
+        runtime,   // chosen by set_overwrite(); grow or overwrite
+        grow,      // reallocate
+        overwrite, // drop the oldest elements
+        reject,    // refuse the elements that do not fit
+        block      // wait until a consumer frees space (single producer / single consumer)
+      };
+
+      struct overflow_runtime { static constexpr overflow_mode mode = overflow_mode::runtime; };
+      struct overflow_grow { static constexpr overflow_mode mode = overflow_mode::grow; };
+      struct overflow_overwrite { static constexpr overflow_mode mode = overflow_mode::overwrite; };
+      struct overflow_reject { static constexpr overflow_mode mode = overflow_mode::reject; };
+      struct overflow_block { static constexpr overflow_mode mode = overflow_mode::block; };
+
+      // fixed storage cannot grow, so it overwrites by default
+      template<typename CapacityPolicy>
+      using default_overflow_t = std::conditional_t<CapacityPolicy::is_fixed, overflow_overwrite, overflow_runtime>;
+    } // namespace ring_policy
+
     /**
     * @brief Single-threaded circular buffer with dynamic capacity.
     *
@@ -22,14 +301,24 @@ namespace voxory {
     *       if used across threads. Concurrent access without synchronization
     *       results in undefined behavior.
     *
-    * @tparam T     Element type.
-    * @tparam Alloc Allocator used for allocation and element construction/destruction,
-    *               with std::construct_at / std::destroy_at as fallback.
+    * @note With ring_policy::overflow_block the element count is updated atomically,
+    *       which makes one producer (push side) and one consumer (pop side) safe
+    *       without external locking; any other concurrent use is still undefined.
+    *
+    * @tparam T              Element type.
+    * @tparam Alloc          Allocator used for allocation and element construction/destruction,
+    *                        with std::construct_at / std::destroy_at as fallback.
+    * @tparam CapacityPolicy ring_policy::dynamic_capacity, pow2_capacity or fixed_capacity<N>.
+    * @tparam OverflowPolicy ring_policy::overflow_* tag selecting the behaviour of a full buffer;
+    *                        branches of the other policies are compiled out.
     */
-    template<typename T, typename Alloc = std::allocator<T>>
-    class ring_buffer {
+    template<typename T, typename Alloc = std::allocator<T>,
+             typename CapacityPolicy = ring_policy::dynamic_capacity,
+             typename OverflowPolicy = ring_policy::default_overflow_t<CapacityPolicy>>
+    class ring_buffer : container_base {
       using FirstOneSecondArgs = utility::detail::FirstOneSecondArgs;
       using FirstZeroSecondArgs = utility::detail::FirstZeroSecondArgs;
+      using overflow_mode = ring_policy::overflow_mode;
     public:
       using allocator_type = Alloc;
       using allocator_traits = std::allocator_traits<Alloc>;
@@ -41,10 +330,25 @@ namespace voxory {
       using const_reference = const T&;
       using difference = std::ptrdiff_t;
       using cleanup_guard = internal::cleanup_guard<ring_buffer>;
+      using capacity_policy = CapacityPolicy;
+      using overflow_policy = OverflowPolicy;
+      using iterator = detail::RingBufferIterator<ring_buffer>;
+      using const_iterator = detail::ConstRingBufferIterator<ring_buffer>;
       friend cleanup_guard;
 
+      static constexpr bool is_fixed = capacity_policy::is_fixed;
+      static constexpr size_type inlined_size = internal::get_inlined_size<capacity_policy>::value;
+      static constexpr overflow_mode overflow = overflow_policy::mode;
+
+      static_assert(!is_fixed || (overflow != overflow_mode::grow && overflow != overflow_mode::runtime),
+        "fixed_capacity cannot grow; use overflow_overwrite, overflow_reject or overflow_block");
+
       // --- ctors & dtor ---
-      ring_buffer(const allocator_type& alloc = allocator_type()) : _pair(FirstOneSecondArgs{}, alloc), _allow_overwrite(true), _capacity(0) {};
+      ring_buffer(const allocator_type& alloc = allocator_type()) : _pair(FirstOneSecondArgs{}, alloc), _capacity(0), _allow_overwrite(true) {
+        if constexpr (is_fixed) {
+          _allocate_buffer(inlined_size);
+        }
+      };
 
       /**
        * @brief Constructor for the ring_buffer class.
@@ -52,23 +356,33 @@ namespace voxory {
        * @param capacity The number of elements the buffer can hold.
        * @param alloc Allocator for memory management (defaults to the standard allocator).
        */
-      ring_buffer(size_type capacity, const allocator_type& alloc = allocator_type()) : _pair(FirstOneSecondArgs{}, alloc), _allow_overwrite(true), _capacity(0) {
+      ring_buffer(size_type capacity, const allocator_type& alloc = allocator_type()) : _pair(FirstOneSecondArgs{}, alloc), _capacity(0), _allow_overwrite(true) {
         _allocate_buffer(capacity);
       };
 
-      ring_buffer(const ring_buffer& o) : _pair(FirstOneSecondArgs{}, allocator_traits::select_on_container_copy_construction(o._pair.first())), _capacity(0) {
+      ring_buffer(const ring_buffer& o) : _pair(FirstOneSecondArgs{}, allocator_traits::select_on_container_copy_construction(o._pair.first())), _capacity(0), _allow_overwrite(o._allow_overwrite) {
         _allocate_buffer(o._capacity);
         if (o._pair._second._size != 0)
         {
-          _fill_uninitialized_from_ring(o, internal::copy_tag{});
+          _pair._second._last = _fill_uninitialized_from_ring(_pair._second._data, o, internal::copy_tag{});
+          _pair._second._size = o._pair._second._size;
         }
       };
       /**
        * @brief Constructs a ring_buffer from other obj. Strong guarantee.
+       * @note With fixed_capacity the elements are moved one by one into the inline storage.
        * @param o Other object to move in.
        */
-      ring_buffer(ring_buffer&& o) noexcept : 
-        _pair(FirstOneSecondArgs{}, std::move(o.get_allocator()), std::move(o._pair._second)), _allow_overwrite(o._allow_overwrite), _capacity(o._capacity) {};
+      ring_buffer(ring_buffer&& o) noexcept(!is_fixed || std::is_nothrow_move_constructible_v<value_type>) :
+        _pair(FirstOneSecondArgs{}, std::move(o.get_allocator()), _steal_storage(o)), _capacity(o._capacity), _allow_overwrite(o._allow_overwrite) {
+        if constexpr (is_fixed) {
+          _allocate_buffer(inlined_size);
+          _move_from_fixed(o);
+        }
+        else {
+          o._capacity = 0;
+        }
+      };
       /**
        * @brief Dtor for the ring_buffer class.
        */
@@ -78,20 +392,28 @@ namespace voxory {
 
       ring_buffer& operator=(const ring_buffer& o)  {
         if (this == &o) return *this;
-        auto& this_alloc = get_allocator();
-        auto& o_alloc = o.get_allocator();
+        if constexpr (is_fixed) {
+          clear();
+          if (o._pair._second._size != 0) {
+            _pair._second._last = _fill_uninitialized_from_ring(_pair._second._data, o, internal::copy_tag{});
+            _pair._second._size = o._pair._second._size;
+          }
+          return *this;
+        }
+        else {
+          auto& this_alloc = get_allocator();
+          auto& o_alloc = o.get_allocator();
 
-        auto& this_data = _pair._second;
-        auto& o_data = o._pair._second;
-        if constexpr (allocator_traits::propagate_on_container_copy_assignment::value) {
-          //change allocator, allocate with copy ctor from new one
-          if (this_alloc != o_alloc) {
-            _cleanup();
-            this_alloc = o_alloc;
+          if constexpr (allocator_traits::propagate_on_container_copy_assignment::value) {
+            //change allocator, allocate with copy ctor from new one
+            if (this_alloc != o_alloc) {
+              _cleanup();
+              this_alloc = o_alloc;
+            }
           }
+          _assign(o, internal::copy_tag{});
+          return *this;
         }
-        _assign(o, internal::copy_tag);
-        return *this;
       };
 
       /**
@@ -103,10 +425,16 @@ namespace voxory {
         auto& this_alloc = get_allocator();
         auto& o_alloc = o.get_allocator();
 
-        if constexpr (allocator_traits::propagate_on_container_move_assignment::value) {
+        if constexpr (is_fixed) {
+          clear();
+          _move_from_fixed(o);
+          return *this;
+        }
+        else if constexpr (allocator_traits::propagate_on_container_move_assignment::value) {
           _cleanup();
           this_alloc = std::move(o_alloc);
           _pair._second = std::move(o._pair._second);
+          _capacity = std::exchange(o._capacity, 0);
           return *this;
         }
         else {
@@ -114,6 +442,7 @@ namespace voxory {
           {
             _cleanup();
             _pair._second = std::move(o._pair._second);
+            _capacity = std::exchange(o._capacity, 0);
             return *this;
           }
           else {
@@ -121,11 +450,12 @@ namespace voxory {
             {
               _cleanup();
               _pair._second = std::move(o._pair._second);
+              _capacity = std::exchange(o._capacity, 0);
               return *this;
             }
             else
             {
-              _assign_move(o);
+              _assign(o, internal::move_tag{});
               o._cleanup();
               return *this;
             }
@@ -139,7 +469,12 @@ namespace voxory {
        * @return capacity of ring buffer.
        */
       FORCE_INLINE CONSTEXPR size_type capacity() const noexcept {
-        return _capacity;
+        if constexpr (is_fixed) {
+          return inlined_size;
+        }
+        else {
+          return _capacity;
+        }
       };
       /*
        * @brief Returns the size of the ring buffer.
@@ -147,7 +482,7 @@ namespace voxory {
        * @return The number of currently active elements in the ring buffer.
        */
       CONSTEXPR size_type size() const noexcept {
-        return _pair._second._size;
+        return _load_size();
       };
       /**
        * @brief Checks if the ring buffer is empty.
@@ -196,9 +531,10 @@ namespace voxory {
       // --- overwrite policy ---
       /**
        * @brief Sets the overwrite behavior of the ring buffer.
+       * @note Only available with ring_policy::overflow_runtime.
        * @param allow A boolean indicating whether overwriting of elements is allowed.
        */
-      CONSTEXPR FORCE_INLINE void set_overwrite(bool allow) noexcept {
+      CONSTEXPR FORCE_INLINE void set_overwrite(bool allow) noexcept requires (overflow == overflow_mode::runtime) {
         _allow_overwrite = allow;
       };
 
@@ -207,22 +543,29 @@ namespace voxory {
        * @return True if overwriting of elements is permitted; otherwise, false.
        */
       CONSTEXPR FORCE_INLINE bool overwrite_allowed() const noexcept {
-        return _allow_overwrite;
+        if constexpr (overflow == overflow_mode::runtime) {
+          return _allow_overwrite;
+        }
+        else {
+          return overflow == overflow_mode::overwrite;
+        }
       };
 
       // --- single element operations (works with move-only types) ---
-      // If the buffer is full and overwrite is set to false, it will 
-      // dynamically increase the capacity; otherwise, it will 
-      // overwrite the old elements, which may result in data loss.
+      // A full buffer follows OverflowPolicy: grow, overwrite the oldest
+      // element (data loss), reject the new one, or wait for the consumer.
+      // overflow_runtime picks grow or overwrite from set_overwrite().
 
       /**
        * @brief Adds a copy of an element to the ring buffer.
        * @brief If the buffer is full, it may increase capacity or overwrite the oldest element,
        *        potentially resulting in data loss.
        * @param v The element to be added.
+       * @return False only if the element was rejected (overflow_reject, or overflow_block
+       *         without capacity).
        */
-      CONSTEXPR void push_back(const T& v) {
-        _emplace_back(v);
+      CONSTEXPR bool push_back(const T& v) {
+        return _emplace_back(v);
       };
 
       /**
@@ -230,9 +573,11 @@ namespace voxory {
        * @brief If the buffer is full, it may increase capacity or overwrite the oldest element,
        *        potentially resulting in data loss.
        * @param v The element to be added (moved).
+       * @return False only if the element was rejected (overflow_reject, or overflow_block
+       *         without capacity).
        */
-      CONSTEXPR void push_back(T&& v) {
-        _emplace_back(std::move(v));
+      CONSTEXPR bool push_back(T&& v) {
+        return _emplace_back(std::move(v));
       };
       /**
        * @brief Non-throwing pop operation.
@@ -244,13 +589,14 @@ namespace voxory {
         auto& data = _pair._second;
         auto& first = data._first;
 
-        if (data._size == 0) return std::nullopt;
+        if (_load_size() == 0) return std::nullopt;
 
         pointer to_read = first;
         T local(std::move(*to_read));
-        internal::destroy_at(to_read, alloc);
+        (void)internal::destroy_at(to_read, alloc);
         first = _append(first, 1);
-        --data._size;
+        _size_sub(1);
+        _invalidate_iterators();
 
         return std::optional<T>(std::move(local));
       }
@@ -264,7 +610,7 @@ namespace voxory {
         auto& data = _pair._second;
         auto& first = data._first;
 
-        if (data._size == 0) return nullptr;
+        if (_load_size() == 0) return nullptr;
         return first;
       };
 
@@ -277,7 +623,7 @@ namespace voxory {
         auto& data = _pair._second;
         auto& first = data._first;
 
-        if (data._size == 0) return nullptr;
+        if (_load_size() == 0) return nullptr;
         return first;
       };
 
@@ -302,6 +648,35 @@ namespace voxory {
         return *_append(_pair._second._first, idx);
       };
 
+      // --- iteration ---
+      // Iterators walk the elements oldest first. They stay valid across push_back() into free
+      // space and are invalidated by pops, overwrites, clear() and reallocation.
+
+      NODISCARD CONSTEXPR iterator begin() noexcept { return _make_iterator<iterator>(0); }
+      NODISCARD CONSTEXPR iterator end() noexcept { return _make_iterator<iterator>(_load_size()); }
+      NODISCARD CONSTEXPR const_iterator begin() const noexcept { return _make_iterator<const_iterator>(0); }
+      NODISCARD CONSTEXPR const_iterator end() const noexcept { return _make_iterator<const_iterator>(_load_size()); }
+      NODISCARD CONSTEXPR const_iterator cbegin() const noexcept { return begin(); }
+      NODISCARD CONSTEXPR const_iterator cend() const noexcept { return end(); }
+
+      /**
+       * @brief The elements as two contiguous spans, oldest first.
+       * @details Prefer this over iterators in hot loops: each span is a plain array, so
+       *          copies, transforms and reductions (sum, peak, RMS) vectorize.
+       */
+      NODISCARD CONSTEXPR ring_segments<T> segments() noexcept {
+        auto [head, tail] = _segment_bounds();
+        pointer start = _pair._second._data;
+        return { std::span<T>(utility::unfancy(_pair._second._first), static_cast<size_t>(head)),
+                 std::span<T>(tail == 0 ? nullptr : utility::unfancy(start), static_cast<size_t>(tail)) };
+      }
+      NODISCARD CONSTEXPR ring_segments<const T> segments() const noexcept {
+        auto [head, tail] = _segment_bounds();
+        const_pointer start = _pair._second._data;
+        return { std::span<const T>(utility::unfancy(_pair._second._first), static_cast<size_t>(head)),
+                 std::span<const T>(tail == 0 ? nullptr : utility::unfancy(start), static_cast<size_t>(tail)) };
+      }
+
       /**
        * @brief Destroy all elements in the ring buffer, leaving it empty; does not deallocate buffer
        */
@@ -313,6 +688,7 @@ namespace voxory {
         first = data._data;
         last = data._data;
         data._size = 0;
+        _invalidate_iterators();
       };
       
       /**
@@ -332,8 +708,10 @@ namespace voxory {
        * able to hold without further reallocation.
        */
       CONSTEXPR void reserve(size_type new_capacity) {
-        if (new_capacity > _capacity) {
-          _reallocate(new_capacity);
+        if constexpr (!is_fixed) {
+          if (new_capacity > _capacity) {
+            _reallocate(capacity_policy::round(new_capacity));
+          }
         }
       }
 
@@ -355,18 +733,34 @@ namespace voxory {
        * Provides the strong exception guarantee.
        */
       CONSTEXPR void shrink_to_fit() {
-        size_type sz = size();
-        if (sz < _capacity) {
-          _reallocate(sz);
+        if constexpr (!is_fixed) {
+          size_type sz = capacity_policy::round(size());
+          if (sz < _capacity) {
+            _reallocate(sz);
+          }
         }
       }
 
       // --- bulk / zero-copy style API ---
       /**
        * @brief Provides writable memory spans for adding elements.
+       * @note Spans cover raw (unconstructed) storage; elements must be constructed
+       *       in place before commit_write(). Empty spans are returned when full.
        * @return A pair of spans representing writable memory.
        */
-      CONSTEXPR std::pair<std::span<T>, std::span<T>> write_spans_for_push_back() noexcept;
+      CONSTEXPR std::pair<std::span<T>, std::span<T>> write_spans_for_push_back() noexcept {
+        auto& data = _pair._second;
+        size_type free = _capacity - _load_size();
+        if (free == 0) return { std::span<T>{}, std::span<T>{} };
+
+        pointer start = data._data;
+        pointer end = start + _capacity;
+        pointer last = (data._last == end) ? start : data._last;
+        size_type head = std::min(free, static_cast<size_type>(end - last));
+
+        return { std::span<T>(utility::unfancy(last), static_cast<size_t>(head)),
+                 std::span<T>(utility::unfancy(start), static_cast<size_t>(free - head)) };
+      }
 
       /**
        * @brief Confirms that a specified number of elements were written into the spans.
@@ -374,14 +768,26 @@ namespace voxory {
        */
       CONSTEXPR void commit_write(size_type n) noexcept {
         _pair._second._last = _append(_pair._second._last, n);
-        _pair._second._size += n;
+        _size_add(n);
       }
 
       /**
        * @brief Provides readable memory spans for removing elements.
        * @return A pair of spans containing readable elements (const).
        */
-      CONSTEXPR std::pair<std::span<const T>, std::span<const T>> read_spans_for_pop_front() const noexcept;
+      CONSTEXPR std::pair<std::span<const T>, std::span<const T>> read_spans_for_pop_front() const noexcept {
+        auto& data = _pair._second;
+        size_type size = _load_size();
+        if (size == 0) return { std::span<const T>{}, std::span<const T>{} };
+
+        const_pointer start = data._data;
+        const_pointer end = start + _capacity;
+        const_pointer first = data._first;
+        size_type head = std::min(size, static_cast<size_type>(end - first));
+
+        return { std::span<const T>(utility::unfancy(first), static_cast<size_t>(head)),
+                 std::span<const T>(utility::unfancy(start), static_cast<size_t>(size - head)) };
+      }
 
       /**
        * @brief Removes a specified number of elements from the buffer.
@@ -391,7 +797,84 @@ namespace voxory {
       CONSTEXPR void commit_read(size_type n) noexcept {
         _destroy_n(_pair._second._first, n);
         _pair._second._first = _append(_pair._second._first, n);
-        _pair._second._size-=n;
+        _size_sub(n);
+        _invalidate_iterators(); // iterators cache the old head; also covers discard_front()
+      }
+
+      /**
+       * @brief Copies the range [first, last) to the back of the buffer.
+       * @details Follows the same policy as push_back(): if the range does not fit,
+       *          the oldest elements are dropped (overwrite allowed) or the buffer grows.
+       *          Contiguous ranges of trivially copyable elements are copied with at most
+       *          two memcpy calls (split at the wrap point).
+       * @note basic guarantee
+       * @param first Start of the source range.
+       * @param last  End of the source range.
+       * @return Number of elements stored; less than the range length only with overflow_reject.
+       */
+      template<typename InputIt>
+      CONSTEXPR size_type push_back_range(InputIt first, InputIt last) {
+        using category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::contiguous_iterator<InputIt>) {
+          return _push_back_n(std::to_address(first), static_cast<size_type>(last - first));
+        }
+        else if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+          return _push_back_n(first, static_cast<size_type>(std::distance(first, last)));
+        }
+        else {
+          size_type pushed = 0;
+          for (; first != last; ++first) {
+            pushed += _emplace_back(*first) ? 1 : 0;
+          }
+          return pushed;
+        }
+      }
+
+      /**
+       * @brief Copies a contiguous block of elements to the back of the buffer.
+       * @note Same overflow policy as push_back_range().
+       * @param src Elements to append.
+       * @return Number of elements stored.
+       */
+      CONSTEXPR size_type append(std::span<const T> src) {
+        return _push_back_n(src.data(), static_cast<size_type>(src.size()));
+      }
+
+      /**
+       * @brief Moves up to out.size() oldest elements into out and removes them from the buffer.
+       * @note Trivially copyable elements are transferred with at most two memcpy calls.
+       * @param out Destination; elements are assigned, so it must hold live objects.
+       * @return Number of elements transferred.
+       */
+      CONSTEXPR size_type pop_front_into(std::span<T> out) noexcept(std::is_nothrow_move_assignable_v<value_type>) {
+        auto& data = _pair._second;
+        size_type n = std::min<size_type>(static_cast<size_type>(out.size()), _load_size());
+        if (n == 0) return 0;
+
+        pointer start = data._data;
+        pointer end = start + _capacity;
+        pointer first = data._first;
+        size_type head = std::min<size_type>(n, static_cast<size_type>(end - first));
+
+        T* dst = out.data();
+        dst = _move_out(first, head, dst);
+        if (n > head) {
+          _move_out(start, n - head, dst);
+        }
+        commit_read(n);
+        return n;
+      }
+
+      /**
+       * @brief Removes up to n oldest elements without reading them.
+       * @param n The number of elements to drop; clamped to size().
+       * @return Number of elements removed.
+       */
+      CONSTEXPR size_type discard_front(size_type n) noexcept(std::is_nothrow_destructible_v<value_type>) {
+        n = std::min(n, _load_size());
+        if (n == 0) return 0;
+        commit_read(n);
+        return n;
       }
 
       // --- helpers ---
@@ -406,10 +889,74 @@ namespace voxory {
 
     private:
 
+      template<typename It>
+      NODISCARD CONSTEXPR It _make_iterator(size_type idx) const noexcept {
+        auto& data = _pair._second;
+        size_type head = data._data == nullptr ? 0 : static_cast<size_type>(data._first - data._data);
+        if (head == _capacity) head = 0;
+#ifdef DEBUG_ITERATORS
+        return It(static_cast<const container_base*>(this), data._data, _capacity, head, static_cast<std::ptrdiff_t>(idx));
+#else
+        return It(data._data, _capacity, head, static_cast<std::ptrdiff_t>(idx));
+#endif // DEBUG_ITERATORS
+      }
+
+      // element counts of the run from first to the end of storage and of the wrapped run
+      NODISCARD CONSTEXPR std::pair<size_type, size_type> _segment_bounds() const noexcept {
+        auto& data = _pair._second;
+        size_type size = _load_size();
+        if (size == 0) return { 0, 0 };
+        size_type to_end = static_cast<size_type>((data._data + _capacity) - data._first);
+        size_type head = std::min(size, to_end);
+        return { head, size - head };
+      }
+
+      // n must not exceed capacity()
       CONSTEXPR FORCE_INLINE pointer _append(pointer current_ptr, size_type n) const noexcept {
-        size_type offset = static_cast<size_type>(current_ptr - _pair._second._data);
-        size_type new_offset = (offset + n) % _capacity;
-        return _pair._second._data + new_offset;
+        size_type offset = static_cast<size_type>(current_ptr - _pair._second._data) + n;
+        return _pair._second._data + capacity_policy::wrap(offset, _capacity);
+      }
+
+      // --- element count; atomic only for overflow_block (producer/consumer hand-off) ---
+      CONSTEXPR FORCE_INLINE size_type _load_size() const noexcept {
+        if constexpr (overflow == overflow_mode::block) {
+          return std::atomic_ref<size_type>(const_cast<size_type&>(_pair._second._size)).load(std::memory_order_acquire);
+        }
+        else {
+          return _pair._second._size;
+        }
+      }
+
+      CONSTEXPR FORCE_INLINE void _size_add(size_type n) noexcept {
+        if constexpr (overflow == overflow_mode::block) {
+          std::atomic_ref<size_type>(_pair._second._size).fetch_add(n, std::memory_order_release);
+        }
+        else {
+          _pair._second._size += n;
+        }
+      }
+
+      CONSTEXPR FORCE_INLINE void _size_sub(size_type n) noexcept {
+        if constexpr (overflow == overflow_mode::block) {
+          std::atomic_ref<size_type> size(_pair._second._size);
+          size.fetch_sub(n, std::memory_order_release);
+          size.notify_one();
+        }
+        else {
+          _pair._second._size -= n;
+        }
+      }
+
+      // blocks the producer until at least one slot is free; returns the free count.
+      // Callers reject the push first when there is no storage: nothing could free a slot.
+      size_type _wait_for_space() const noexcept requires (overflow == overflow_mode::block) {
+        std::atomic_ref<size_type> size(const_cast<size_type&>(_pair._second._size));
+        size_type current = size.load(std::memory_order_acquire);
+        while (current == _capacity) {
+          size.wait(current, std::memory_order_acquire);
+          current = size.load(std::memory_order_acquire);
+        }
+        return _capacity - current;
       }
 
       //basic guarantee
@@ -427,7 +974,7 @@ namespace voxory {
         else {
           last = internal::construct_at(start, alloc, std::forward<U>(val));
         }
-        data._size++;
+        _size_add(1);
       }
       //basic guarantee
       template<typename U>
@@ -452,6 +999,118 @@ namespace voxory {
         pointer next = first + 1;
         data._last = next;
         data._first = (next == end) ? start : next;
+        _invalidate_iterators();
+      }
+
+      // Makes room for n more elements according to the overwrite policy and
+      // constructs them from src. basic guarantee
+      template<typename FwdIt>
+      CONSTEXPR size_type _push_back_n(FwdIt src, size_type n) {
+        if (n == 0) return 0;
+
+        if constexpr (overflow == overflow_mode::block) {
+          // no storage: the consumer can never free a slot, and growing would race with it
+          if (_capacity == 0) return 0;
+          for (size_type left = n; left != 0;) {
+            size_type take = std::min(left, _wait_for_space());
+            src = _construct_back_n(src, take);
+            left -= take;
+          }
+          return n;
+        }
+        else {
+          size_type free = _capacity - _pair._second._size;
+          if (n > free) {
+            if constexpr (overflow == overflow_mode::reject) {
+              n = free;
+            }
+            else if constexpr (overflow == overflow_mode::overwrite) {
+              if constexpr (!is_fixed) {
+                // a default-constructed ring has nothing to overwrite: allocate, as runtime does
+                if (_capacity == 0) _reallocate(_grown_capacity(n));
+                else src = _drop_for_overwrite(src, n, free);
+              }
+              else {
+                src = _drop_for_overwrite(src, n, free);
+              }
+            }
+            else if constexpr (overflow == overflow_mode::grow) {
+              _reallocate(_grown_capacity(_pair._second._size + n));
+            }
+            else {
+              if (_allow_overwrite && _capacity != 0) {
+                src = _drop_for_overwrite(src, n, free);
+              }
+              else {
+                _reallocate(_grown_capacity(_pair._second._size + n));
+              }
+            }
+          }
+          _construct_back_n(src, n);
+          return n;
+        }
+      }
+
+      // frees room for n elements by dropping the oldest ones; if n exceeds the
+      // capacity only the newest capacity() source elements are kept
+      template<typename FwdIt>
+      CONSTEXPR FwdIt _drop_for_overwrite(FwdIt src, size_type& n, size_type free) {
+        if (n >= _capacity) {
+          std::advance(src, static_cast<std::ptrdiff_t>(n - _capacity));
+          n = _capacity;
+          clear();
+        }
+        else {
+          discard_front(n - free);
+        }
+        return src;
+      }
+
+      CONSTEXPR size_type _grown_capacity(size_type required) noexcept {
+        return capacity_policy::round(std::max(_calculate_grow(_capacity), required));
+      }
+
+      // n must not exceed the unused capacity; splits at the wrap point
+      template<typename FwdIt>
+      CONSTEXPR FwdIt _construct_back_n(FwdIt src, size_type n) {
+        auto& alloc = get_allocator();
+        auto& data = _pair._second;
+        pointer start = data._data;
+        pointer end = start + _capacity;
+
+        while (n != 0) {
+          pointer last = (data._last == end) ? start : data._last;
+          size_type take = std::min(n, static_cast<size_type>(end - last));
+          if constexpr (std::contiguous_iterator<FwdIt> && type_traits::use_memcpy_copy_construct_v<FwdIt> &&
+                        std::is_same_v<std::remove_cv_t<type_traits::iter_value_t<FwdIt>>, value_type>) {
+            std::memcpy(utility::unfancy(last), std::to_address(src), take * sizeof(value_type));
+            src += take;
+            data._last = last + take;
+            _size_add(take);
+          }
+          else {
+            for (size_type i = 0; i < take; ++i, ++src) {
+              last = internal::construct_at(last, alloc, *src);
+              data._last = last;
+              _size_add(1);
+            }
+          }
+          n -= take;
+        }
+        return src;
+      }
+
+      CONSTEXPR T* _move_out(pointer src, size_type n, T* dst) noexcept(std::is_nothrow_move_assignable_v<value_type>) {
+        if constexpr (std::is_trivially_copyable_v<value_type>) {
+          std::memcpy(dst, utility::unfancy(src), n * sizeof(value_type));
+          return dst + n;
+        }
+        else {
+          for (size_type i = 0; i < n; ++i) {
+            *dst++ = std::move(src[i]);
+          }
+          return dst;
+        }
       }
 
       constexpr inline size_type _calculate_grow(size_type capacity) noexcept {
@@ -470,28 +1129,59 @@ namespace voxory {
       }
 
       template<typename U>
-      CONSTEXPR void _emplace_back(U&& val) {
-        auto& alloc = get_allocator();
-        auto& data = _pair._second;
-        auto& first = data._first;
-        auto& last = data._last;
-        auto& start = data._data;
-        pointer end = data._data + _capacity;
-
-        if(data._size < _capacity) {
+      CONSTEXPR bool _emplace_back(U&& val) {
+        if constexpr (overflow == overflow_mode::block) {
+          if (_capacity == 0) return false; // see _push_back_n()
+          (void)_wait_for_space();
           _emplace_back_with_unused_capacity(std::forward<U>(val));
+          return true;
         }
         else {
-          if (_allow_overwrite == true) {
+          if (_pair._second._size < _capacity) {
+            _emplace_back_with_unused_capacity(std::forward<U>(val));
+            return true;
+          }
+          if constexpr (overflow == overflow_mode::reject) {
+            return false;
+          }
+          else if constexpr (overflow == overflow_mode::overwrite) {
+            if constexpr (!is_fixed) {
+              // a default-constructed ring has nothing to overwrite: allocate, as runtime does
+              if (_capacity == 0) {
+                _reallocate(_grown_capacity(1));
+                _emplace_back_with_unused_capacity(std::forward<U>(val));
+                return true;
+              }
+            }
             _emplace_back_overwrite(std::forward<U>(val));
           }
-          else {
-            _reallocate(_calculate_grow(_capacity));
+          else if constexpr (overflow == overflow_mode::grow) {
+            _reallocate(_grown_capacity(_capacity + 1));
             _emplace_back_with_unused_capacity(std::forward<U>(val));
           }
+          else {
+            if (_allow_overwrite == true && _capacity != 0) {
+              _emplace_back_overwrite(std::forward<U>(val));
+            }
+            else {
+              _reallocate(_grown_capacity(_capacity + 1));
+              _emplace_back_with_unused_capacity(std::forward<U>(val));
+            }
+          }
+          return true;
         }
       };
 
+      // element-wise move out of another fixed ring; this must be empty
+      CONSTEXPR void _move_from_fixed(ring_buffer& o) {
+        auto& data = _pair._second;
+        if (o._pair._second._size != 0) {
+          data._last = _fill_uninitialized_from_ring(data._data, o, internal::move_tag{});
+          data._size = o._pair._second._size;
+        }
+        o.clear();
+      }
+
       CONSTEXPR void _cleanup() {
         auto& this_data = _pair._second;
         auto& first = this_data._first;
@@ -510,7 +1200,21 @@ namespace voxory {
         auto& this_data = _pair._second;
         pointer new_data = this_alloc.allocate(new_capacity);
         pointer new_last = new_data;
-        if constexpr (internal::is_nothrow_uninitialized_moveable_v<allocator_type, pointer>)
+        if constexpr (internal::is_memcpy_relocatable_v<allocator_type>)
+        {
+          // both segments are memcpy'd; the old elements are not destroyed below
+          if (this_data._size != 0) {
+            pointer start = this_data._data;
+            if (this_data._first < this_data._last) {
+              new_last = internal::uninitialized_relocate(this_data._first, this_data._last, new_data, this_alloc);
+            }
+            else {
+              new_last = internal::uninitialized_relocate(this_data._first, start + _capacity, new_data, this_alloc);
+              new_last = internal::uninitialized_relocate(start, this_data._last, new_last, this_alloc);
+            }
+          }
+        }
+        else if constexpr (internal::is_nothrow_uninitialized_moveable_v<allocator_type, pointer>)
         {
           if (this_data._size != 0) new_last = _fill_uninitialized_from_ring(new_data, *this, internal::move_tag{});
         }
@@ -524,16 +1228,23 @@ namespace voxory {
             guard.release();
           }
         }
-        _cleanup();
+        size_type size = this_data._size;
+        if constexpr (internal::is_memcpy_relocatable_v<allocator_type>) {
+          _deallocate_buffer();
+        }
+        else {
+          _cleanup();
+        }
         this_data._data = new_data;
         this_data._first = new_data;
         this_data._last = new_last;
+        this_data._size = size;
         _capacity = new_capacity;
       }
 
       // if o_data._size == 0 then UB, must be verified at higher levels 
       template<typename Tag>
-      CONSTEXPR pointer _fill_uninitialized_from_ring(pointer dest, ring_buffer& o, Tag&&)
+      CONSTEXPR pointer _fill_uninitialized_from_ring(pointer dest, const ring_buffer& o, Tag&&)
         noexcept((std::is_same_v<std::remove_cvref_t<Tag>, internal::move_tag>) ? 
                   internal::is_nothrow_uninitialized_moveable_v<allocator_type, pointer> : 
                   internal::is_nothrow_uninitialized_copyable_v<allocator_type, pointer>) 
@@ -571,7 +1282,7 @@ namespace voxory {
       }
 
       template<typename Tag>
-      CONSTEXPR std::tuple<pointer, pointer, size_type> _allocate_fill_temp(ring_buffer& o, Tag&& tag) {
+      CONSTEXPR std::tuple<pointer, pointer, size_type> _allocate_fill_temp(const ring_buffer& o, Tag&& tag) {
         auto& this_alloc = get_allocator();
         size_type o_capacity = o._capacity;
         pointer new_start = this_alloc.allocate(o_capacity);
@@ -591,7 +1302,7 @@ namespace voxory {
       // and ensure safe access to elements in the ring buffer.
       // strong guarantee
       template<typename Tag>
-      CONSTEXPR void _release_and_transfer(ring_buffer& o, Tag&& t)
+      CONSTEXPR void _release_and_transfer(const ring_buffer& o, Tag&& t)
         noexcept(internal::is_nothrow_uninitialized_moveable_v<allocator_type, pointer> || 
                  internal::is_nothrow_uninitialized_copyable_v<allocator_type, pointer>) {
         auto& this_data = _pair._second;
@@ -631,7 +1342,7 @@ namespace voxory {
         }
       }
       template<typename Tag>
-      CONSTEXPR void _destroy_and_transfer_source(ring_buffer& o, Tag&& t)
+      CONSTEXPR void _destroy_and_transfer_source(const ring_buffer& o, Tag&& t)
         noexcept(internal::is_nothrow_uninitialized_moveable_v<allocator_type, pointer> ||
                  internal::is_nothrow_uninitialized_copyable_v<allocator_type, pointer>) {
         auto& this_data = _pair._second;
@@ -694,7 +1405,7 @@ namespace voxory {
 
       template<typename Tag>
       // does not verify capacity of objects, should be done on higher levels
-      CONSTEXPR void _transfer_source(ring_buffer& o, Tag&& /*t*/) {
+      CONSTEXPR void _transfer_source(const ring_buffer& o, Tag&& /*t*/) {
         auto& this_data = _pair._second;
         auto& this_alloc = get_allocator();
         size_type this_size = this_data._size;
@@ -852,7 +1563,7 @@ namespace voxory {
       // Provides strong or basic exception guarantee depending on element move/copy properties; 
       // helper itself gives basic guarantee.
       template<typename Tag>
-      CONSTEXPR void _assign(ring_buffer& o, Tag&& t) {
+      CONSTEXPR void _assign(const ring_buffer& o, Tag&& t) {
         size_type this_capacity = _capacity;
         size_type o_capacity = o._capacity;
         size_type this_size = size();
@@ -900,16 +1611,23 @@ namespace voxory {
         auto& data = _pair._second;
         auto& alloc = get_allocator();
 
-        if (count == 0)
-        {
-          data._first = nullptr;
-          data._last = nullptr;
-          data._size = 0;
-          _capacity = 0;
-          return;
+        if constexpr (is_fixed) {
+          // the requested count is ignored, the storage is always inline
+          data._data = reinterpret_cast<pointer>(_inline._bytes);
+          count = inlined_size;
+        }
+        else {
+          if (count == 0)
+          {
+            data._first = nullptr;
+            data._last = nullptr;
+            data._size = 0;
+            _capacity = 0;
+            return;
+          }
+          count = capacity_policy::round(count);
+          data._data = alloc.allocate(count);
         }
-
-        data._data = alloc.allocate(count);
 
         data._first = data._data;
         data._last = data._data;
@@ -918,12 +1636,19 @@ namespace voxory {
       }
 
       CONSTEXPR void _deallocate_buffer() {
+        _invalidate_iterators();
         auto& alloc = get_allocator();
         auto& data = _pair._second;
         auto& start = data._data;
         auto& first = data._first;
         auto& last = data._last;
-        if (start != nullptr) {
+        if constexpr (is_fixed) {
+          // inline storage stays attached for the lifetime of the object
+          first = start;
+          last = start;
+          data._size = 0;
+        }
+        else if (start != nullptr) {
           alloc.deallocate(start, _capacity);
           start = nullptr;
           first = nullptr;
@@ -1025,9 +1750,24 @@ namespace voxory {
         size_type _size;
       };
 
+      // fixed storage cannot be stolen, its elements are moved instead
+      static CONSTEXPR _storage _steal_storage(ring_buffer& o) noexcept {
+        if constexpr (is_fixed) {
+          return _storage{};
+        }
+        else {
+          return std::move(o._pair._second);
+        }
+      }
+
+      struct _inline_storage {
+        alignas(value_type) unsigned char _bytes[inlined_size * sizeof(value_type)];
+      };
+
       utility::compressed_pair<allocator_type, _storage> _pair;
       size_type _capacity;
       bool _allow_overwrite;
+      NO_UNIQUE_ADDRESS std::conditional_t<is_fixed, _inline_storage, internal::empty_data> _inline;
     };
 
     /// SPSC-optimized variant (lightweight, lock-free for 1P/1C)
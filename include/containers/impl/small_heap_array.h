@@ -0,0 +1,410 @@
+#pragma once
+#define NOMINMAX
+#include <utility.h>
+#include <platform/platform.h>
+#include <stdexcept>
+#include <containers/detail/containers_internal.h>
+#include <containers/containers_dbg.h>
+#include <containers/impl/heap_array.h>
+
+namespace voxory {
+  namespace containers {
+    namespace small_policy {
+      /// N elements stored inside the container, heap storage from Alloc beyond that.
+      template<std::size_t N, typename Alloc = internal::no_allocator>
+      struct inlined_buffer {
+        using storage = internal::inlined;
+        using size_type = std::size_t;
+        using inlined_size = std::integral_constant<size_type, N>;
+        using allocator_type = Alloc;
+      };
+    } // namespace small_policy
+
+    /**
+    * @brief heap_array with room for a few elements inside the object itself.
+    *
+    *        Up to inlined_size elements live in the container and no allocation happens; a
+    *        larger resize()/reserve() moves them to the heap, and shrink_to_fit() or clear()
+    *        moves back once they fit again. The API and the exact-capacity growth are those of
+    *        heap_array.
+    *
+    * @note Unlike heap_array, moving an inline container moves its elements one by one, and
+    *       iterators of the source are invalidated as with any other move.
+    *
+    * @tparam T      Element type.
+    * @tparam Policy small_policy::inlined_buffer<N, Alloc>; a policy without allocator_type
+    *                spills through std::allocator<T>.
+    */
+    template<typename T, typename Policy>
+    class basic_small_heap_array : container_base
+    {
+      using FirstOneSecondArgs = utility::detail::FirstOneSecondArgs;
+      using policy_allocator = typename internal::get_allocator_type<Policy>::type;
+    public:
+      using value_type = T;
+      using allocator_type = std::conditional_t<std::is_same_v<policy_allocator, internal::no_allocator>, std::allocator<T>, policy_allocator>;
+      using allocator_traits = std::allocator_traits<allocator_type>;
+      using reference = value_type&;
+      using const_reference = const value_type&;
+      using pointer = typename allocator_traits::pointer;
+      using const_pointer = typename allocator_traits::const_pointer;
+      using size_type = typename allocator_traits::size_type;
+      using cleanup_guard = internal::cleanup_guard<basic_small_heap_array>;
+      using trivial_traits = type_traits::trivial_traits<value_type>;
+      using iterator = detail::HeapArrayIterator<basic_small_heap_array>;
+      using const_iterator = detail::ConstHeapArrayIterator<basic_small_heap_array>;
+      friend cleanup_guard;
+
+      static constexpr size_type inlined_size = internal::get_inlined_size<Policy>::value;
+
+      static_assert(inlined_size > 0, "basic_small_heap_array requires an inlined_size > 0");
+      static_assert(std::is_same_v<value_type, typename allocator_traits::value_type>, "value_type must match allocator_traits::value_type");
+      static_assert(std::is_pointer_v<pointer>, "inline storage requires raw allocator pointers");
+
+      basic_small_heap_array(const allocator_type& alloc = allocator_type()) : _pair(FirstOneSecondArgs{}, alloc), _capacity(inlined_size) {
+        _reset_inline();
+      }
+
+      basic_small_heap_array(size_t count, const value_type& val, const allocator_type& alloc = allocator_type())
+        : basic_small_heap_array(alloc) {
+        _construct_range(count, val);
+      };
+
+      basic_small_heap_array(size_t count, const allocator_type& alloc = allocator_type())
+        : basic_small_heap_array(alloc) {
+        _construct_range(count);
+      };
+
+      /// count default-initialized elements: trivial types are left unwritten (no zero-fill).
+      basic_small_heap_array(size_t count, default_init_t, const allocator_type& alloc = allocator_type())
+        : basic_small_heap_array(alloc) {
+        _construct_range(count, default_init);
+      };
+
+      basic_small_heap_array(const basic_small_heap_array& o)
+        : basic_small_heap_array(allocator_traits::select_on_container_copy_construction(o._pair.first())) {
+        _construct_range(o.size(), o._pair._second._first, o._pair._second._last);
+      };
+
+      basic_small_heap_array(basic_small_heap_array&& o) noexcept(noexcept(std::declval<basic_small_heap_array&>()._take(o)))
+        : basic_small_heap_array(std::move(o._pair.first())) {
+        _take(o);
+      };
+
+      ~basic_small_heap_array() {
+        _cleanup();
+      }
+
+      basic_small_heap_array& operator=(basic_small_heap_array&& o)
+        noexcept(noexcept(std::declval<basic_small_heap_array&>()._take(o)) &&
+                 (allocator_traits::propagate_on_container_move_assignment::value || allocator_traits::is_always_equal::value))
+      {
+        if (this == &o) return *this;
+        _cleanup();
+        if constexpr (allocator_traits::propagate_on_container_move_assignment::value) {
+          get_allocator() = std::move(o.get_allocator());
+        }
+        else if constexpr (!allocator_traits::is_always_equal::value) {
+          if (get_allocator() != o.get_allocator()) {
+            // o's heap block cannot be freed by our allocator: move the elements instead
+            _relocate_from(o);
+            return *this;
+          }
+        }
+        _take(o);
+        return *this;
+      };
+
+      basic_small_heap_array& operator=(const basic_small_heap_array& o) {
+        if (this == &o) return *this;
+        _cleanup();
+        if constexpr (allocator_traits::propagate_on_container_copy_assignment::value) {
+          get_allocator() = o.get_allocator();
+        }
+        _construct_range(o.size(), o._pair._second._first, o._pair._second._last);
+        return *this;
+      };
+
+      reference operator[](size_t idx) noexcept {
+#ifdef DEBUG
+        ASSERT_ABORT(idx < size(), "small_heap_array index out of bounds");
+#endif // DEBUG
+        return _pair._second._first[idx];
+      };
+
+      const_reference operator[](size_t idx) const noexcept {
+#ifdef DEBUG
+        ASSERT_ABORT(idx < size(), "small_heap_array index out of bounds");
+#endif // DEBUG
+        return _pair._second._first[idx];
+      };
+
+      NODISCARD CONSTEXPR pointer data() const noexcept {
+        return _pair._second._first;
+      };
+
+      NODISCARD CONSTEXPR size_type capacity() const noexcept {
+        return _capacity;
+      };
+
+      /// True while the elements live inside the object (no heap block is owned).
+      NODISCARD CONSTEXPR bool is_inlined() const noexcept {
+        return _pair._second._first == _inline_data();
+      };
+
+      NODISCARD CONSTEXPR allocator_type& get_allocator() noexcept {
+        return _pair.first();
+      };
+
+      NODISCARD CONSTEXPR const allocator_type& get_allocator() const noexcept {
+        return _pair.first();
+      };
+
+      NODISCARD CONSTEXPR size_type size() const noexcept {
+        return static_cast<size_type>(_pair._second._last - _pair._second._first);
+      };
+
+      NODISCARD CONSTEXPR bool empty() const noexcept {
+        return size() == 0;
+      };
+
+      /// Destroys the elements and returns to the inline storage.
+      CONSTEXPR void clear() noexcept {
+        _cleanup();
+      };
+
+      CONSTEXPR void resize(size_type size) {
+        _resize_buffer(size);
+      };
+
+      /// Like resize(), but new elements are default-initialized (see heap_array::resize_for_overwrite).
+      CONSTEXPR void resize_for_overwrite(size_type size) {
+        _resize_buffer<true>(size);
+      };
+
+      CONSTEXPR void reserve(size_t size) {
+        if (size > _capacity)
+        {
+          _reallocate(size);
+        }
+      };
+
+      NODISCARD CONSTEXPR reference at(size_t index) {
+        if (index >= size()) throw std::out_of_range("index out of range");
+        return _pair._second._first[index];
+      }
+
+      NODISCARD CONSTEXPR const_reference at(size_t index) const {
+        if (index >= size()) throw std::out_of_range("index out of range");
+        return _pair._second._first[index];
+      }
+
+      NODISCARD CONSTEXPR iterator begin() noexcept {
+        return ITER_DEBUG_WRAP(iterator, _pair._second._first);
+      };
+
+      NODISCARD CONSTEXPR iterator end() noexcept {
+        return ITER_DEBUG_WRAP(iterator, _pair._second._last);
+      };
+
+      NODISCARD CONSTEXPR const_iterator end() const noexcept {
+        return ITER_DEBUG_WRAP(const_iterator, _pair._second._last);
+      };
+
+      NODISCARD CONSTEXPR const_iterator begin() const noexcept {
+        return ITER_DEBUG_WRAP(const_iterator, _pair._second._first);
+      };
+
+      NODISCARD CONSTEXPR const_iterator cend() const noexcept {
+        return ITER_DEBUG_WRAP(const_iterator, _pair._second._last);
+      };
+
+      NODISCARD CONSTEXPR const_iterator cbegin() const noexcept {
+        return ITER_DEBUG_WRAP(const_iterator, _pair._second._first);
+      };
+
+      /// Releases unused heap capacity; moves the elements back inline if they fit.
+      CONSTEXPR void shrink_to_fit() {
+        if (!is_inlined() && size() < _capacity) {
+          _reallocate(size());
+        }
+      }
+
+    private:
+      NODISCARD CONSTEXPR pointer _inline_data() const noexcept {
+        return reinterpret_cast<pointer>(const_cast<unsigned char*>(_inline._bytes));
+      }
+
+      CONSTEXPR void _reset_inline() noexcept {
+        _pair._second._first = _inline_data();
+        _pair._second._last = _inline_data();
+        _capacity = inlined_size;
+      }
+
+      // o keeps its allocator and is left empty and inline
+      CONSTEXPR void _take(basic_small_heap_array& o) noexcept(noexcept(std::declval<basic_small_heap_array&>()._relocate_from(o))) {
+        auto& o_data = o._pair._second;
+        if (o.is_inlined()) {
+          _relocate_from(o);
+        }
+        else {
+          _pair._second._first = std::exchange(o_data._first, o._inline_data());
+          _pair._second._last = std::exchange(o_data._last, o._inline_data());
+          _capacity = std::exchange(o._capacity, inlined_size);
+          o._invalidate_iterators();
+        }
+      }
+
+      // moves the elements into inline storage when new_capacity fits, else into a new heap block
+      CONSTEXPR void _reallocate(size_type new_capacity) {
+        auto& data = _pair._second;
+        auto& alloc = get_allocator();
+        auto& first = data._first;
+        auto& last = data._last;
+
+        const bool to_inline = new_capacity <= inlined_size;
+        if (to_inline && is_inlined()) return;
+
+        pointer new_data = to_inline ? _inline_data() : alloc.allocate(new_capacity);
+        pointer new_last = new_data;
+        internal::realloc_guard<allocator_type> guard(alloc, to_inline ? nullptr : new_data, new_capacity);
+        //guard, if a copy throws: destroy new_data, leave old intact
+        new_last = internal::uninitialized_relocate(first, last, new_data, alloc);
+        guard.release();
+
+        // the old elements were relocated: only release their memory
+        last = first;
+        _cleanup();
+
+        first = new_data;
+        last = new_last;
+        _capacity = to_inline ? inlined_size : new_capacity;
+      };
+
+      template<bool DefaultInit = false>
+      CONSTEXPR void _resize_buffer(size_type new_size) {
+        size_type old_size = size();
+        if (new_size == old_size) return;
+
+        if (new_size > _capacity) {
+          _reallocate(new_size);
+        }
+
+        auto& data = _pair._second;
+        auto& alloc = get_allocator();
+        auto& last = data._last;
+        if (new_size < old_size) {
+          pointer new_last = last - (old_size - new_size);
+          _destroy_range(new_last, last);
+          last = new_last;
+        }
+        else {
+          size_type to_construct = new_size - old_size;
+          if constexpr (DefaultInit) {
+            last = internal::uninitialized_default_init_n(last, to_construct, alloc);
+          }
+          else {
+            last = internal::uninitialized_default_construct_n(last, to_construct, alloc);
+          }
+        }
+        _invalidate_iterators();
+      }
+
+      CONSTEXPR void _cleanup() noexcept {
+        auto& data = _pair._second;
+        _invalidate_iterators();
+        _destroy_range(data._first, data._last);
+        if (!is_inlined()) {
+          get_allocator().deallocate(data._first, _capacity);
+        }
+        _reset_inline();
+      };
+
+      CONSTEXPR void _destroy_range(pointer first, pointer end) noexcept {
+        if constexpr (!trivial_traits::is_trivially_destructible::value) {
+          auto& alloc = get_allocator();
+          for (; first < end; first++) {
+            if constexpr (type_traits::has_destroy<allocator_type, pointer>::value) {
+              alloc.destroy(first);
+            }
+            else {
+              std::destroy_at(first);
+            }
+          }
+        }
+      };
+
+      // expects an empty, inline container
+      template<typename... Args>
+      CONSTEXPR void _construct_range(size_t count, Args&&... args) {
+        // sizeof...(Args) == 0 = default construct
+        // sizeof...(Args) == 1 = fill_n with value, or default_init
+        // sizeof...(Args) == 2 = copy construct from src(start, end)
+        if (count == 0) return;
+        _allocate_for(count);
+        auto& data = _pair._second;
+        auto& alloc = get_allocator();
+        auto& first = data._first;
+        auto& last = data._last;
+        constexpr uint8_t args_count = sizeof...(Args);
+        cleanup_guard guard(this);
+        if constexpr (args_count == 0) {
+          last = internal::uninitialized_default_construct_n(first, count, alloc);
+        }
+        else if constexpr (args_count == 1 && (std::is_same_v<std::remove_cvref_t<Args>, default_init_t> && ...)) {
+          last = internal::uninitialized_default_init_n(first, count, alloc);
+        }
+        else if constexpr (args_count == 1) {
+          last = internal::uninitialized_fill_n(first, count, std::forward<Args>(args)..., alloc);
+        }
+        else if constexpr (args_count == 2) {
+          last = internal::uninitialized_copy(std::forward<Args>(args)..., first, alloc);
+        }
+        guard.release();
+      }
+
+      // expects an empty, inline container; o is left empty and inline
+      CONSTEXPR void _relocate_from(basic_small_heap_array& o) noexcept(noexcept(internal::uninitialized_relocate(
+        std::declval<pointer>(), std::declval<pointer>(), std::declval<pointer>(), std::declval<allocator_type&>()))) {
+        auto& o_data = o._pair._second;
+        if (o_data._first != o_data._last) {
+          _allocate_for(static_cast<size_type>(o_data._last - o_data._first));
+          auto& data = _pair._second;
+          cleanup_guard guard(this);
+          data._last = internal::uninitialized_relocate(o_data._first, o_data._last, data._first, get_allocator());
+          guard.release();
+          o_data._last = o_data._first;
+        }
+        o._cleanup();
+      }
+
+      // switches an empty, inline container to a heap block when count does not fit inline
+      CONSTEXPR void _allocate_for(size_type count) {
+        if (count > inlined_size) {
+          auto& data = _pair._second;
+          data._first = get_allocator().allocate(count);
+          data._last = data._first;
+          _capacity = count;
+        }
+      }
+
+    protected:
+      struct _storage {
+        pointer _first;
+        pointer _last;
+      };
+
+      struct _inline_storage {
+        alignas(value_type) unsigned char _bytes[inlined_size * sizeof(value_type)];
+      };
+
+      utility::compressed_pair<allocator_type, _storage> _pair;
+      size_type _capacity;
+      _inline_storage _inline;
+    };
+
+    /// heap_array that keeps up to N elements inline and allocates only beyond that.
+    template<typename T, std::size_t N, typename Alloc = std::allocator<T>>
+    using small_heap_array = basic_small_heap_array<T, small_policy::inlined_buffer<N, Alloc>>;
+  }
+}
@@ -3,6 +3,7 @@
 #include <utility.h>
 #include <type_traits.h>
 #include <containers/detail/containers_internal.h>
+#include <containers/containers_dbg.h>
 #include <platform/platform.h>
 #include <memory>
 #include <xmemory>
@@ -14,7 +15,11 @@ namespace voxory {
 //   : CONSTEXPR, NODISCARD
 
       template<typename Traits>
-      class ConstStaticArrayIterator {
+      class ConstStaticArrayIterator
+#ifdef DEBUG_ITERATORS
+        : iterator_base
+#endif // DEBUG_ITERATORS
+      {
       public:
         // types
         using value_type = typename Traits::value_type;
@@ -25,12 +30,27 @@ namespace voxory {
         using iterator_category = std::random_access_iterator_tag;
 
         // ctors
+#ifdef DEBUG_ITERATORS
+        CONSTEXPR ConstStaticArrayIterator() noexcept : iterator_base(), _ptr(nullptr) {}
+        CONSTEXPR explicit ConstStaticArrayIterator(const container_base* container, pointer p) noexcept : iterator_base(container), _ptr(p) {}
+#else
         CONSTEXPR ConstStaticArrayIterator() noexcept : _ptr(nullptr) {}
         CONSTEXPR explicit ConstStaticArrayIterator(pointer p) noexcept : _ptr(p) {}
+#endif // DEBUG_ITERATORS
 
         // dereference
-        NODISCARD CONSTEXPR reference operator*() const noexcept { return *_ptr; }
-        NODISCARD CONSTEXPR const_pointer operator->() const noexcept { return _ptr; }
+        NODISCARD CONSTEXPR reference operator*() const noexcept {
+#ifdef DEBUG_ITERATORS
+          this->_verify();
+#endif // DEBUG_ITERATORS
+          return *_ptr;
+        }
+        NODISCARD CONSTEXPR const_pointer operator->() const noexcept {
+#ifdef DEBUG_ITERATORS
+          this->_verify();
+#endif // DEBUG_ITERATORS
+          return _ptr;
+        }
 
         // prefix / postfix ++
         CONSTEXPR ConstStaticArrayIterator& operator++() noexcept {
@@ -77,12 +97,20 @@ namespace voxory {
 
         // difference between iterators
         CONSTEXPR difference_type operator-(const ConstStaticArrayIterator& other) const noexcept {
+#ifdef DEBUG_ITERATORS
+          this->_verify_compatible(other);
+#endif // DEBUG_ITERATORS
           return static_cast<difference_type>(_ptr - other._ptr);
         }
 
         // comparisons
-        CONSTEXPR bool operator==(const ConstStaticArrayIterator& other) const noexcept { return _ptr == other._ptr; }
-        CONSTEXPR bool operator!=(const ConstStaticArrayIterator& other) const noexcept { return _ptr != other._ptr; }
+        CONSTEXPR bool operator==(const ConstStaticArrayIterator& other) const noexcept {
+#ifdef DEBUG_ITERATORS
+          this->_verify_compatible(other);
+#endif // DEBUG_ITERATORS
+          return _ptr == other._ptr;
+        }
+        CONSTEXPR bool operator!=(const ConstStaticArrayIterator& other) const noexcept { return !(*this == other); }
         CONSTEXPR bool operator<(const ConstStaticArrayIterator& other) const noexcept { return _ptr < other._ptr; }
         CONSTEXPR bool operator>(const ConstStaticArrayIterator& other) const noexcept { return _ptr > other._ptr; }
         CONSTEXPR bool operator<=(const ConstStaticArrayIterator& other) const noexcept { return _ptr <= other._ptr; }
@@ -90,6 +118,9 @@ namespace voxory {
 
         // random-access indexing
         NODISCARD CONSTEXPR reference operator[](difference_type off) const noexcept {
+#ifdef DEBUG_ITERATORS
+          this->_verify();
+#endif // DEBUG_ITERATORS
           return *(_ptr + off);
         }
 
@@ -110,15 +141,20 @@ namespace voxory {
         using iterator_category = std::random_access_iterator_tag;
 
         // ctors
+#ifdef DEBUG_ITERATORS
+        CONSTEXPR StaticArrayIterator() noexcept : base_type() {}
+        CONSTEXPR explicit StaticArrayIterator(container_base* container, pointer p) noexcept : base_type(container, p) {}
+#else
         CONSTEXPR StaticArrayIterator() noexcept : base_type(nullptr) {}
         CONSTEXPR explicit StaticArrayIterator(pointer p) noexcept : base_type(p) {}
+#endif // DEBUG_ITERATORS
 
         // mutable deref (casts away const from base implementation)
         NODISCARD CONSTEXPR reference operator*() const noexcept {
           return const_cast<reference>(base_type::operator*());
         }
         NODISCARD CONSTEXPR pointer operator->() const noexcept {
-          return this->_ptr;
+          return const_cast<pointer>(base_type::operator->());
         }
 
         // reuse base implementations for ++/-- and arithmetic via using / delegation
@@ -213,7 +249,7 @@ namespace voxory {
     }
 
     template<typename T, size_t N>
-    class static_array : detail::static_array_base<T> {
+    class static_array : detail::static_array_base<T>, container_base {
     public:
       using value_type = T;
       using pointer = T*;
@@ -228,6 +264,8 @@ namespace voxory {
       using const_iterator = detail::ConstStaticArrayIterator<detail::static_array_traits<value_type>>;
 
       ~static_array() {
+        // storage is inline: any iterator left over from here on dangles
+        _invalidate_iterators();
         _cleanup();
       };
 
@@ -250,27 +288,27 @@ namespace voxory {
       };
 
       NODISCARD CONSTEXPR iterator begin() noexcept {
-        return iterator(_pair.first);
+        return ITER_DEBUG_WRAP(iterator, _pair.first);
       };
 
       NODISCARD CONSTEXPR const_iterator begin() const noexcept {
-        return const_iterator(_pair.first);
+        return ITER_DEBUG_WRAP(const_iterator, _pair.first);
       };
 
       NODISCARD CONSTEXPR iterator end() noexcept {
-        return iterator(_pair.first + _capacity);
+        return ITER_DEBUG_WRAP(iterator, _pair.first + _capacity);
       };
 
       NODISCARD CONSTEXPR const_iterator end() const noexcept {
-        return const_iterator(_pair.first + _capacity);
+        return ITER_DEBUG_WRAP(const_iterator, _pair.first + _capacity);
       };
 
       NODISCARD CONSTEXPR const_iterator cend() const noexcept {
-        return const_iterator(_pair.first + _capacity);
+        return ITER_DEBUG_WRAP(const_iterator, _pair.first + _capacity);
       };
 
       NODISCARD CONSTEXPR const_iterator cbegin() const noexcept {
-        return const_iterator(_pair.first);
+        return ITER_DEBUG_WRAP(const_iterator, _pair.first);
       };
 
       CONSTEXPR static_array& operator=(const detail::static_array_base<value_type>& o) {
@@ -310,7 +348,7 @@ namespace voxory {
 
       NODISCARD CONSTEXPR const_reference operator[](size_type idx) const noexcept {
 #ifdef DEBUG
-        ASSERT_ABORT(idx >= _capacity, "static_array: out of range");
+        ASSERT_ABORT(idx < _capacity, "static_array: out of range");
 #endif // DEBUG_ITERATORS
         return data()[idx];
       };
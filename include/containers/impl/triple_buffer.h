@@ -0,0 +1,104 @@
+#pragma once
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <platform/platform.h>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace voxory {
+  namespace containers {
+    /**
+     * @brief Wait-free single-writer, single-reader "latest value" cell.
+     *
+     * @details Three copies of T: the writer owns one (back), the reader owns one (front) and the
+     *          third (middle) is handed over through one atomic byte that holds its index and a
+     *          "fresh" bit. publish() swaps back and middle; a reader that sees the fresh bit
+     *          swaps front and middle. Neither side ever waits for the other or takes a lock,
+     *          so a slow reader (UI thread) cannot stall the writer (inference thread) and
+     *          intermediate values the reader did not pick up are simply skipped.
+     *
+     *          Nothing is allocated after construction. A T that owns heap memory (std::string)
+     *          keeps its capacity across swaps, so steady-state updates of bounded size reuse it.
+     *
+     * @note After publish() the writer gets back whichever copy the reader released, i.e. an
+     *       older value; write the whole state, not a delta.
+     * @tparam T Default-constructible (or copy-constructible via the initial-value constructor).
+     */
+    template<typename T>
+    class triple_buffer {
+      static constexpr uint8_t index_mask = 0b011;
+      static constexpr uint8_t fresh_bit = 0b100;
+    public:
+      using value_type = T;
+
+      triple_buffer() noexcept(std::is_nothrow_default_constructible_v<T>)
+        : _middle(1), _back(0), _front(2) {}
+
+      /// All three copies start as initial.
+      explicit triple_buffer(const T& initial)
+        : _buffers{ _slot{ initial }, _slot{ initial }, _slot{ initial } }, _middle(1), _back(0), _front(2) {}
+
+      triple_buffer(const triple_buffer&) = delete;
+      triple_buffer& operator=(const triple_buffer&) = delete;
+
+      // --- writer ---
+
+      /// The copy the writer may modify; invisible to the reader until publish().
+      NODISCARD FORCE_INLINE T& write_buffer() noexcept { return _buffers[_back]._value; }
+
+      /// Makes write_buffer() the latest snapshot and hands the writer another copy.
+      FORCE_INLINE void publish() noexcept {
+        const uint8_t previous = _middle.exchange(static_cast<uint8_t>(_back | fresh_bit), std::memory_order_acq_rel);
+        _back = previous & index_mask;
+      }
+
+      /// Assigns value to write_buffer() and publishes it.
+      template<typename U>
+      void write(U&& value) {
+        write_buffer() = std::forward<U>(value);
+        publish();
+      }
+
+      // --- reader ---
+
+      /// True if a snapshot newer than read_buffer() has been published.
+      NODISCARD FORCE_INLINE bool has_update() const noexcept {
+        return (_middle.load(std::memory_order_relaxed) & fresh_bit) != 0;
+      }
+
+      /**
+       * @brief Takes the newest published snapshot, if any.
+       * @return True if read_buffer() changed.
+       */
+      FORCE_INLINE bool update() noexcept {
+        if (!has_update()) return false;
+        const uint8_t previous = _middle.exchange(_front, std::memory_order_acq_rel);
+        _front = previous & index_mask;
+        return true;
+      }
+
+      /// The latest complete snapshot; stays valid and unchanged until the next update() / read().
+      NODISCARD FORCE_INLINE const T& read() noexcept {
+        update();
+        return read_buffer();
+      }
+
+      /// The snapshot taken by the last update(), without looking for a newer one.
+      NODISCARD FORCE_INLINE const T& read_buffer() const noexcept { return _buffers[_front]._value; }
+
+    private:
+      // each copy on its own cache line: the writer filling back never invalidates front
+      struct alignas(64) _slot {
+        T _value{};
+      };
+
+      _slot _buffers[3];
+      alignas(64) std::atomic<uint8_t> _middle; // index of the shared copy | fresh_bit
+      alignas(64) uint8_t _back;                // writer only
+      alignas(64) uint8_t _front;               // reader only
+    };
+  } // namespace containers
+}
@@ -0,0 +1,139 @@
+#pragma once
+#include <inference/tuning_cache.h>
+#include <platform/cpu_topology.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "whisper.h"
+
+namespace voxory {
+  namespace inference {
+    struct tuner_options {
+      int max_threads = 0;             // upper bound of the sweep; 0: platform::hardware_threads()
+      std::vector<int> thread_counts;  // explicit sweep; empty: 1, 2, 4, ... and max_threads
+      bool try_flash_attn_off = true;  // also measure flash_attn = false
+      int decode_steps = 16;           // single-token decoder passes per measurement
+      int repeats = 2;                 // best of N per setting, after one warm-up
+      bool force = false;              // ignore a cached result
+      bool verbose = true;             // print the sweep to stderr
+    };
+
+    /**
+     * @brief Measures encoder and decoder latency of a model over thread counts and flash-attn.
+     *
+     * @details Runs the encoder on an empty 30 s mel and decode_steps single-token decoder
+     *          passes, like whisper.cpp's bench, and scores a setting by encode + decode time.
+     *          One context is loaded per flash-attn mode.
+     * @param cparams Context parameters to tune around; only flash_attn is varied.
+     * @return Best setting; n_threads stays 0 if the model could not be loaded.
+     */
+    inline tuned_params benchmark_whisper(const std::string& model_path, whisper_context_params cparams,
+                                          const tuner_options& options = {}) {
+      using clock = std::chrono::steady_clock;
+      auto ms_since = [](clock::time_point t) {
+        return std::chrono::duration<double, std::milli>(clock::now() - t).count();
+      };
+
+      int max_threads = options.max_threads > 0 ? options.max_threads : static_cast<int>(platform::hardware_threads());
+      std::vector<int> counts = options.thread_counts;
+      if (counts.empty()) {
+        for (int n = 1; n < max_threads; n *= 2) counts.push_back(n);
+        counts.push_back(max_threads);
+      }
+
+      std::vector<bool> modes{ true };
+      if (options.try_flash_attn_off) modes.push_back(false);
+
+      tuned_params best;
+      best.n_threads = 0;
+      double best_score = std::numeric_limits<double>::infinity();
+
+      for (bool flash : modes) {
+        cparams.flash_attn = flash;
+        whisper_context* ctx = whisper_init_from_file_with_params(model_path.c_str(), cparams);
+        if (ctx == nullptr) continue;
+
+        const int n_mels = whisper_model_n_mels(ctx);
+        std::vector<whisper_token> tokens(static_cast<std::size_t>(options.decode_steps), whisper_token_sot(ctx));
+
+        for (int n : counts) {
+          double encode_ms = std::numeric_limits<double>::infinity();
+          double decode_ms = std::numeric_limits<double>::infinity();
+          bool failed = false;
+          // first round warms caches and GPU kernels and is not counted
+          for (int round = 0; round <= options.repeats && !failed; ++round) {
+            if (whisper_set_mel(ctx, nullptr, 0, n_mels) != 0) {
+              failed = true;
+              break;
+            }
+            auto t0 = clock::now();
+            failed = whisper_encode(ctx, 0, n) != 0;
+            double enc = ms_since(t0);
+
+            t0 = clock::now();
+            for (int i = 0; i < options.decode_steps && !failed; ++i) {
+              failed = whisper_decode(ctx, tokens.data() + i, 1, i, n) != 0;
+            }
+            double dec = ms_since(t0);
+            if (round > 0) {
+              encode_ms = std::min(encode_ms, enc);
+              decode_ms = std::min(decode_ms, dec);
+            }
+          }
+          if (failed) continue;
+
+          if (options.verbose) {
+            std::fprintf(stderr, "tune: flash_attn=%d threads=%2d encode %8.1f ms decode %8.1f ms\n",
+              flash ? 1 : 0, n, encode_ms, decode_ms);
+          }
+          if (encode_ms + decode_ms < best_score) {
+            best_score = encode_ms + decode_ms;
+            best = { n, flash, encode_ms, decode_ms };
+          }
+        }
+        whisper_free(ctx);
+      }
+      return best;
+    }
+
+    /**
+     * @brief Returns the cached setting for this CPU, model and thread ceiling, or benchmarks and caches it.
+     *
+     * @param from_cache Set to true when no benchmark was run.
+     * @return Cached or measured setting; if benchmarking failed, max_threads threads and the
+     *         caller's flash_attn (not cached).
+     */
+    inline tuned_params load_or_tune(const std::string& model_path, const whisper_context_params& cparams,
+                                     const tuner_options& options = {},
+                                     const tuning_cache& cache = tuning_cache(),
+                                     bool* from_cache = nullptr) {
+      if (from_cache) *from_cache = false;
+      // the ceiling is part of the key: a result from a wider cpuset or affinity mask must not
+      // hand out more threads than the placement reserved
+      const int max_threads = options.max_threads > 0 ? options.max_threads : static_cast<int>(platform::hardware_threads());
+      tuning_key key{ platform::cpu_model_name(), model_fingerprint(model_path), cparams.use_gpu, max_threads };
+
+      if (!options.force && !key.model_hash.empty()) {
+        if (auto cached = cache.find(key)) {
+          if (from_cache) *from_cache = true;
+          cached->n_threads = std::min(cached->n_threads, max_threads);
+          return *cached;
+        }
+      }
+
+      tuned_params best = benchmark_whisper(model_path, cparams, options);
+      if (best.n_threads <= 0) {
+        tuned_params fallback;
+        fallback.n_threads = max_threads;
+        fallback.flash_attn = cparams.flash_attn;
+        return fallback;
+      }
+      if (!key.model_hash.empty()) (void)cache.store(key, best);
+      return best;
+    }
+  }
+}
@@ -0,0 +1,170 @@
+#pragma once
+#include <platform/platform.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace voxory {
+  namespace inference {
+    /// Inference settings picked by the auto-tuner for one machine and model.
+    struct tuned_params {
+      int n_threads = 1;
+      bool flash_attn = true;
+      double encode_ms = 0.0; // measured cost of one encoder pass
+      double decode_ms = 0.0; // measured cost of the benchmark's decode steps
+    };
+
+    /// Identifies what a tuning result is valid for.
+    struct tuning_key {
+      std::string cpu_model;  // platform::cpu_model_name()
+      std::string model_hash; // model_fingerprint()
+      bool use_gpu = false;
+      int max_threads = 0;    // sweep ceiling: the CPUs the process was allowed to use
+
+      NODISCARD bool operator==(const tuning_key&) const = default;
+    };
+
+    /**
+     * @brief Cheap identity of a model file: its size plus FNV-1a over its first, middle and
+     *        last MiB, in hex.
+     * @details Hashing a multi-GB model completely would cost seconds on every start; a
+     *          re-quantized or different model changes size or sampled bytes in practice.
+     * @return Empty string if the file cannot be read.
+     */
+    inline std::string model_fingerprint(const std::filesystem::path& model) {
+      std::error_code ec;
+      const uint64_t size = std::filesystem::file_size(model, ec);
+      if (ec) return {};
+      std::ifstream f(model, std::ios::binary);
+      if (!f) return {};
+
+      constexpr uint64_t sample = 1u << 20;
+      uint64_t hash = 14695981039346656037ull ^ size;
+      std::vector<char> buf(static_cast<std::size_t>(sample));
+      const uint64_t offsets[] = { 0, size > sample ? (size - sample) / 2 : 0, size > sample ? size - sample : 0 };
+      for (uint64_t off : offsets) {
+        f.clear();
+        f.seekg(static_cast<std::streamoff>(off));
+        f.read(buf.data(), static_cast<std::streamsize>(buf.size()));
+        std::streamsize got = f.gcount();
+        for (std::streamsize i = 0; i < got; ++i) {
+          hash ^= static_cast<unsigned char>(buf[static_cast<std::size_t>(i)]);
+          hash *= 1099511628211ull;
+        }
+      }
+
+      char out[40];
+      std::snprintf(out, sizeof(out), "%llx-%016llx", static_cast<unsigned long long>(size), static_cast<unsigned long long>(hash));
+      return out;
+    }
+
+    /**
+     * @brief Tuning results persisted as a tab-separated text file, one line per key.
+     *
+     * @details Line: cpu_model, model_hash, use_gpu, max_threads, n_threads, flash_attn, encode_ms,
+     *          decode_ms.
+     *          Unreadable lines are skipped; store() rewrites the file through a temporary and a
+     *          rename, so a crash never leaves it half-written.
+     */
+    class tuning_cache {
+    public:
+      explicit tuning_cache(std::filesystem::path file = default_path()) : _file(std::move(file)) {}
+
+      /// $XDG_CACHE_HOME or ~/.cache on POSIX, %LOCALAPPDATA% on Windows; then /voxory/tuning.tsv.
+      static std::filesystem::path default_path() {
+        std::filesystem::path base;
+#if defined(WINDOWS)
+        if (const char* local = std::getenv("LOCALAPPDATA")) base = local;
+#else
+        if (const char* xdg = std::getenv("XDG_CACHE_HOME")) base = xdg;
+        else if (const char* home = std::getenv("HOME")) base = std::filesystem::path(home) / ".cache";
+#endif
+        if (base.empty()) base = std::filesystem::temp_directory_path();
+        return base / "voxory" / "tuning.tsv";
+      }
+
+      NODISCARD const std::filesystem::path& path() const noexcept { return _file; }
+
+      NODISCARD std::optional<tuned_params> find(const tuning_key& key) const {
+        for (const auto& e : _load()) {
+          if (e.key == key) return e.params;
+        }
+        return std::nullopt;
+      }
+
+      /// Adds or replaces the entry for key; false if the file could not be written.
+      bool store(const tuning_key& key, const tuned_params& params) const {
+        std::vector<_entry> entries = _load();
+        bool replaced = false;
+        for (auto& e : entries) {
+          if (e.key == key) {
+            e.params = params;
+            replaced = true;
+          }
+        }
+        if (!replaced) entries.push_back({ key, params });
+
+        std::error_code ec;
+        std::filesystem::create_directories(_file.parent_path(), ec);
+        std::filesystem::path tmp = _file;
+        tmp += ".tmp";
+        {
+          std::ofstream out(tmp, std::ios::trunc);
+          if (!out) return false;
+          for (const auto& e : entries) {
+            out << e.key.cpu_model << '\t' << e.key.model_hash << '\t' << (e.key.use_gpu ? 1 : 0) << '\t' << e.key.max_threads << '\t'
+                << e.params.n_threads << '\t' << (e.params.flash_attn ? 1 : 0) << '\t'
+                << e.params.encode_ms << '\t' << e.params.decode_ms << '\n';
+          }
+          if (!out) return false;
+        }
+        std::filesystem::rename(tmp, _file, ec);
+        return !ec;
+      }
+
+    private:
+      struct _entry {
+        tuning_key key;
+        tuned_params params;
+      };
+
+      std::vector<_entry> _load() const {
+        std::vector<_entry> entries;
+        std::ifstream in(_file);
+        std::string line;
+        while (std::getline(in, line)) {
+          std::vector<std::string> fields;
+          std::stringstream ss(line);
+          std::string field;
+          while (std::getline(ss, field, '\t')) fields.push_back(field);
+          if (fields.size() != 8) continue;
+          try {
+            _entry e;
+            e.key.cpu_model = fields[0];
+            e.key.model_hash = fields[1];
+            e.key.use_gpu = fields[2] == "1";
+            e.key.max_threads = std::stoi(fields[3]);
+            e.params.n_threads = std::stoi(fields[4]);
+            e.params.flash_attn = fields[5] == "1";
+            e.params.encode_ms = std::stod(fields[6]);
+            e.params.decode_ms = std::stod(fields[7]);
+            if (e.params.n_threads > 0) entries.push_back(std::move(e));
+          }
+          catch (...) {
+            // skip malformed lines
+          }
+        }
+        return entries;
+      }
+
+      std::filesystem::path _file;
+    };
+  }
+}
@@ -0,0 +1,231 @@
+#pragma once
+#include <platform/platform.h>
+#include <platform/locked_memory.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+
+namespace voxory {
+  namespace memory {
+    /**
+     * @brief std::pmr::memory_resource over platform::allocate_locked().
+     * @note Meant as the upstream of a monotonic_arena, so scratch blocks are resident.
+     */
+    class locked_memory_resource final : public std::pmr::memory_resource {
+    public:
+      explicit locked_memory_resource(platform::memory_flags flags = platform::memory_flags::realtime) noexcept : _flags(flags) {}
+
+    private:
+      void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        if (alignment > platform::internal::page_size()) throw std::bad_alloc();
+        platform::locked_region r = platform::allocate_locked(bytes, _flags);
+        if (r.ptr == nullptr) throw std::bad_alloc();
+        return r.ptr;
+      }
+
+      void do_deallocate(void* p, std::size_t bytes, std::size_t) override {
+        platform::free_locked(p, bytes, _flags);
+      }
+
+      bool do_is_equal(const std::pmr::memory_resource& o) const noexcept override {
+        auto* other = dynamic_cast<const locked_memory_resource*>(&o);
+        return other != nullptr && other->_flags == _flags;
+      }
+
+      platform::memory_flags _flags;
+    };
+
+    /**
+     * @brief Bump allocator for per-window scratch memory.
+     *
+     * @details Allocation moves a pointer inside the current block; when a block runs out the
+     *          next retained block is used, and only if there is none a new one is requested
+     *          from upstream (each new block at least doubles the previous one).
+     *          deallocate() is a no-op. reset() rewinds to the first block in O(1) and keeps
+     *          every block, so once the arena has seen its peak window the loop never calls
+     *          the upstream (global heap) again; upstream_allocations() lets you check that.
+     *
+     * @note Not thread-safe. Pointers handed out before reset() must not be used after it.
+     */
+    class monotonic_arena final : public std::pmr::memory_resource {
+    public:
+      /**
+       * @param initial_size Size of the first block; allocated lazily.
+       * @param upstream     Source of blocks; defaults to the global heap.
+       */
+      explicit monotonic_arena(std::size_t initial_size = 64 * 1024,
+                               std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) noexcept
+        : _upstream(upstream), _next_size(initial_size < _min_block ? _min_block : initial_size) {}
+
+      /**
+       * @brief Uses a caller-provided buffer as the first block; it is never freed by the arena.
+       * @note buffer must be aligned to alignof(std::max_align_t).
+       */
+      monotonic_arena(void* buffer, std::size_t size,
+                      std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) noexcept
+        : monotonic_arena(size * 2, upstream) {
+        if (buffer != nullptr && size > sizeof(_block)) {
+          _block* b = ::new (buffer) _block{ nullptr, size - sizeof(_block), false };
+          _head = _tail = _current = b;
+          _cursor = b->begin();
+          _end = b->end();
+        }
+      }
+
+      monotonic_arena(const monotonic_arena&) = delete;
+      monotonic_arena& operator=(const monotonic_arena&) = delete;
+
+      ~monotonic_arena() override {
+        release();
+      }
+
+      /// Rewinds to the first block in O(1); all blocks are kept for reuse.
+      FORCE_INLINE void reset() noexcept {
+        _current = _head;
+        _cursor = _head ? _head->begin() : nullptr;
+        _end = _head ? _head->end() : nullptr;
+        _used_before_current = 0;
+      }
+
+      /// Returns every upstream block; the caller-provided buffer, if any, stays in use.
+      void release() noexcept {
+        _block* keep = (_head != nullptr && !_head->owned) ? _head : nullptr;
+        for (_block* b = keep ? keep->next : _head; b != nullptr;) {
+          _block* next = b->next;
+          _upstream->deallocate(b, sizeof(_block) + b->size, alignof(_block));
+          b = next;
+        }
+        _head = _tail = keep;
+        if (keep) keep->next = nullptr;
+        _capacity = 0;
+        reset();
+      }
+
+      /// Bytes handed out since the last reset (including alignment padding).
+      NODISCARD std::size_t bytes_used() const noexcept {
+        return _used_before_current + (_current ? static_cast<std::size_t>(_cursor - _current->begin()) : 0);
+      }
+
+      /// Bytes obtained from upstream and retained by the arena.
+      NODISCARD std::size_t capacity() const noexcept { return _capacity; }
+
+      /// Number of upstream allocations so far; constant in a steady-state loop.
+      NODISCARD std::size_t upstream_allocations() const noexcept { return _upstream_allocations; }
+
+      NODISCARD std::pmr::memory_resource* upstream() const noexcept { return _upstream; }
+
+    private:
+      struct alignas(std::max_align_t) _block {
+        _block* next;
+        std::size_t size; // usable bytes after the header
+        bool owned;
+
+        FORCE_INLINE std::byte* begin() noexcept { return reinterpret_cast<std::byte*>(this + 1); }
+        FORCE_INLINE std::byte* end() noexcept { return begin() + size; }
+      };
+
+      static constexpr std::size_t _min_block = 1024;
+
+      void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        if (void* p = _try_bump(bytes, alignment)) return p;
+        return _allocate_slow(bytes, alignment);
+      }
+
+      void do_deallocate(void*, std::size_t, std::size_t) noexcept override {}
+
+      bool do_is_equal(const std::pmr::memory_resource& o) const noexcept override {
+        return this == &o;
+      }
+
+      FORCE_INLINE void* _try_bump(std::size_t bytes, std::size_t alignment) noexcept {
+        if (_cursor == nullptr) return nullptr;
+        std::uintptr_t p = reinterpret_cast<std::uintptr_t>(_cursor);
+        std::uintptr_t aligned = (p + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+        if (aligned + bytes > reinterpret_cast<std::uintptr_t>(_end)) return nullptr;
+        _cursor = reinterpret_cast<std::byte*>(aligned + bytes);
+        return reinterpret_cast<void*>(aligned);
+      }
+
+      void* _allocate_slow(std::size_t bytes, std::size_t alignment) {
+        // walk the retained blocks first
+        while (_current != nullptr && _current->next != nullptr) {
+          _used_before_current += static_cast<std::size_t>(_cursor - _current->begin());
+          _current = _current->next;
+          _cursor = _current->begin();
+          _end = _current->end();
+          if (void* p = _try_bump(bytes, alignment)) return p;
+        }
+
+        std::size_t need = bytes + alignment;
+        std::size_t size = _next_size;
+        while (size < need) size *= 2;
+
+        void* raw = _upstream->allocate(sizeof(_block) + size, alignof(_block));
+        ++_upstream_allocations;
+        _capacity += size;
+        _next_size = size * 2;
+
+        _block* b = ::new (raw) _block{ nullptr, size, true };
+        if (_tail) _tail->next = b;
+        else _head = b;
+        _tail = b;
+
+        if (_current) _used_before_current += static_cast<std::size_t>(_cursor - _current->begin());
+        _current = b;
+        _cursor = b->begin();
+        _end = b->end();
+        return _try_bump(bytes, alignment);
+      }
+
+      std::pmr::memory_resource* _upstream;
+      _block* _head = nullptr;
+      _block* _tail = nullptr;
+      _block* _current = nullptr;
+      std::byte* _cursor = nullptr;
+      std::byte* _end = nullptr;
+      std::size_t _next_size;
+      std::size_t _capacity = 0;
+      std::size_t _used_before_current = 0;
+      std::size_t _upstream_allocations = 0;
+    };
+
+    /**
+     * @brief Standard allocator over a monotonic_arena, for the Alloc parameter of the containers.
+     *
+     * @note Equivalent to std::pmr::polymorphic_allocator bound to the arena, but without the
+     *       virtual call and it propagates on copy/move so containers keep pointing at one arena.
+     */
+    template<typename T>
+    class arena_allocator {
+    public:
+      using value_type = T;
+      using size_type = std::size_t;
+      using difference_type = std::ptrdiff_t;
+      using propagate_on_container_copy_assignment = std::true_type;
+      using propagate_on_container_move_assignment = std::true_type;
+      using propagate_on_container_swap = std::true_type;
+      using is_always_equal = std::false_type;
+
+      arena_allocator(monotonic_arena& arena) noexcept : _arena(&arena) {}
+      template<typename U>
+      arena_allocator(const arena_allocator<U>& o) noexcept : _arena(o.arena()) {}
+
+      NODISCARD T* allocate(size_type n) {
+        if (n > static_cast<size_type>(-1) / sizeof(T)) throw std::bad_array_new_length();
+        return static_cast<T*>(_arena->allocate(n * sizeof(T), alignof(T)));
+      }
+
+      void deallocate(T*, size_type) noexcept {}
+
+      NODISCARD monotonic_arena* arena() const noexcept { return _arena; }
+
+      template<typename U>
+      bool operator==(const arena_allocator<U>& o) const noexcept { return _arena == o.arena(); }
+
+    private:
+      monotonic_arena* _arena;
+    };
+  } // namespace memory
+} // namespace voxory
@@ -0,0 +1,147 @@
+#pragma once
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <platform/platform.h>
+#include <platform/locked_memory.h>
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+#if defined(LINUX) || defined(macOS)
+#include <sys/mman.h>
+#endif
+
+namespace voxory {
+  namespace memory {
+    /**
+     * @brief Allocator for large buffers that can grow without copying.
+     *
+     * @details Blocks below MinMappedBytes come from the aligned heap like aligned_allocator.
+     *          Larger blocks are page mappings that reallocate() resizes in place:
+     *          - Linux: mremap(MREMAP_MAYMOVE). The kernel moves page table entries, not bytes.
+     *          - Windows: address space for 4x the request (at least 256 MiB) is reserved up
+     *            front. Only the requested pages are committed, and growth commits more of the
+     *            reservation.
+     *          - macOS has neither, so reallocate() only succeeds when the page count does not
+     *            change.
+     *          The heap-or-mapping choice is a pure function of the element count, so
+     *          deallocate() must get the count that was allocated or last reallocated to.
+     *
+     * @note Blocks are at least 64 B aligned either way.
+     */
+    template<typename T, std::size_t MinMappedBytes = (std::size_t(1) << 20)>
+    class mapped_allocator {
+      static_assert(alignof(T) <= 64, "mapped_allocator supports alignment up to 64 B");
+    public:
+      using value_type = T;
+      using size_type = std::size_t;
+      using difference_type = std::ptrdiff_t;
+      using is_always_equal = std::true_type;
+      using propagate_on_container_move_assignment = std::true_type;
+
+      static constexpr std::size_t heap_alignment = 64;
+      static constexpr std::size_t min_mapped_bytes = MinMappedBytes;
+
+      template<typename U>
+      struct rebind {
+        using other = mapped_allocator<U, MinMappedBytes>;
+      };
+
+      CONSTEXPR mapped_allocator() noexcept = default;
+      template<typename U>
+      CONSTEXPR mapped_allocator(const mapped_allocator<U, MinMappedBytes>&) noexcept {}
+
+      NODISCARD T* allocate(size_type n) {
+        if (n > (static_cast<size_type>(-1) - heap_alignment) / sizeof(T)) throw std::bad_array_new_length();
+        if (!_is_mapped(n)) {
+          return static_cast<T*>(::operator new(_heap_bytes(n), std::align_val_t{ heap_alignment }));
+        }
+        void* p = _map(_mapped_bytes(n));
+        if (p == nullptr) throw std::bad_alloc();
+        return static_cast<T*>(p);
+      }
+
+      void deallocate(T* p, size_type n) noexcept {
+        if (p == nullptr) return;
+        if (!_is_mapped(n)) {
+          ::operator delete(p, _heap_bytes(n), std::align_val_t{ heap_alignment });
+          return;
+        }
+#if defined(WINDOWS)
+        VirtualFree(p, 0, MEM_RELEASE);
+#else
+        munmap(p, _mapped_bytes(n));
+#endif
+      }
+
+      /**
+       * @brief Resizes the block at p from old_n to new_n elements without copying them.
+       *
+       * @details Contents are kept up to min(old_n, new_n). The block may move (Linux), so the
+       *          caller must only use this for trivially relocatable elements.
+       * @return The resized block, or nullptr when a fresh allocate() and a copy are needed
+       *         (heap-backed sizes, exhausted reservation, no OS support); p is then untouched.
+       */
+      NODISCARD T* reallocate(T* p, size_type old_n, size_type new_n) noexcept {
+        if (p == nullptr || !_is_mapped(old_n) || !_is_mapped(new_n)) return nullptr;
+        if (new_n > (static_cast<size_type>(-1) - heap_alignment) / sizeof(T)) return nullptr;
+        const std::size_t old_bytes = _mapped_bytes(old_n);
+        const std::size_t new_bytes = _mapped_bytes(new_n);
+        if (old_bytes == new_bytes) return p;
+#if defined(LINUX) && defined(MREMAP_MAYMOVE)
+        void* q = mremap(p, old_bytes, new_bytes, MREMAP_MAYMOVE);
+        return q == MAP_FAILED ? nullptr : static_cast<T*>(q);
+#elif defined(WINDOWS)
+        char* base = reinterpret_cast<char*>(p);
+        if (new_bytes < old_bytes) {
+          VirtualFree(base + new_bytes, old_bytes - new_bytes, MEM_DECOMMIT);
+          return p;
+        }
+        MEMORY_BASIC_INFORMATION info{};
+        if (VirtualQuery(base + old_bytes, &info, sizeof(info)) == 0) return nullptr;
+        if (info.AllocationBase != base || info.State != MEM_RESERVE || info.RegionSize < new_bytes - old_bytes) return nullptr;
+        if (VirtualAlloc(base + old_bytes, new_bytes - old_bytes, MEM_COMMIT, PAGE_READWRITE) == nullptr) return nullptr;
+        return p;
+#else
+        return nullptr;
+#endif
+      }
+
+      template<typename U>
+      CONSTEXPR bool operator==(const mapped_allocator<U, MinMappedBytes>&) const noexcept { return true; }
+
+    private:
+      static CONSTEXPR FORCE_INLINE bool _is_mapped(size_type n) noexcept {
+        return n * sizeof(T) >= MinMappedBytes;
+      }
+
+      static CONSTEXPR FORCE_INLINE std::size_t _heap_bytes(size_type n) noexcept {
+        return (n * sizeof(T) + heap_alignment - 1) & ~(heap_alignment - 1);
+      }
+
+      static std::size_t _mapped_bytes(size_type n) noexcept {
+        return platform::internal::round_up(n * sizeof(T), platform::internal::page_size());
+      }
+
+      static void* _map(std::size_t bytes) noexcept {
+#if defined(WINDOWS)
+        // reserve room to grow into; address space is cheap on 64-bit
+        const std::size_t reserve = platform::internal::round_up(std::max(bytes * 4, std::size_t(256) << 20), std::size_t(64) << 10);
+        void* base = VirtualAlloc(nullptr, reserve, MEM_RESERVE, PAGE_NOACCESS);
+        if (base == nullptr) base = VirtualAlloc(nullptr, bytes, MEM_RESERVE, PAGE_NOACCESS);
+        if (base == nullptr) return nullptr;
+        if (VirtualAlloc(base, bytes, MEM_COMMIT, PAGE_READWRITE) == nullptr) {
+          VirtualFree(base, 0, MEM_RELEASE);
+          return nullptr;
+        }
+        return base;
+#else
+        void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        return p == MAP_FAILED ? nullptr : p;
+#endif
+      }
+    };
+  }
+}
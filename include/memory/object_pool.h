@@ -0,0 +1,295 @@
+#pragma once
+#include <platform/platform.h>
+#include <multithreading/spin_lock.h>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace voxory {
+  namespace memory {
+    namespace internal {
+      // one thread's cache for one pool; the chain is only touched by the owning thread
+      struct pool_cache_entry {
+        uint64_t pool_id = 0;
+        std::weak_ptr<void> state;  // expired once the pool is gone: the chain is then dropped
+        void* head = nullptr;
+        uint32_t count = 0;
+        void (*flush)(pool_cache_entry&) noexcept = nullptr;
+      };
+
+      // a few pools per thread cover the pipeline; the least recently added entry is evicted
+      struct pool_cache_table {
+        static constexpr std::size_t size = 8;
+        pool_cache_entry entries[size];
+        std::size_t next_victim = 0;
+
+        ~pool_cache_table() {
+          for (pool_cache_entry& e : entries) {
+            if (e.flush) e.flush(e);
+          }
+        }
+      };
+
+      inline thread_local pool_cache_table tls_pool_caches;
+      inline std::atomic<uint64_t> next_pool_id{ 1 };
+    }
+
+    /**
+     * @brief Thread-safe pool of reusable T objects with per-thread caches.
+     *
+     * @details Objects are default-constructed in blocks (each block doubles the last) and are
+     *          never destroyed until the pool is: a recycled std::string or std::vector keeps its
+     *          capacity, so a steady-state result path does not touch the heap at all.
+     *
+     *          acquire() and recycling go through a small cache owned by the calling thread
+     *          (no atomics). A cache that runs dry takes a whole batch from the global free list,
+     *          and a cache that overflows gives half of itself back, each with one CAS. The global
+     *          list is a Treiber stack of batches whose head packs a 32-bit node index with a
+     *          32-bit tag against ABA. A handle may be released on any thread; its object joins
+     *          that thread's cache. A thread that exits returns its caches to their pools.
+     *
+     * @note Objects come back in whatever state their last user left them; overwrite them.
+     *       Every handle must be released before the pool is destroyed.
+     * @tparam T Default-constructible.
+     */
+    template<typename T>
+    class object_pool {
+      struct _node;
+      struct _pool_state;
+    public:
+      static constexpr uint32_t cache_capacity = 32;            // per thread and pool
+      static constexpr uint32_t batch_size = cache_capacity / 2; // moved per global list operation
+
+      /// Owning reference to a pooled object; returns it to the pool on destruction.
+      class handle {
+      public:
+        handle() noexcept = default;
+        handle(const handle&) = delete;
+        handle& operator=(const handle&) = delete;
+        handle(handle&& o) noexcept : _pool(std::exchange(o._pool, nullptr)), _object(std::exchange(o._object, nullptr)) {}
+        handle& operator=(handle&& o) noexcept {
+          if (this != &o) {
+            reset();
+            _pool = std::exchange(o._pool, nullptr);
+            _object = std::exchange(o._object, nullptr);
+          }
+          return *this;
+        }
+        ~handle() { reset(); }
+
+        /// Returns the object to the pool now.
+        void reset() noexcept {
+          if (_object != nullptr) {
+            _pool->_recycle(_object);
+            _object = nullptr;
+            _pool = nullptr;
+          }
+        }
+
+        NODISCARD FORCE_INLINE T* get() const noexcept { return _object ? &_object->value : nullptr; }
+        NODISCARD FORCE_INLINE T& operator*() const noexcept { return _object->value; }
+        NODISCARD FORCE_INLINE T* operator->() const noexcept { return &_object->value; }
+        NODISCARD explicit operator bool() const noexcept { return _object != nullptr; }
+
+      private:
+        friend class object_pool;
+        handle(object_pool* pool, _node* node) noexcept : _pool(pool), _object(node) {}
+
+        object_pool* _pool = nullptr;
+        _node* _object = nullptr;
+      };
+
+      /// @param initial_capacity Objects constructed up front (rounded up to a power of two).
+      explicit object_pool(std::size_t initial_capacity = 64)
+        : _state(std::make_shared<_pool_state>(std::bit_ceil(std::max<std::size_t>(initial_capacity, cache_capacity)))),
+          _id(internal::next_pool_id.fetch_add(1, std::memory_order_relaxed)) {
+        std::lock_guard<multithreading::spin_lock> lock(_state->grow_lock);
+        _state->grow();
+      }
+
+      object_pool(const object_pool&) = delete;
+      object_pool& operator=(const object_pool&) = delete;
+
+      ~object_pool() {
+        // this thread's cache entry only holds a weak reference; clear it so the slot is free
+        for (internal::pool_cache_entry& e : internal::tls_pool_caches.entries) {
+          if (e.pool_id == _id) e = internal::pool_cache_entry{};
+        }
+      }
+
+      /// Takes an object from the pool, constructing a new block of them if none is free.
+      NODISCARD handle acquire() {
+        internal::pool_cache_entry& e = _cache();
+        if (e.head == nullptr) _refill(e);
+        _node* n = static_cast<_node*>(e.head);
+        e.head = n->next;
+        --e.count;
+        return handle(this, n);
+      }
+
+      /// Objects constructed so far (in use, cached or free).
+      NODISCARD std::size_t capacity() const noexcept { return _state->capacity.load(std::memory_order_relaxed); }
+      /// Blocks obtained from the heap so far; constant in a steady state.
+      NODISCARD std::size_t blocks() const noexcept { return _state->block_count.load(std::memory_order_relaxed); }
+
+    private:
+      struct _node {
+        T value{};
+        _node* next = nullptr;                  // within a thread cache or a batch
+        std::atomic<uint32_t> batch_next{ 0 };  // next batch in the global list (index + 1, 0 = none)
+        uint32_t batch_count = 0;               // nodes in the batch this node heads
+        uint32_t index = 0;
+      };
+
+      struct _pool_state {
+        static constexpr std::size_t max_blocks = 32;
+
+        explicit _pool_state(std::size_t base) noexcept : base_shift(static_cast<uint32_t>(std::countr_zero(base))) {}
+
+        ~_pool_state() {
+          for (std::size_t b = 0; b < max_blocks && blocks[b] != nullptr; ++b) {
+            const std::size_t n = block_nodes(b);
+            for (std::size_t i = 0; i < n; ++i) blocks[b][i].~_node();
+            ::operator delete(static_cast<void*>(blocks[b]), n * sizeof(_node), std::align_val_t{ alignof(_node) });
+          }
+        }
+
+        FORCE_INLINE std::size_t block_nodes(std::size_t b) const noexcept { return std::size_t(1) << (base_shift + b); }
+
+        // block b holds indices [base * (2^b - 1), base * (2^(b+1) - 1))
+        FORCE_INLINE _node* node_at(uint32_t index) const noexcept {
+          const uint64_t scaled = (uint64_t(index) >> base_shift) + 1;
+          const std::size_t b = static_cast<std::size_t>(std::bit_width(scaled) - 1);
+          const uint64_t first = ((uint64_t(1) << b) - 1) << base_shift;
+          return blocks[b] + (index - first);
+        }
+
+        void push_batch(_node* first, uint32_t count) noexcept {
+          first->batch_count = count;
+          uint64_t head = free_head.load(std::memory_order_relaxed);
+          uint64_t desired;
+          do {
+            first->batch_next.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+            desired = ((head >> 32) + 1) << 32 | (uint64_t(first->index) + 1);
+          } while (!free_head.compare_exchange_weak(head, desired, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        _node* pop_batch() noexcept {
+          uint64_t head = free_head.load(std::memory_order_acquire);
+          for (;;) {
+            const uint32_t top = static_cast<uint32_t>(head);
+            if (top == 0) return nullptr;
+            _node* first = node_at(top - 1);
+            // may read a recycled node's link; the tag then makes the CAS fail
+            const uint64_t desired = ((head >> 32) + 1) << 32 | first->batch_next.load(std::memory_order_relaxed);
+            if (free_head.compare_exchange_weak(head, desired, std::memory_order_acquire, std::memory_order_acquire)) return first;
+          }
+        }
+
+        // constructs the next block and pushes it as batches; caller holds grow_lock
+        void grow() {
+          const std::size_t b = block_count.load(std::memory_order_relaxed);
+          const std::size_t n = block_nodes(b);
+          const uint64_t first_index = ((uint64_t(1) << b) - 1) << base_shift;
+          if (b == max_blocks || first_index + n > UINT32_MAX) throw std::bad_alloc();
+
+          _node* nodes = static_cast<_node*>(::operator new(n * sizeof(_node), std::align_val_t{ alignof(_node) }));
+          std::size_t built = 0;
+          try {
+            for (; built < n; ++built) ::new (static_cast<void*>(nodes + built)) _node();
+          }
+          catch (...) {
+            for (std::size_t i = 0; i < built; ++i) nodes[i].~_node();
+            ::operator delete(static_cast<void*>(nodes), n * sizeof(_node), std::align_val_t{ alignof(_node) });
+            throw;
+          }
+          for (std::size_t i = 0; i < n; ++i) {
+            nodes[i].index = static_cast<uint32_t>(first_index + i);
+            nodes[i].next = (i + 1) % batch_size == 0 || i + 1 == n ? nullptr : nodes + i + 1;
+          }
+          blocks[b] = nodes;
+          block_count.store(b + 1, std::memory_order_relaxed);
+          capacity.fetch_add(n, std::memory_order_relaxed);
+          for (std::size_t i = 0; i < n; i += batch_size) {
+            push_batch(nodes + i, static_cast<uint32_t>(std::min<std::size_t>(batch_size, n - i)));
+          }
+        }
+
+        alignas(64) std::atomic<uint64_t> free_head{ 0 }; // tag << 32 | (index of first batch node + 1)
+        alignas(64) multithreading::spin_lock grow_lock;
+        _node* blocks[max_blocks] = {};
+        std::atomic<std::size_t> block_count{ 0 };
+        std::atomic<std::size_t> capacity{ 0 };
+        const uint32_t base_shift;
+      };
+
+      // the calling thread's cache entry for this pool, created on first use
+      internal::pool_cache_entry& _cache() noexcept {
+        internal::pool_cache_table& table = internal::tls_pool_caches;
+        for (internal::pool_cache_entry& e : table.entries) {
+          if (e.pool_id == _id) [[likely]] return e;
+        }
+        internal::pool_cache_entry* slot = nullptr;
+        for (internal::pool_cache_entry& e : table.entries) {
+          if (e.pool_id == 0 || e.state.expired()) {
+            slot = &e;
+            break;
+          }
+        }
+        if (slot == nullptr) {
+          slot = &table.entries[table.next_victim];
+          table.next_victim = (table.next_victim + 1) % internal::pool_cache_table::size;
+          if (slot->flush) slot->flush(*slot);
+        }
+        *slot = internal::pool_cache_entry{ _id, _state, nullptr, 0, &_flush_entry };
+        return *slot;
+      }
+
+      void _refill(internal::pool_cache_entry& e) {
+        _node* batch = _state->pop_batch();
+        if (batch == nullptr) {
+          std::lock_guard<multithreading::spin_lock> lock(_state->grow_lock);
+          batch = _state->pop_batch(); // another thread may have grown it meanwhile
+          if (batch == nullptr) {
+            _state->grow();
+            batch = _state->pop_batch();
+          }
+        }
+        e.head = batch;
+        e.count = batch->batch_count;
+      }
+
+      void _recycle(_node* n) noexcept {
+        internal::pool_cache_entry& e = _cache();
+        n->next = static_cast<_node*>(e.head);
+        e.head = n;
+        if (++e.count < cache_capacity) return;
+        // give the most recently used half back; keep the rest warm
+        _node* first = n;
+        _node* last = n;
+        for (uint32_t i = 1; i < batch_size; ++i) last = last->next;
+        e.head = last->next;
+        e.count -= batch_size;
+        last->next = nullptr;
+        _state->push_batch(first, batch_size);
+      }
+
+      static void _flush_entry(internal::pool_cache_entry& e) noexcept {
+        if (std::shared_ptr<_pool_state> state = std::static_pointer_cast<_pool_state>(e.state.lock())) {
+          if (e.head != nullptr) state->push_batch(static_cast<_node*>(e.head), e.count);
+        }
+        e = internal::pool_cache_entry{};
+      }
+
+      std::shared_ptr<_pool_state> _state;
+      uint64_t _id;
+    };
+  }
+}
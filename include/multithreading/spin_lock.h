@@ -1,41 +1,154 @@
-#pragma once 
+#pragma once
 #include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
 #include <platform/platform.h>
 
 namespace voxory {
   namespace multithreading {
-    class spin_lock {
-    public:
-      spin_lock() noexcept {}
+    /// Contention counters of a basic_spin_lock; all values are approximate (relaxed).
+    struct lock_stats {
+      std::atomic<uint64_t> acquisitions{ 0 };
+      std::atomic<uint64_t> contended{ 0 }; // acquisitions that did not succeed on the first try
+      std::atomic<uint64_t> parked{ 0 };    // acquisitions that had to sleep in the kernel
+      std::atomic<uint64_t> wait_ns{ 0 };   // time spent spinning or parked before acquiring
+
+      void reset() noexcept {
+        acquisitions.store(0, std::memory_order_relaxed);
+        contended.store(0, std::memory_order_relaxed);
+        parked.store(0, std::memory_order_relaxed);
+        wait_ns.store(0, std::memory_order_relaxed);
+      }
+    };
 
-      spin_lock(const spin_lock&) = delete;
-      spin_lock& operator=(const spin_lock& o) {
-        if (this == std::addressof(o)) return *this;
-        flag_._Storage.store(o.flag_.test(), std::memory_order_seq_cst);
-        return *this;
+    namespace lock_policy {
+      /// No counters; the lock is a single 32-bit word.
+      struct no_stats {
+        static constexpr bool enabled = false;
       };
 
-      spin_lock(spin_lock&&) noexcept {}
-      spin_lock& operator=(spin_lock&& o) noexcept { 
-        if (this == std::addressof(o)) return *this;
-        flag_._Storage.store(o.flag_.test(), std::memory_order_seq_cst);
-        return *this; 
-      }
+      /// Keeps a lock_stats next to the lock.
+      struct with_stats {
+        static constexpr bool enabled = true;
+      };
+    }
+
+    /**
+     * @brief Spin-then-park mutex.
+     *
+     * @details The uncontended path is one CAS to lock and one exchange to unlock.
+     *          A contended lock() spins on a plain load with exponential backoff
+     *          (1, 2, 4 ... max_backoff pause instructions per round, spin_rounds rounds),
+     *          which covers short critical sections without a syscall. After that the thread
+     *          parks on the lock word with std::atomic::wait (futex on Linux,
+     *          WaitOnAddress on Windows), so an oversubscribed waiter stops burning the core
+     *          the holder needs. unlock() only wakes someone if a waiter announced itself.
+     *
+     *          State: 0 unlocked, 1 locked, 2 locked and a thread may be parked.
+     *
+     * @tparam StatsPolicy lock_policy::no_stats or lock_policy::with_stats.
+     */
+    template<typename StatsPolicy = lock_policy::no_stats>
+    class basic_spin_lock {
+      struct _empty_stats {};
+      using stats_type = std::conditional_t<StatsPolicy::enabled, lock_stats, _empty_stats>;
+    public:
+      static constexpr uint32_t spin_rounds = 10;
+      static constexpr uint32_t max_backoff = 64;
+
+      basic_spin_lock() noexcept : _state(0) {}
+
+      basic_spin_lock(const basic_spin_lock&) = delete;
+      basic_spin_lock& operator=(const basic_spin_lock&) = delete;
+
+      // a lock is not a value: a moved-to lock is a fresh unlocked one,
+      // so objects that own a lock stay movable
+      basic_spin_lock(basic_spin_lock&&) noexcept : _state(0) {}
+      basic_spin_lock& operator=(basic_spin_lock&&) noexcept { return *this; }
 
-      ~spin_lock() noexcept = default;
+      ~basic_spin_lock() noexcept = default;
 
-      void lock() noexcept {
-        while (flag_.test_and_set(std::memory_order_acquire)) {
-          mm_pause();
+      FORCE_INLINE void lock() noexcept {
+        uint32_t expected = 0;
+        if (_state.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed)) [[likely]] {
+          if constexpr (StatsPolicy::enabled) _stats.acquisitions.fetch_add(1, std::memory_order_relaxed);
+          return;
         }
+        _lock_contended();
       }
 
-      void unlock() noexcept {
-        flag_.clear(std::memory_order_release);
+      NODISCARD FORCE_INLINE bool try_lock() noexcept {
+        uint32_t expected = 0;
+        bool ok = _state.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed);
+        if constexpr (StatsPolicy::enabled) {
+          if (ok) _stats.acquisitions.fetch_add(1, std::memory_order_relaxed);
+        }
+        return ok;
       }
 
+      FORCE_INLINE void unlock() noexcept {
+        if (_state.exchange(0, std::memory_order_release) == 2) [[unlikely]] {
+          _state.notify_one();
+        }
+      }
+
+      NODISCARD bool is_locked() const noexcept { return _state.load(std::memory_order_relaxed) != 0; }
+
+      /// Counters; only available with lock_policy::with_stats.
+      NODISCARD const lock_stats& stats() const noexcept requires (StatsPolicy::enabled) { return _stats; }
+      void reset_stats() noexcept requires (StatsPolicy::enabled) { _stats.reset(); }
+
     private:
-      std::atomic_flag flag_;
+      // slow path; not FORCE_INLINE so lock() stays a single CAS at the call site
+      void _lock_contended() noexcept {
+        [[maybe_unused]] std::chrono::steady_clock::time_point start;
+        if constexpr (StatsPolicy::enabled) start = std::chrono::steady_clock::now();
+
+        bool parked = false;
+        uint32_t backoff = 1;
+        for (uint32_t round = 0; round < spin_rounds; ++round) {
+          for (uint32_t i = 0; i < backoff; ++i) mm_pause();
+          if (backoff < max_backoff) backoff <<= 1;
+          // test before test-and-set: waiters share the line instead of bouncing it
+          uint32_t s = _state.load(std::memory_order_relaxed);
+          if (s == 0) {
+            uint32_t expected = 0;
+            if (_state.compare_exchange_weak(expected, 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+              _count_contended(start, parked);
+              return;
+            }
+          }
+          else if (s == 2) {
+            break; // someone is already parked; spinning longer will not help
+          }
+        }
+
+        // announce a waiter; whoever unlocks now has to wake one of us.
+        // Taking the lock here leaves it in state 2, which at worst costs one spurious notify.
+        while (_state.exchange(2, std::memory_order_acquire) != 0) {
+          parked = true;
+          _state.wait(2, std::memory_order_relaxed);
+        }
+        _count_contended(start, parked);
+      }
+
+      FORCE_INLINE void _count_contended([[maybe_unused]] std::chrono::steady_clock::time_point start,
+                                         [[maybe_unused]] bool parked) noexcept {
+        if constexpr (StatsPolicy::enabled) {
+          auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+          _stats.acquisitions.fetch_add(1, std::memory_order_relaxed);
+          _stats.contended.fetch_add(1, std::memory_order_relaxed);
+          if (parked) _stats.parked.fetch_add(1, std::memory_order_relaxed);
+          _stats.wait_ns.fetch_add(static_cast<uint64_t>(ns), std::memory_order_relaxed);
+        }
+      }
+
+      std::atomic<uint32_t> _state;
+      NO_UNIQUE_ADDRESS stats_type _stats;
     };
+
+    using spin_lock = basic_spin_lock<lock_policy::no_stats>;
+    using counted_spin_lock = basic_spin_lock<lock_policy::with_stats>;
   };
-}
\ No newline at end of file
+}
@@ -0,0 +1,370 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <platform/platform.h>
+#include <platform/thread_affinity.h>
+#include <multithreading/spin_lock.h>
+#include <multithreading/work_stealing_deque.h>
+#include <containers/impl/ring_buffer.h>
+
+namespace voxory {
+  namespace multithreading {
+    /// Tasks of a higher priority are always taken before lower ones, pool-wide.
+    enum class task_priority : uint8_t {
+      high = 0,   // latency-bound stages (capture hand-off, streaming decode)
+      normal = 1,
+      low = 2     // batch files, background transcription
+    };
+
+    inline constexpr std::size_t task_priority_count = 3;
+
+    struct thread_pool_options {
+      std::size_t threads = 0;      // 0: one per logical CPU
+      bool pin_threads = false;     // pin worker i to cpus[i % cpus.size()], or to CPU i if cpus is empty
+      std::vector<unsigned> cpus;
+      std::size_t deque_capacity = 256; // initial per-worker deque size; deques grow on demand
+    };
+
+    namespace detail {
+      struct pool_task {
+        std::move_only_function<void()> fn;
+        task_priority priority;
+      };
+
+      // which pool and worker the current thread belongs to
+      struct worker_context {
+        const void* pool = nullptr;
+        std::size_t index = 0;
+      };
+
+      inline thread_local worker_context tls_worker;
+    }
+
+    /**
+     * @brief Work-stealing executor shared by pipeline stages and batch jobs.
+     *
+     * @details Every worker owns one Chase-Lev deque per priority. Work submitted from a worker
+     *          goes to its own deque (LIFO, cache-warm); work submitted from other threads goes
+     *          to a small locked injection queue. An idle worker takes, per priority from high to
+     *          low: its own deque, the injection queue, then steals the oldest task of another
+     *          worker. Workers with nothing to do spin briefly and then sleep on an atomic; a
+     *          submit wakes one sleeper only when somebody sleeps.
+     *
+     *          Waiting for work (task_group::wait, parallel_for) runs pending tasks on the waiting
+     *          thread, so nested parallelism from inside a task cannot starve the pool.
+     *
+     * @note An exception escaping a task passed to submit() terminates the program, as it would
+     *       in a std::thread; use task_group to propagate exceptions.
+     */
+    class thread_pool {
+    public:
+      explicit thread_pool(thread_pool_options options = {})
+        : _options(std::move(options)) {
+        std::size_t n = _options.threads ? _options.threads : platform::hardware_threads();
+        _workers.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+          _workers.push_back(std::make_unique<_worker>(_options.deque_capacity));
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+          _workers[i]->thread = std::thread([this, i] { _run_worker(i); });
+        }
+      }
+
+      thread_pool(const thread_pool&) = delete;
+      thread_pool& operator=(const thread_pool&) = delete;
+
+      /// Runs every task already queued, then joins the workers.
+      ~thread_pool() {
+        _stopping.store(true, std::memory_order_seq_cst);
+        _wake(true);
+        for (auto& w : _workers) {
+          if (w->thread.joinable()) w->thread.join();
+        }
+      }
+
+      /// Process-wide pool with one worker per logical CPU, created on first use.
+      static thread_pool& shared() {
+        static thread_pool pool;
+        return pool;
+      }
+
+      /// Queues fn; never blocks.
+      template<typename F>
+      void submit(F&& fn, task_priority priority = task_priority::normal) {
+        auto* task = new detail::pool_task{ std::move_only_function<void()>(std::forward<F>(fn)), priority };
+        std::size_t p = static_cast<std::size_t>(priority);
+        _pending[p].fetch_add(1, std::memory_order_seq_cst);
+
+        if (detail::tls_worker.pool == this) {
+          _workers[detail::tls_worker.index]->deques[p].push(task);
+        }
+        else {
+          std::lock_guard<spin_lock> guard(_injected_lock);
+          _injected[p].push_back(task);
+        }
+        _wake(false);
+      }
+
+      /**
+       * @brief Runs one queued task on the calling thread, if there is any.
+       * @return False if nothing was found (the pool may still be busy).
+       */
+      bool run_one() {
+        detail::pool_task* task = _find_task(detail::tls_worker.pool == this ? detail::tls_worker.index : _no_worker);
+        if (task == nullptr) return false;
+        _execute(task);
+        return true;
+      }
+
+      NODISCARD std::size_t size() const noexcept { return _workers.size(); }
+
+      /// Index of the calling worker in this pool, or -1 for other threads.
+      NODISCARD int current_worker() const noexcept {
+        return detail::tls_worker.pool == this ? static_cast<int>(detail::tls_worker.index) : -1;
+      }
+
+      /// Tasks queued and not yet started; approximate.
+      NODISCARD std::size_t pending() const noexcept {
+        std::size_t total = 0;
+        for (auto& p : _pending) total += p.load(std::memory_order_seq_cst);
+        return total;
+      }
+
+    private:
+      static constexpr std::size_t _no_worker = static_cast<std::size_t>(-1);
+      static constexpr uint32_t _idle_spins = 64;
+
+      using _injection_queue = containers::ring_buffer<detail::pool_task*, std::allocator<detail::pool_task*>,
+                                                       containers::ring_policy::dynamic_capacity,
+                                                       containers::ring_policy::overflow_grow>;
+
+      struct _worker {
+        explicit _worker(std::size_t capacity)
+          : deques{ work_stealing_deque<detail::pool_task*>(capacity),
+                    work_stealing_deque<detail::pool_task*>(capacity),
+                    work_stealing_deque<detail::pool_task*>(capacity) } {}
+
+        std::array<work_stealing_deque<detail::pool_task*>, task_priority_count> deques;
+        std::thread thread;
+      };
+
+      void _run_worker(std::size_t index) {
+        detail::tls_worker = { this, index };
+        if (_options.pin_threads) {
+          unsigned cpu = _options.cpus.empty()
+            ? static_cast<unsigned>(index % platform::hardware_threads())
+            : _options.cpus[index % _options.cpus.size()];
+          (void)platform::pin_current_thread(cpu); // best-effort
+        }
+
+        uint32_t idle = 0;
+        for (;;) {
+          if (detail::pool_task* task = _find_task(index)) {
+            _execute(task);
+            idle = 0;
+            continue;
+          }
+          if (_stopping.load(std::memory_order_acquire) && pending() == 0) break;
+          if (++idle < _idle_spins) {
+            mm_pause();
+            continue;
+          }
+          _sleep();
+          idle = 0;
+        }
+        detail::tls_worker = {};
+      }
+
+      // pairs with _wake(): either the sleeper sees the pending task or the submitter sees the sleeper
+      void _sleep() {
+        uint32_t epoch = _epoch.load(std::memory_order_seq_cst);
+        _sleeping.fetch_add(1, std::memory_order_seq_cst);
+        if (pending() == 0 && !_stopping.load(std::memory_order_seq_cst)) {
+          _epoch.wait(epoch, std::memory_order_seq_cst);
+        }
+        _sleeping.fetch_sub(1, std::memory_order_relaxed);
+      }
+
+      void _wake(bool all) {
+        if (!all && _sleeping.load(std::memory_order_seq_cst) == 0) return;
+        _epoch.fetch_add(1, std::memory_order_seq_cst);
+        if (all) _epoch.notify_all();
+        else _epoch.notify_one();
+      }
+
+      detail::pool_task* _find_task(std::size_t self) {
+        for (std::size_t p = 0; p < task_priority_count; ++p) {
+          if (_pending[p].load(std::memory_order_relaxed) == 0) continue;
+          if (detail::pool_task* task = _find_task(self, p)) {
+            _pending[p].fetch_sub(1, std::memory_order_relaxed);
+            return task;
+          }
+        }
+        return nullptr;
+      }
+
+      detail::pool_task* _find_task(std::size_t self, std::size_t p) {
+        if (self != _no_worker) {
+          if (auto t = _workers[self]->deques[p].pop()) return *t;
+        }
+        {
+          std::lock_guard<spin_lock> guard(_injected_lock);
+          if (auto t = _injected[p].try_pop_front()) return *t;
+        }
+        // start at a different victim per thief so they do not all hit worker 0
+        std::size_t n = _workers.size();
+        std::size_t start = self == _no_worker ? _steal_cursor.fetch_add(1, std::memory_order_relaxed) : self + 1;
+        for (std::size_t k = 0; k < n; ++k) {
+          std::size_t victim = (start + k) % n;
+          if (victim == self) continue;
+          if (auto t = _workers[victim]->deques[p].steal()) return *t;
+        }
+        return nullptr;
+      }
+
+      static void _execute(detail::pool_task* task) noexcept {
+        std::unique_ptr<detail::pool_task> owned(task);
+        owned->fn();
+      }
+
+      thread_pool_options _options;
+      std::vector<std::unique_ptr<_worker>> _workers;
+
+      spin_lock _injected_lock;
+      std::array<_injection_queue, task_priority_count> _injected{ _injection_queue(64), _injection_queue(64), _injection_queue(64) };
+
+      std::array<std::atomic<std::size_t>, task_priority_count> _pending{};
+      std::atomic<std::size_t> _steal_cursor{ 0 };
+      alignas(64) std::atomic<uint32_t> _epoch{ 0 };
+      std::atomic<uint32_t> _sleeping{ 0 };
+      std::atomic<bool> _stopping{ false };
+    };
+
+    /**
+     * @brief Set of tasks that can be waited for together.
+     *
+     * @details wait() helps the pool run tasks while the group is unfinished, so it is safe to
+     *          call from a worker. The first exception thrown by a task is rethrown by wait().
+     */
+    class task_group {
+    public:
+      explicit task_group(thread_pool& pool = thread_pool::shared()) noexcept : _pool(pool) {}
+
+      task_group(const task_group&) = delete;
+      task_group& operator=(const task_group&) = delete;
+
+      ~task_group() {
+        _wait_no_throw();
+      }
+
+      template<typename F>
+      void run(F&& fn, task_priority priority = task_priority::normal) {
+        _outstanding.fetch_add(1, std::memory_order_relaxed);
+        _pool.submit([this, f = std::forward<F>(fn)]() mutable {
+          // announced before the decrement, so wait() cannot return (and the group die)
+          // while the last task is still inside notify_all()
+          _notifying.fetch_add(1, std::memory_order_relaxed);
+          try {
+            f();
+          }
+          catch (...) {
+            std::lock_guard<spin_lock> guard(_error_lock);
+            if (!_error) _error = std::current_exception();
+          }
+          if (_outstanding.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            _outstanding.notify_all();
+          }
+          _notifying.fetch_sub(1, std::memory_order_release);
+        }, priority);
+      }
+
+      /// Blocks until every task of the group finished; rethrows the first task exception.
+      void wait() {
+        _wait_no_throw();
+        std::exception_ptr e;
+        {
+          std::lock_guard<spin_lock> guard(_error_lock);
+          std::swap(e, _error);
+        }
+        if (e) std::rethrow_exception(e);
+      }
+
+    private:
+      void _wait_no_throw() {
+        for (;;) {
+          std::size_t left = _outstanding.load(std::memory_order_acquire);
+          if (left == 0) {
+            while (_notifying.load(std::memory_order_acquire) != 0) mm_pause();
+            return;
+          }
+          if (_pool.run_one()) continue;
+          // nothing to help with: the remaining tasks are running elsewhere
+          _outstanding.wait(left, std::memory_order_acquire);
+        }
+      }
+
+      thread_pool& _pool;
+      std::atomic<std::size_t> _outstanding{ 0 };
+      std::atomic<std::size_t> _notifying{ 0 };
+      spin_lock _error_lock;
+      std::exception_ptr _error;
+    };
+
+    /**
+     * @brief Calls fn(first, last) over disjoint subranges covering [begin, end) in parallel.
+     *
+     * @param grain Minimum subrange length; 0 picks about four chunks per worker.
+     * @note The calling thread runs a share of the chunks and returns when all are done;
+     *       the first exception thrown by fn is rethrown.
+     */
+    template<typename Index, typename F>
+    void parallel_for(thread_pool& pool, Index begin, Index end, F&& fn, Index grain = 0,
+                      task_priority priority = task_priority::normal) {
+      static_assert(std::is_integral_v<Index>, "parallel_for needs an integral index");
+      if (end <= begin) return;
+      std::size_t total = static_cast<std::size_t>(end - begin);
+      std::size_t chunk = grain > 0
+        ? static_cast<std::size_t>(grain)
+        : std::max<std::size_t>(1, total / (pool.size() * 4));
+      if (chunk >= total) {
+        fn(begin, end);
+        return;
+      }
+
+      task_group group(pool);
+      std::size_t first = 0;
+      // the caller keeps the last chunk for itself
+      for (; first + chunk < total; first += chunk) {
+        Index lo = static_cast<Index>(begin + static_cast<Index>(first));
+        Index hi = static_cast<Index>(lo + static_cast<Index>(chunk));
+        group.run([&fn, lo, hi] { fn(lo, hi); }, priority);
+      }
+      std::exception_ptr own;
+      try {
+        fn(static_cast<Index>(begin + static_cast<Index>(first)), end);
+      }
+      catch (...) {
+        own = std::current_exception();
+      }
+      group.wait();
+      if (own) std::rethrow_exception(own);
+    }
+
+    /// parallel_for on thread_pool::shared().
+    template<typename Index, typename F>
+    void parallel_for(Index begin, Index end, F&& fn, Index grain = 0) {
+      parallel_for(thread_pool::shared(), begin, end, std::forward<F>(fn), grain);
+    }
+  }
+}
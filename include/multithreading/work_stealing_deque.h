@@ -0,0 +1,135 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+#include <platform/platform.h>
+
+namespace voxory {
+  namespace multithreading {
+    /**
+     * @brief Chase-Lev work-stealing deque.
+     *
+     * @details The owner thread pushes and pops at the bottom (LIFO, cache-warm work);
+     *          any other thread steals from the top (FIFO, oldest and usually largest work).
+     *          push/pop touch only the owner's cache line except when the deque is nearly empty;
+     *          steal is one CAS on top. Memory orders follow Le, Pop, Cohen, Zappa Nardelli,
+     *          "Correct and Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013).
+     *
+     *          The buffer grows by doubling; retired buffers are kept until the deque dies,
+     *          because a thief may still be reading one.
+     *
+     * @tparam T Trivially copyable and lock-free as std::atomic<T> (typically a pointer).
+     */
+    template<typename T>
+    class work_stealing_deque {
+      static_assert(std::is_trivially_copyable_v<T>, "work_stealing_deque stores T in atomics");
+    public:
+      using value_type = T;
+      using size_type = std::size_t;
+
+      explicit work_stealing_deque(size_type capacity = 256)
+        : _top(0), _bottom(0) {
+        size_type cap = 2;
+        while (cap < capacity) cap <<= 1;
+        _buffers.push_back(std::make_unique<_ring>(cap));
+        _array.store(_buffers.back().get(), std::memory_order_relaxed);
+      }
+
+      work_stealing_deque(const work_stealing_deque&) = delete;
+      work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+      /// Owner only.
+      void push(T v) {
+        int64_t b = _bottom.load(std::memory_order_relaxed);
+        int64_t t = _top.load(std::memory_order_acquire);
+        _ring* a = _array.load(std::memory_order_relaxed);
+        if (b - t > static_cast<int64_t>(a->capacity) - 1) {
+          a = _grow(a, t, b);
+        }
+        a->put(b, v);
+        std::atomic_thread_fence(std::memory_order_release);
+        _bottom.store(b + 1, std::memory_order_relaxed);
+      }
+
+      /// Owner only; newest element first.
+      std::optional<T> pop() noexcept {
+        int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+        _ring* a = _array.load(std::memory_order_relaxed);
+        _bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = _top.load(std::memory_order_relaxed);
+
+        if (t > b) {
+          // empty
+          _bottom.store(b + 1, std::memory_order_relaxed);
+          return std::nullopt;
+        }
+        T v = a->get(b);
+        if (t == b) {
+          // last element: race the thieves for it
+          bool won = _top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+          _bottom.store(b + 1, std::memory_order_relaxed);
+          if (!won) return std::nullopt;
+        }
+        return v;
+      }
+
+      /// Any thread; oldest element first. Empty result on an empty deque or a lost race.
+      std::optional<T> steal() noexcept {
+        int64_t t = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = _bottom.load(std::memory_order_acquire);
+        if (t >= b) return std::nullopt;
+
+        _ring* a = _array.load(std::memory_order_acquire);
+        T v = a->get(t);
+        if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+          return std::nullopt;
+        }
+        return v;
+      }
+
+      /// Approximate when called concurrently.
+      NODISCARD size_type size() const noexcept {
+        int64_t b = _bottom.load(std::memory_order_relaxed);
+        int64_t t = _top.load(std::memory_order_relaxed);
+        return b > t ? static_cast<size_type>(b - t) : 0;
+      }
+
+      NODISCARD bool empty() const noexcept { return size() == 0; }
+
+      NODISCARD size_type capacity() const noexcept { return _array.load(std::memory_order_relaxed)->capacity; }
+
+    private:
+      struct _ring {
+        explicit _ring(size_type cap) : capacity(cap), mask(cap - 1), slots(new std::atomic<T>[cap]) {}
+
+        FORCE_INLINE T get(int64_t i) const noexcept { return slots[static_cast<size_type>(i) & mask].load(std::memory_order_relaxed); }
+        FORCE_INLINE void put(int64_t i, T v) noexcept { slots[static_cast<size_type>(i) & mask].store(v, std::memory_order_relaxed); }
+
+        size_type capacity;
+        size_type mask;
+        std::unique_ptr<std::atomic<T>[]> slots;
+      };
+
+      _ring* _grow(_ring* old, int64_t t, int64_t b) {
+        auto bigger = std::make_unique<_ring>(old->capacity * 2);
+        for (int64_t i = t; i < b; ++i) bigger->put(i, old->get(i));
+        _ring* raw = bigger.get();
+        _buffers.push_back(std::move(bigger));
+        _array.store(raw, std::memory_order_release);
+        return raw;
+      }
+
+      // owner and thieves hammer different ends
+      alignas(64) std::atomic<int64_t> _top;
+      alignas(64) std::atomic<int64_t> _bottom;
+      std::atomic<_ring*> _array;
+      std::vector<std::unique_ptr<_ring>> _buffers; // owner only
+    };
+  }
+}
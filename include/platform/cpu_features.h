@@ -0,0 +1,98 @@
+#pragma once
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <platform/platform.h>
+#include <cstdint>
+
+#if defined(X64)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif // X64
+
+// lets one function use an instruction set the translation unit is not compiled for;
+// callers must check cpu_features first. MSVC accepts any intrinsic without it.
+#if defined(X64) && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_AVX2
+#endif
+
+namespace voxory {
+  namespace platform {
+    /**
+     * @brief Instruction sets usable by this process, detected once at runtime.
+     * @details On x64 a feature counts only if the OS also saves its registers (XGETBV),
+     *          so AVX2 is off under an OS or hypervisor that disables AVX state.
+     *          NEON (Advanced SIMD) is architectural on AArch64.
+     */
+    struct cpu_features {
+      bool sse2 = false;
+      bool avx2 = false;
+      bool avx512f = false;
+      bool neon = false;
+
+      /// Features of the running CPU; computed on first use.
+      NODISCARD static const cpu_features& get() noexcept {
+        static const cpu_features features = detect();
+        return features;
+      }
+
+      NODISCARD static cpu_features detect() noexcept;
+    };
+
+    namespace internal {
+#if defined(X64)
+      inline void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4]) noexcept {
+#if defined(_MSC_VER)
+        int r[4];
+        __cpuidex(r, static_cast<int>(leaf), static_cast<int>(subleaf));
+        for (int i = 0; i < 4; ++i) regs[i] = static_cast<uint32_t>(r[i]);
+#else
+        if (!__get_cpuid_count(leaf, subleaf, &regs[0], &regs[1], &regs[2], &regs[3])) {
+          regs[0] = regs[1] = regs[2] = regs[3] = 0;
+        }
+#endif
+      }
+
+      inline uint64_t xgetbv0() noexcept {
+#if defined(_MSC_VER)
+        return _xgetbv(0);
+#else
+        uint32_t lo, hi;
+        __asm__ __volatile__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+        return (uint64_t(hi) << 32) | lo;
+#endif
+      }
+#endif // X64
+    } // namespace internal
+
+    inline cpu_features cpu_features::detect() noexcept {
+      cpu_features f;
+#if defined(X64)
+      f.sse2 = true; // part of x86-64
+      uint32_t regs[4];
+      internal::cpuid(0, 0, regs);
+      const uint32_t max_leaf = regs[0];
+      internal::cpuid(1, 0, regs);
+      const bool osxsave = (regs[2] & (1u << 27)) != 0;
+      const bool avx = (regs[2] & (1u << 28)) != 0;
+      const uint64_t xcr0 = osxsave ? internal::xgetbv0() : 0;
+      const bool ymm_saved = (xcr0 & 0x6) == 0x6;    // SSE and AVX state
+      const bool zmm_saved = (xcr0 & 0xe6) == 0xe6;  // plus opmask and upper ZMM state
+      if (max_leaf >= 7) {
+        internal::cpuid(7, 0, regs);
+        f.avx2 = avx && ymm_saved && (regs[1] & (1u << 5)) != 0;
+        f.avx512f = zmm_saved && (regs[1] & (1u << 16)) != 0;
+      }
+#elif defined(X64_ARM)
+      f.neon = true;
+#endif
+      return f;
+    }
+  }
+}
@@ -0,0 +1,419 @@
+#pragma once
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <platform/platform.h>
+#include <platform/thread_affinity.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#if defined(LINUX)
+#include <sched.h>
+#elif defined(macOS)
+#include <sys/sysctl.h>
+#endif
+
+#if defined(X64)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif // X64
+
+namespace voxory {
+  namespace platform {
+    /// One hardware thread as the OS numbers it (the id accepted by pin_current_thread()).
+    struct logical_cpu {
+      unsigned id = 0;
+      unsigned core = 0;         // physical core, unique across packages
+      unsigned package = 0;
+      unsigned l3 = 0;           // id of the last-level cache group; equal ids share an L3
+      unsigned smt_index = 0;    // 0 for the first hardware thread of its core
+      uint8_t efficiency_class = 0; // higher is faster; all equal on non-hybrid parts
+    };
+
+    /**
+     * @brief Logical CPUs of the machine with their core, cache and P/E-core relations.
+     *
+     * @details Linux reads sysfs (topology/, cache/index*, cpu_core|cpu_atom, cpu_capacity) and
+     *          only lists CPUs in the process affinity mask; Windows uses
+     *          GetLogicalProcessorInformationEx. Elsewhere, or when that fails, every logical CPU
+     *          is reported as its own core in one cache group.
+     */
+    struct cpu_topology {
+      std::vector<logical_cpu> cpus; // sorted by id
+
+      NODISCARD std::size_t logical_count() const noexcept { return cpus.size(); }
+
+      NODISCARD std::size_t physical_count() const noexcept {
+        return static_cast<std::size_t>(std::count_if(cpus.begin(), cpus.end(),
+          [](const logical_cpu& c) { return c.smt_index == 0; }));
+      }
+
+      NODISCARD bool has_smt() const noexcept { return physical_count() < logical_count(); }
+
+      /// P-cores and E-cores (or big.LITTLE clusters) are present.
+      NODISCARD bool is_hybrid() const noexcept {
+        return std::any_of(cpus.begin(), cpus.end(),
+          [&](const logical_cpu& c) { return c.efficiency_class != cpus.front().efficiency_class; });
+      }
+
+      static cpu_topology detect();
+    };
+
+    /// What the pipeline wants placed.
+    struct placement_request {
+      std::size_t max_inference_threads = 0; // 0: every suitable physical core
+      std::size_t capture_cpus = 1;          // cores kept away from inference for capture/resample
+    };
+
+    /**
+     * @brief CPUs for each role; empty means "do not pin".
+     */
+    struct placement_plan {
+      std::vector<unsigned> inference_cpus; // one hardware thread per physical core
+      std::vector<unsigned> capture_cpus;
+    };
+
+    /**
+     * @brief Picks CPUs for inference workers and the capture path.
+     *
+     * @details Inference gets the first hardware thread of each physical core, never two SMT
+     *          siblings, so GEMM kernels do not share execution ports. On hybrid parts only the
+     *          fastest class is used. Cores are taken from the largest L3 group first so the
+     *          workers share a cache. Capture gets an E-core on hybrid parts, otherwise the last
+     *          physical core; its SMT siblings stay unused. With fewer than three physical cores
+     *          nothing is reserved for capture.
+     */
+    inline placement_plan plan_placement(const cpu_topology& topo, const placement_request& request = {});
+
+    /**
+     * @brief Human-readable CPU model, e.g. "AMD Ryzen 7 7840U w/ Radeon 780M Graphics".
+     * @details CPUID brand string on x64, /proc/cpuinfo or sysctl elsewhere; "unknown" if none.
+     */
+    inline std::string cpu_model_name();
+
+    namespace internal {
+      // "0-3,8,10-11" -> {0,1,2,3,8,10,11}
+      inline std::vector<unsigned> parse_cpu_list(const std::string& s) {
+        std::vector<unsigned> out;
+        std::size_t i = 0;
+        while (i < s.size()) {
+          while (i < s.size() && (s[i] < '0' || s[i] > '9')) ++i;
+          if (i >= s.size()) break;
+          unsigned lo = 0;
+          while (i < s.size() && s[i] >= '0' && s[i] <= '9') lo = lo * 10 + static_cast<unsigned>(s[i++] - '0');
+          unsigned hi = lo;
+          if (i < s.size() && s[i] == '-') {
+            ++i;
+            hi = 0;
+            while (i < s.size() && s[i] >= '0' && s[i] <= '9') hi = hi * 10 + static_cast<unsigned>(s[i++] - '0');
+          }
+          for (unsigned c = lo; c <= hi; ++c) out.push_back(c);
+        }
+        return out;
+      }
+
+      inline bool read_text_file(const std::string& path, std::string& out) {
+        std::ifstream f(path);
+        if (!f) return false;
+        std::getline(f, out);
+        return true;
+      }
+
+      inline bool read_unsigned_file(const std::string& path, unsigned& out) {
+        std::string s;
+        if (!read_text_file(path, s) || s.empty()) return false;
+        try {
+          out = static_cast<unsigned>(std::stoul(s));
+        }
+        catch (...) {
+          return false;
+        }
+        return true;
+      }
+
+      inline cpu_topology flat_topology() {
+        cpu_topology topo;
+        unsigned n = hardware_threads();
+        for (unsigned i = 0; i < n; ++i) {
+          logical_cpu c;
+          c.id = i;
+          c.core = i;
+          topo.cpus.push_back(c);
+        }
+        return topo;
+      }
+
+#if defined(LINUX)
+      inline cpu_topology detect_linux() {
+        const std::string base = "/sys/devices/system/cpu/";
+        std::string online;
+        if (!read_text_file(base + "online", online)) return {};
+
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        bool have_mask = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+        // Intel hybrid parts list their P- and E-cores in separate PMUs
+        std::vector<unsigned> atom_cpus;
+        std::string atom;
+        if (read_text_file("/sys/devices/cpu_atom/cpus", atom)) atom_cpus = parse_cpu_list(atom);
+
+        cpu_topology topo;
+        std::map<std::pair<unsigned, unsigned>, unsigned> core_ids; // (package, core_id) -> dense id
+        std::map<unsigned, unsigned> capacities;                    // cpu -> cpu_capacity (ARM)
+
+        for (unsigned id : parse_cpu_list(online)) {
+          if (have_mask && id < CPU_SETSIZE && !CPU_ISSET(id, &allowed)) continue;
+          const std::string dir = base + "cpu" + std::to_string(id) + "/";
+          logical_cpu c;
+          c.id = id;
+
+          unsigned core_id = id;
+          (void)read_unsigned_file(dir + "topology/physical_package_id", c.package);
+          (void)read_unsigned_file(dir + "topology/core_id", core_id);
+          auto key = std::make_pair(c.package, core_id);
+          auto it = core_ids.find(key);
+          if (it == core_ids.end()) it = core_ids.emplace(key, static_cast<unsigned>(core_ids.size())).first;
+          c.core = it->second;
+
+          std::string siblings;
+          if (read_text_file(dir + "topology/thread_siblings_list", siblings)) {
+            // position among the siblings we may run on, so a cpuset of second threads still has primaries
+            auto list = parse_cpu_list(siblings);
+            if (have_mask) {
+              list.erase(std::remove_if(list.begin(), list.end(),
+                [&](unsigned s) { return s < CPU_SETSIZE && !CPU_ISSET(s, &allowed); }), list.end());
+            }
+            c.smt_index = static_cast<unsigned>(std::find(list.begin(), list.end(), id) - list.begin());
+            if (c.smt_index >= list.size()) c.smt_index = 0;
+          }
+
+          // last-level cache: the highest cache index that reports level 3
+          c.l3 = c.package;
+          for (unsigned idx = 0; idx < 8; ++idx) {
+            const std::string cache = dir + "cache/index" + std::to_string(idx) + "/";
+            unsigned level = 0;
+            if (!read_unsigned_file(cache + "level", level)) break;
+            if (level != 3) continue;
+            std::string shared;
+            if (read_text_file(cache + "shared_cpu_list", shared)) {
+              auto list = parse_cpu_list(shared);
+              if (!list.empty()) c.l3 = list.front();
+            }
+          }
+
+          if (!atom_cpus.empty()) {
+            c.efficiency_class = std::find(atom_cpus.begin(), atom_cpus.end(), id) != atom_cpus.end() ? 0 : 1;
+          }
+          unsigned capacity = 0;
+          if (atom_cpus.empty() && read_unsigned_file(dir + "cpu_capacity", capacity)) capacities[id] = capacity;
+
+          topo.cpus.push_back(c);
+        }
+
+        // ARM big.LITTLE: rank the distinct capacities
+        if (!capacities.empty()) {
+          std::vector<unsigned> distinct;
+          for (auto& [id, cap] : capacities) distinct.push_back(cap);
+          std::sort(distinct.begin(), distinct.end());
+          distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+          for (auto& c : topo.cpus) {
+            auto it = capacities.find(c.id);
+            if (it == capacities.end()) continue;
+            c.efficiency_class = static_cast<uint8_t>(std::lower_bound(distinct.begin(), distinct.end(), it->second) - distinct.begin());
+          }
+        }
+        return topo;
+      }
+#endif // LINUX
+
+#if defined(WINDOWS)
+      inline cpu_topology detect_windows() {
+        DWORD len = 0;
+        GetLogicalProcessorInformationEx(RelationAll, nullptr, &len);
+        if (len == 0) return {};
+        std::vector<unsigned char> buf(len);
+        auto* info = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buf.data());
+        if (!GetLogicalProcessorInformationEx(RelationAll, info, &len)) return {};
+
+        std::map<unsigned, logical_cpu> by_id;
+        unsigned core = 0, package = 0;
+        auto for_each_cpu = [](const GROUP_AFFINITY& g, auto&& fn) {
+          for (unsigned bit = 0; bit < 64; ++bit) {
+            if (g.Mask & (static_cast<KAFFINITY>(1) << bit)) fn(static_cast<unsigned>(g.Group) * 64 + bit);
+          }
+        };
+
+        // cores and packages first, caches need the cpus to exist
+        for (DWORD off = 0; off < len;) {
+          auto* e = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buf.data() + off);
+          if (e->Relationship == RelationProcessorCore) {
+            unsigned smt = 0;
+            for (WORD g = 0; g < e->Processor.GroupCount; ++g) {
+              for_each_cpu(e->Processor.GroupMask[g], [&](unsigned id) {
+                logical_cpu& c = by_id[id];
+                c.id = id;
+                c.core = core;
+                c.smt_index = smt++;
+                c.efficiency_class = e->Processor.EfficiencyClass;
+              });
+            }
+            ++core;
+          }
+          off += e->Size;
+        }
+        for (DWORD off = 0; off < len;) {
+          auto* e = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buf.data() + off);
+          if (e->Relationship == RelationProcessorPackage) {
+            for (WORD g = 0; g < e->Processor.GroupCount; ++g) {
+              for_each_cpu(e->Processor.GroupMask[g], [&](unsigned id) { by_id[id].package = package; });
+            }
+            ++package;
+          }
+          else if (e->Relationship == RelationCache && e->Cache.Level == 3) {
+            unsigned first = ~0u;
+            for_each_cpu(e->Cache.GroupMask, [&](unsigned id) { first = std::min(first, id); });
+            for_each_cpu(e->Cache.GroupMask, [&](unsigned id) { by_id[id].l3 = first; });
+          }
+          off += e->Size;
+        }
+
+        cpu_topology topo;
+        for (auto& [id, c] : by_id) topo.cpus.push_back(c);
+        return topo;
+      }
+#endif // WINDOWS
+    } // namespace internal
+
+    inline std::string cpu_model_name() {
+      std::string name;
+#if defined(X64)
+      unsigned regs[12] = {};
+#if defined(_MSC_VER)
+      int info[4] = {};
+      __cpuid(info, static_cast<int>(0x80000000));
+      if (static_cast<unsigned>(info[0]) >= 0x80000004u) {
+        for (int leaf = 0; leaf < 3; ++leaf) {
+          __cpuid(info, static_cast<int>(0x80000002u + leaf));
+          for (int r = 0; r < 4; ++r) regs[leaf * 4 + r] = static_cast<unsigned>(info[r]);
+        }
+      }
+#else
+      if (__get_cpuid_max(0x80000000u, nullptr) >= 0x80000004u) {
+        for (unsigned leaf = 0; leaf < 3; ++leaf) {
+          __get_cpuid(0x80000002u + leaf, &regs[leaf * 4], &regs[leaf * 4 + 1], &regs[leaf * 4 + 2], &regs[leaf * 4 + 3]);
+        }
+      }
+#endif
+      name.assign(reinterpret_cast<const char*>(regs), sizeof(regs));
+      name.resize(name.find('\0') == std::string::npos ? name.size() : name.find('\0'));
+#endif // X64
+
+#if defined(LINUX)
+      if (name.empty()) {
+        std::ifstream f("/proc/cpuinfo");
+        std::string line;
+        while (name.empty() && std::getline(f, line)) {
+          // x86 "model name", ARM "Hardware" / "Model"
+          for (const char* field : { "model name", "Hardware", "Model" }) {
+            if (line.rfind(field, 0) == 0 && line.find(':') != std::string::npos) {
+              name = line.substr(line.find(':') + 1);
+              break;
+            }
+          }
+        }
+      }
+#elif defined(macOS)
+      if (name.empty()) {
+        char buf[256] = {};
+        size_t len = sizeof(buf);
+        if (sysctlbyname("machdep.cpu.brand_string", buf, &len, nullptr, 0) == 0) name = buf;
+      }
+#endif
+
+      // trim the padding some vendors put around the brand string
+      std::size_t b = name.find_first_not_of(" \t");
+      std::size_t e = name.find_last_not_of(" \t");
+      name = b == std::string::npos ? std::string() : name.substr(b, e - b + 1);
+      return name.empty() ? std::string("unknown") : name;
+    }
+
+    inline cpu_topology cpu_topology::detect() {
+      cpu_topology topo;
+#if defined(LINUX)
+      topo = internal::detect_linux();
+#elif defined(WINDOWS)
+      topo = internal::detect_windows();
+#endif
+      if (topo.cpus.empty()) topo = internal::flat_topology();
+      std::sort(topo.cpus.begin(), topo.cpus.end(), [](const logical_cpu& a, const logical_cpu& b) { return a.id < b.id; });
+      return topo;
+    }
+
+    inline placement_plan plan_placement(const cpu_topology& topo, const placement_request& request) {
+      placement_plan plan;
+      std::vector<logical_cpu> primaries;
+      for (const auto& c : topo.cpus) {
+        if (c.smt_index == 0) primaries.push_back(c);
+      }
+      if (primaries.empty()) {
+        // no first thread survived: take the lowest allowed cpu of each core instead
+        std::vector<unsigned> seen;
+        for (const auto& c : topo.cpus) {
+          if (std::find(seen.begin(), seen.end(), c.core) != seen.end()) continue;
+          seen.push_back(c.core);
+          primaries.push_back(c);
+        }
+      }
+      if (primaries.empty()) return plan;
+
+      uint8_t fastest = 0;
+      for (const auto& c : primaries) fastest = std::max(fastest, c.efficiency_class);
+
+      // capture: an E-core on hybrid parts, else the last physical core
+      std::vector<unsigned> reserved_cores;
+      if (request.capture_cpus > 0 && primaries.size() >= 3) {
+        std::vector<logical_cpu> slow;
+        for (const auto& c : primaries) {
+          if (c.efficiency_class != fastest) slow.push_back(c);
+        }
+        const auto& pool = slow.empty() ? primaries : slow;
+        std::size_t n = std::min(request.capture_cpus, slow.empty() ? primaries.size() - 2 : slow.size());
+        for (std::size_t i = 0; i < n; ++i) {
+          const auto& c = pool[pool.size() - 1 - i];
+          plan.capture_cpus.push_back(c.id);
+          reserved_cores.push_back(c.core);
+        }
+        std::sort(plan.capture_cpus.begin(), plan.capture_cpus.end());
+      }
+
+      // inference: fastest class only, grouped by L3, largest group first
+      std::map<unsigned, std::vector<unsigned>> groups;
+      for (const auto& c : primaries) {
+        if (c.efficiency_class != fastest) continue;
+        if (std::find(reserved_cores.begin(), reserved_cores.end(), c.core) != reserved_cores.end()) continue;
+        groups[c.l3].push_back(c.id);
+      }
+      std::vector<std::vector<unsigned>*> order;
+      for (auto& [l3, ids] : groups) order.push_back(&ids);
+      std::stable_sort(order.begin(), order.end(), [](auto* a, auto* b) { return a->size() > b->size(); });
+
+      std::size_t limit = request.max_inference_threads ? request.max_inference_threads : static_cast<std::size_t>(-1);
+      for (auto* ids : order) {
+        for (unsigned id : *ids) {
+          if (plan.inference_cpus.size() >= limit) break;
+          plan.inference_cpus.push_back(id);
+        }
+      }
+      return plan;
+    }
+  }
+}
@@ -0,0 +1,288 @@
+#pragma once
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <platform/platform.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+#if defined(LINUX) || defined(macOS)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace voxory {
+  namespace platform {
+    /**
+     * @brief Requested properties of a locked_memory region.
+     * @note Every property is best-effort; see locked_region for what was achieved.
+     */
+    enum class memory_flags : uint32_t {
+      none       = 0,
+      lock       = 1u << 0, // mlock / VirtualLock: pages stay resident
+      prefault   = 1u << 1, // touch every page up front so the first write does not fault
+      huge_pages = 1u << 2, // MAP_HUGETLB -> MADV_HUGEPAGE / MEM_LARGE_PAGES for large regions
+      realtime   = lock | prefault | huge_pages
+    };
+
+    CONSTEXPR FORCE_INLINE memory_flags operator|(memory_flags a, memory_flags b) noexcept {
+      return static_cast<memory_flags>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
+    }
+
+    CONSTEXPR FORCE_INLINE bool has_flag(memory_flags set, memory_flags f) noexcept {
+      return (static_cast<uint32_t>(set) & static_cast<uint32_t>(f)) != 0;
+    }
+
+    /**
+     * @brief Result of allocate_locked(): the mapping and the properties it actually got.
+     */
+    struct locked_region {
+      void* ptr = nullptr;
+      // bytes mapped, rounded up to the page size that was used
+      std::size_t bytes = 0;
+      bool locked = false;
+      bool prefaulted = false;
+      bool huge_pages = false;
+    };
+
+    /**
+     * @brief Process-wide counters of what locked allocations achieved.
+     * @note Read them after start-up to verify that the capture buffers really are resident.
+     */
+    struct locked_memory_stats {
+      std::atomic<std::size_t> allocations{ 0 };
+      std::atomic<std::size_t> bytes_live{ 0 };
+      std::atomic<std::size_t> lock_failures{ 0 };
+      std::atomic<std::size_t> huge_page_regions{ 0 };
+      std::atomic<std::size_t> huge_page_fallbacks{ 0 };
+    };
+
+    inline locked_memory_stats& locked_memory_report() noexcept {
+      static locked_memory_stats stats;
+      return stats;
+    }
+
+    namespace internal {
+      inline constexpr std::size_t huge_page_size = std::size_t(2) << 20;
+
+      inline std::size_t page_size() noexcept {
+#if defined(WINDOWS)
+        static const std::size_t size = [] {
+          SYSTEM_INFO info;
+          GetSystemInfo(&info);
+          return static_cast<std::size_t>(info.dwPageSize);
+        }();
+#else
+        static const std::size_t size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+        return size;
+      }
+
+      CONSTEXPR FORCE_INLINE std::size_t round_up(std::size_t n, std::size_t to) noexcept {
+        return (n + to - 1) / to * to;
+      }
+
+      // length of the mapping for a request; must stay a pure function of (bytes, flags)
+      // because deallocation recomputes it
+      inline std::size_t mapping_size(std::size_t bytes, memory_flags flags) noexcept {
+        if (has_flag(flags, memory_flags::huge_pages) && bytes >= huge_page_size) {
+          return round_up(bytes, huge_page_size);
+        }
+        return round_up(bytes, page_size());
+      }
+
+      inline void touch_pages(void* ptr, std::size_t bytes) noexcept {
+        volatile unsigned char* p = static_cast<volatile unsigned char*>(ptr);
+        const std::size_t step = page_size();
+        for (std::size_t off = 0; off < bytes; off += step) {
+          p[off] = 0;
+        }
+      }
+
+#if defined(WINDOWS)
+      inline bool enable_lock_memory_privilege() noexcept {
+        static const bool enabled = [] {
+          HANDLE token = nullptr;
+          if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token)) return false;
+
+          TOKEN_PRIVILEGES tp = { 0 };
+          if (!LookupPrivilegeValueA(nullptr, "SeLockMemoryPrivilege", &tp.Privileges[0].Luid)) {
+            CloseHandle(token);
+            return false;
+          }
+          tp.PrivilegeCount = 1;
+          tp.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+
+          BOOL adjusted = AdjustTokenPrivileges(token, FALSE, &tp, sizeof(tp), nullptr, nullptr);
+          DWORD err = GetLastError();
+          CloseHandle(token);
+          // AdjustTokenPrivileges succeeds even if the account does not hold the privilege
+          return adjusted && err != ERROR_NOT_ALL_ASSIGNED;
+        }();
+        return enabled;
+      }
+
+      // VirtualLock is capped by the minimum working set; grow it by the region size
+      inline bool grow_working_set(std::size_t extra) noexcept {
+        SIZE_T min_ws = 0, max_ws = 0;
+        if (!GetProcessWorkingSetSize(GetCurrentProcess(), &min_ws, &max_ws)) return false;
+        const SIZE_T margin = 16 * 1024 * 1024;
+        return SetProcessWorkingSetSize(GetCurrentProcess(), min_ws + extra + margin, max_ws + extra + margin) != 0;
+      }
+
+      inline bool lock_pages(void* ptr, std::size_t bytes) noexcept {
+        if (VirtualLock(ptr, bytes)) return true;
+        if (enable_lock_memory_privilege() && VirtualLock(ptr, bytes)) return true;
+        return grow_working_set(bytes) && VirtualLock(ptr, bytes);
+      }
+#endif
+    } // namespace internal
+
+    /**
+     * @brief Maps a page-aligned region outside the general-purpose heap.
+     *
+     * @details Linux/macOS: anonymous mmap; huge pages via MAP_HUGETLB, falling back to
+     *          MADV_HUGEPAGE (transparent huge pages); mlock; prefault by touching each page.
+     *          Windows: VirtualAlloc, with MEM_LARGE_PAGES when SeLockMemoryPrivilege is held
+     *          (large pages are never paged out); otherwise VirtualLock, enabling the privilege
+     *          and growing the working set if the first attempt fails.
+     *          Any property that cannot be obtained is skipped; the region is still usable.
+     *
+     * @param bytes Requested size; 0 yields an empty region.
+     * @param flags Requested properties.
+     * @return Mapping and achieved properties; ptr == nullptr only if the OS is out of memory.
+     */
+    inline locked_region allocate_locked(std::size_t bytes, memory_flags flags = memory_flags::realtime) noexcept {
+      locked_region r;
+      if (bytes == 0) return r;
+      auto& stats = locked_memory_report();
+      const std::size_t size = internal::mapping_size(bytes, flags);
+      const bool want_huge = has_flag(flags, memory_flags::huge_pages) && size % internal::huge_page_size == 0;
+
+#if defined(WINDOWS)
+      if (want_huge && internal::enable_lock_memory_privilege()) {
+        const SIZE_T large = GetLargePageMinimum();
+        if (large != 0 && size % large == 0) {
+          r.ptr = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+          if (r.ptr != nullptr) {
+            // large pages are committed physically and cannot be paged out
+            r.huge_pages = r.locked = r.prefaulted = true;
+          }
+        }
+      }
+      if (r.ptr == nullptr) {
+        if (want_huge) stats.huge_page_fallbacks.fetch_add(1, std::memory_order_relaxed);
+        r.ptr = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+        if (r.ptr == nullptr) return locked_region{};
+        if (has_flag(flags, memory_flags::lock)) {
+          r.locked = internal::lock_pages(r.ptr, size);
+          r.prefaulted = r.locked;
+          if (!r.locked) stats.lock_failures.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+#else
+      void* p = MAP_FAILED;
+#  if defined(MAP_HUGETLB)
+      if (want_huge) {
+        // succeeds only if the administrator reserved huge pages (vm.nr_hugepages)
+        p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        r.huge_pages = p != MAP_FAILED;
+      }
+#  endif
+      if (p == MAP_FAILED) {
+        p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) return locked_region{};
+#  if defined(MADV_HUGEPAGE)
+        if (want_huge) {
+          r.huge_pages = madvise(p, size, MADV_HUGEPAGE) == 0;
+        }
+#  endif
+        if (want_huge && !r.huge_pages) stats.huge_page_fallbacks.fetch_add(1, std::memory_order_relaxed);
+      }
+      r.ptr = p;
+      if (has_flag(flags, memory_flags::lock)) {
+        // mlock also faults the pages in; fails past RLIMIT_MEMLOCK without CAP_IPC_LOCK
+        r.locked = mlock(p, size) == 0;
+        r.prefaulted = r.locked;
+        if (!r.locked) stats.lock_failures.fetch_add(1, std::memory_order_relaxed);
+      }
+#endif
+
+      if (has_flag(flags, memory_flags::prefault) && !r.prefaulted) {
+        internal::touch_pages(r.ptr, size);
+        r.prefaulted = true;
+      }
+      r.bytes = size;
+      if (r.huge_pages) stats.huge_page_regions.fetch_add(1, std::memory_order_relaxed);
+      stats.allocations.fetch_add(1, std::memory_order_relaxed);
+      stats.bytes_live.fetch_add(size, std::memory_order_relaxed);
+      return r;
+    }
+
+    /**
+     * @brief Releases a region returned by allocate_locked().
+     * @param ptr   Region start; nullptr is ignored.
+     * @param bytes The size passed to allocate_locked() (or locked_region::bytes).
+     * @param flags The flags passed to allocate_locked().
+     */
+    inline void free_locked(void* ptr, std::size_t bytes, memory_flags flags = memory_flags::realtime) noexcept {
+      if (ptr == nullptr) return;
+      const std::size_t size = internal::mapping_size(bytes, flags);
+#if defined(WINDOWS)
+      // VirtualFree releases locked pages as well
+      VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+      // munmap drops the lock together with the mapping
+      munmap(ptr, size);
+#endif
+      locked_memory_report().bytes_live.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Stateless allocator over allocate_locked() / free_locked().
+     *
+     * @note Every allocation is a separate mapping of at least one page, so use it for
+     *       long-lived buffers (ring_buffer, heap_array, audio_buffer), not for node containers.
+     *
+     * @tparam T     Element type.
+     * @tparam Flags Requested memory properties.
+     */
+    template<typename T, memory_flags Flags = memory_flags::realtime>
+    class locked_allocator {
+    public:
+      using value_type = T;
+      using size_type = std::size_t;
+      using difference_type = std::ptrdiff_t;
+      using propagate_on_container_move_assignment = std::true_type;
+      using is_always_equal = std::true_type;
+
+      template<typename U>
+      struct rebind { using other = locked_allocator<U, Flags>; };
+
+      static constexpr memory_flags flags = Flags;
+
+      CONSTEXPR locked_allocator() noexcept = default;
+      template<typename U>
+      CONSTEXPR locked_allocator(const locked_allocator<U, Flags>&) noexcept {}
+
+      NODISCARD T* allocate(size_type n) {
+        static_assert(alignof(T) <= 4096, "locked_allocator supports alignment up to the page size");
+        if (n == 0) return nullptr;
+        if (n > static_cast<size_type>(-1) / sizeof(T)) throw std::bad_array_new_length();
+        locked_region r = allocate_locked(n * sizeof(T), Flags);
+        if (r.ptr == nullptr) throw std::bad_alloc();
+        return static_cast<T*>(r.ptr);
+      }
+
+      void deallocate(T* p, size_type n) noexcept {
+        free_locked(p, n * sizeof(T), Flags);
+      }
+
+      template<typename U>
+      CONSTEXPR bool operator==(const locked_allocator<U, Flags>&) const noexcept { return true; }
+    };
+  } // namespace platform
+} // namespace voxory
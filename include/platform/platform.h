@@ -52,7 +52,7 @@
 #elif defined(__linux__) && !defined(__ANDROID__)
 #include <unistd.h>
 #include <sys/syscall.h>
-static inline void linux_abort_with_core() {
+[[noreturn]] static inline void linux_abort_with_core() {
   pid_t pid = getpid();
   pid_t tid = (pid_t)syscall(SYS_gettid);
   syscall(SYS_tgkill, pid, tid, SIGABRT);
@@ -83,7 +83,7 @@ static inline void linux_abort_with_core() {
 
 #define ASSERT_ABORT(cond, msg) do {                                    \
     if (!(cond)) {                                                      \
-        report_debug(2, LOCATION_FILE_LINE, "%s", (msg));               \
+        report_debug(2, __FILE__, __LINE__, "%s", (msg));               \
         DEBUG_BREAK();                                                  \
         ABORT_IMMEDIATELY();                                            \
     }                                                                   \
@@ -100,6 +100,12 @@ static inline void linux_abort_with_core() {
 #define CONSTEXPR constexpr
 #define NODISCARD [[nodiscard]]
 
+#if defined(_MSC_VER)
+#  define NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#  define NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
 #if defined(FORCE_DISABLE_DEBUG)
 #  if defined(DEBUG)           //   
 #    undef DEBUG
@@ -162,12 +168,25 @@ static inline void linux_abort_with_core() {
 #  pragma message("DEBUG is ON")
 #endif
 
+// spin-wait hint: PAUSE on x86, YIELD on ARM
 #ifdef X64
+  #if defined(_MSC_VER)
+    #include <intrin.h>
+  #else
+    #include <immintrin.h>
+  #endif
   #ifndef mm_pause
     #define mm_pause() _mm_pause()
   #endif // !mm_pause()
 #elif defined(X64_ARM)
-  #ifndef mm_pause
-    #define mm_pause() _mm_pause()
-  #endif // !mm_pause()
+  #if defined(_MSC_VER)
+    #include <intrin.h>
+    #ifndef mm_pause
+      #define mm_pause() __yield()
+    #endif // !mm_pause()
+  #else
+    #ifndef mm_pause
+      #define mm_pause() __asm__ __volatile__("yield" ::: "memory")
+    #endif // !mm_pause()
+  #endif
 #endif // def X64
@@ -0,0 +1,117 @@
+#pragma once
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <platform/platform.h>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <vector>
+
+#if defined(LINUX)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace voxory {
+  namespace platform {
+    /// Logical CPUs visible to the process; at least 1.
+    inline unsigned hardware_threads() noexcept {
+      unsigned n = std::thread::hardware_concurrency();
+      return n == 0 ? 1 : n;
+    }
+
+    /**
+     * @brief Restricts the calling thread to one logical CPU.
+     * @return False if the OS refused or cannot pin (macOS only takes affinity hints).
+     */
+    inline bool pin_current_thread(unsigned cpu) noexcept {
+#if defined(LINUX)
+      if (cpu >= CPU_SETSIZE) return false;
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      CPU_SET(cpu, &set);
+      return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#elif defined(WINDOWS)
+      // processor groups: CPU n is bit n % 64 of group n / 64
+      GROUP_AFFINITY affinity{};
+      affinity.Group = static_cast<WORD>(cpu / 64);
+      affinity.Mask = static_cast<KAFFINITY>(1) << (cpu % 64);
+      return SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr) != 0;
+#else
+      (void)cpu;
+      return false;
+#endif
+    }
+
+    /**
+     * @brief Restricts the calling thread to a set of logical CPUs.
+     *
+     * @details On Linux threads created afterwards inherit the mask, so calling this before a
+     *          library spawns its workers places them too (Windows: see set_worker_affinity()).
+     *          Windows: only CPUs of the first listed CPU's processor group are used.
+     * @return False if cpus is empty or the OS refused.
+     */
+    inline bool set_current_thread_affinity(std::span<const unsigned> cpus) noexcept {
+      if (cpus.empty()) return false;
+#if defined(LINUX)
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      for (unsigned cpu : cpus) {
+        if (cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+      }
+      return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#elif defined(WINDOWS)
+      GROUP_AFFINITY affinity{};
+      affinity.Group = static_cast<WORD>(cpus.front() / 64);
+      for (unsigned cpu : cpus) {
+        if (cpu / 64 == affinity.Group) affinity.Mask |= static_cast<KAFFINITY>(1) << (cpu % 64);
+      }
+      return SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr) != 0;
+#else
+      return false;
+#endif
+    }
+
+    /**
+     * @brief Places the calling thread and the worker threads created after it on a set of CPUs.
+     *
+     * @details For libraries that spawn their own workers without exposing their placement
+     *          (whisper/ggml). Linux: the calling thread's mask, which threads it creates later
+     *          inherit. Windows: new threads start with the process affinity instead, so the CPUs
+     *          also become the process default CPU sets, which apply to every thread that has no
+     *          affinity or CPU sets of its own (a thread pinned with set_current_thread_affinity()
+     *          keeps its own CPUs).
+     * @return False if cpus is empty or the workers could not be placed.
+     */
+    inline bool set_worker_affinity(std::span<const unsigned> cpus) noexcept {
+      if (!set_current_thread_affinity(cpus)) return false;
+#if defined(LINUX)
+      return true;
+#elif defined(WINDOWS)
+      ULONG len = 0;
+      GetSystemCpuSetInformation(nullptr, 0, &len, GetCurrentProcess(), 0);
+      if (len == 0) return false;
+      std::vector<unsigned char> buf(len);
+      if (!GetSystemCpuSetInformation(reinterpret_cast<SYSTEM_CPU_SET_INFORMATION*>(buf.data()), len, &len, GetCurrentProcess(), 0)) return false;
+
+      // CPU set ids are opaque; match them by group and index (CPU n is index n % 64 of group n / 64)
+      std::vector<ULONG> ids;
+      for (ULONG off = 0; off < len;) {
+        auto* e = reinterpret_cast<SYSTEM_CPU_SET_INFORMATION*>(buf.data() + off);
+        if (e->Type == CpuSetInformation) {
+          const unsigned cpu = static_cast<unsigned>(e->CpuSet.Group) * 64 + e->CpuSet.LogicalProcessorIndex;
+          for (unsigned c : cpus) {
+            if (c == cpu) ids.push_back(e->CpuSet.Id);
+          }
+        }
+        off += e->Size;
+      }
+      if (ids.empty()) return false;
+      return SetProcessDefaultCpuSets(GetCurrentProcess(), ids.data(), static_cast<ULONG>(ids.size())) != 0;
+#else
+      return false;
+#endif
+    }
+  }
+}
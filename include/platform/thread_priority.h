@@ -0,0 +1,100 @@
+#pragma once
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <platform/platform.h>
+#include <platform/thread_affinity.h>
+#include <cstdint>
+
+#if defined(LINUX)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(macOS)
+#include <pthread.h>
+#include <pthread/qos.h>
+#endif
+
+namespace voxory {
+  namespace platform {
+    /// What set_current_thread_realtime() achieved.
+    enum class priority_result : uint8_t {
+      realtime,  // real-time scheduling class (SCHED_FIFO)
+      raised,    // a higher normal priority (nice, TIME_CRITICAL, QoS) without real-time guarantees
+      unchanged  // no privileges; the thread keeps its priority
+    };
+
+    /**
+     * @brief Moves the calling thread to real-time scheduling, or as close as permitted.
+     *
+     * @details Linux: SCHED_FIFO at rt_priority (clamped to the valid range); needs CAP_SYS_NICE
+     *          or an RLIMIT_RTPRIO allowance. Without it the thread is reniced to -10, which also
+     *          may be refused. Windows: THREAD_PRIORITY_TIME_CRITICAL. macOS: the
+     *          user-interactive QoS class.
+     *
+     * @note Meant for the capture and resample threads; they must never spin or block on
+     *       inference, or they starve the rest of the core.
+     */
+    inline priority_result set_current_thread_realtime(int rt_priority = 70) noexcept {
+#if defined(LINUX)
+      sched_param param{};
+      int lo = sched_get_priority_min(SCHED_FIFO);
+      int hi = sched_get_priority_max(SCHED_FIFO);
+      param.sched_priority = rt_priority < lo ? lo : (rt_priority > hi ? hi : rt_priority);
+      if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0) return priority_result::realtime;
+
+      pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+      if (setpriority(PRIO_PROCESS, static_cast<id_t>(tid), -10) == 0) return priority_result::raised;
+      return priority_result::unchanged;
+#elif defined(WINDOWS)
+      (void)rt_priority;
+      return SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL) ? priority_result::raised : priority_result::unchanged;
+#elif defined(macOS)
+      (void)rt_priority;
+      return pthread_set_qos_class_self_np(QOS_CLASS_USER_INTERACTIVE, 0) == 0 ? priority_result::raised : priority_result::unchanged;
+#else
+      (void)rt_priority;
+      return priority_result::unchanged;
+#endif
+    }
+
+    /**
+     * @brief Locks the process' current pages, and future ones when that cannot exhaust the limit.
+     *
+     * @details MCL_FUTURE makes every later mapping fail once RLIMIT_MEMLOCK is reached, which
+     *          would break loading a model, so it is only requested when the limit is unlimited.
+     *          Buffers that must stay resident regardless go through allocate_locked().
+     * @return False if nothing was locked (no privilege / not supported).
+     */
+    inline bool lock_process_memory() noexcept {
+#if defined(LINUX)
+      rlimit limit{};
+      bool unlimited = getrlimit(RLIMIT_MEMLOCK, &limit) == 0 && limit.rlim_cur == RLIM_INFINITY;
+      int flags = MCL_CURRENT | (unlimited ? MCL_FUTURE : 0);
+      return mlockall(flags) == 0;
+#else
+      return false;
+#endif
+    }
+
+    /// Result of prepare_capture_thread().
+    struct capture_thread_report {
+      bool pinned = false;
+      priority_result priority = priority_result::unchanged;
+    };
+
+    /**
+     * @brief Pins the calling capture/resample thread to its reserved CPUs and raises its priority.
+     * @param cpus placement_plan::capture_cpus; empty leaves the affinity alone.
+     */
+    inline capture_thread_report prepare_capture_thread(std::span<const unsigned> cpus, int rt_priority = 70) noexcept {
+      capture_thread_report report;
+      report.pinned = set_current_thread_affinity(cpus);
+      report.priority = set_current_thread_realtime(rt_priority);
+      return report;
+    }
+  }
+}
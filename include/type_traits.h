@@ -1,5 +1,10 @@
 #pragma once
 #include <type_traits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 #include <platform/platform.h>
 
 namespace type_traits {
@@ -85,12 +90,50 @@ namespace type_traits {
 
   template<typename...>
   constexpr bool always_false = false;
+
+  /**
+   * @brief Opt-in: moving a T to new memory and ending the source's lifetime is the same as
+   *        copying its bytes and never destroying the source.
+   *
+   * @details True for trivially copyable types. Specialize it for a type whose objects hold no
+   *          pointer into themselves and are not registered anywhere by address; containers
+   *          then grow with one memcpy instead of a move and a destructor per element.
+   */
+  template<typename T>
+  struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+  template<typename T>
+  inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<std::remove_cv_t<T>>::value;
+
+  template<typename T, typename D>
+  struct is_trivially_relocatable<std::unique_ptr<T, D>> : is_trivially_relocatable<D> {};
+  template<typename T>
+  struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type {};
+  template<typename T>
+  struct is_trivially_relocatable<std::weak_ptr<T>> : std::true_type {};
+  template<typename A, typename B>
+  struct is_trivially_relocatable<std::pair<A, B>> : std::bool_constant<is_trivially_relocatable_v<A> && is_trivially_relocatable_v<B>> {};
+  template<typename T>
+  struct is_trivially_relocatable<std::optional<T>> : is_trivially_relocatable<T> {};
+  template<typename T>
+  struct is_trivially_relocatable<std::allocator<T>> : std::true_type {};
+
+  // std::vector and std::basic_string are relocatable in every implementation except where
+  // they point into themselves: libstdc++'s small string buffer and MSVC's debug iterator proxy.
+#if defined(_LIBCPP_VERSION) || (defined(_MSVC_STL_VERSION) && _ITERATOR_DEBUG_LEVEL == 0) || (defined(__GLIBCXX__) && !defined(_GLIBCXX_DEBUG))
+  template<typename T, typename Alloc>
+  struct is_trivially_relocatable<std::vector<T, Alloc>> : is_trivially_relocatable<Alloc> {};
+#endif
+#if defined(_LIBCPP_VERSION) || (defined(_MSVC_STL_VERSION) && _ITERATOR_DEBUG_LEVEL == 0)
+  template<typename C, typename Traits, typename Alloc>
+  struct is_trivially_relocatable<std::basic_string<C, Traits, Alloc>> : is_trivially_relocatable<Alloc> {};
+#endif
  
   template<typename T>
   struct trivial_traits {
   public:
-    using is_trivially_destructible = std::is_trivially_constructible<T>;
-    using is_trivially_constructible = std::is_trivially_destructible<T>;
+    using is_trivially_destructible = std::is_trivially_destructible<T>;
+    using is_trivially_constructible = std::is_trivially_constructible<T>;
     using is_trivially_copyable = std::is_trivially_copyable<T>;
     using is_trivially_copy_constructible = std::is_trivially_copy_constructible<T>;
     using is_trivially_move_constructible = std::is_trivially_move_constructible<T>;
@@ -135,6 +178,21 @@ namespace type_traits {
   template<typename Alloc, typename Pointer>
   constexpr bool has_destroy_v = has_destroy<Alloc, Pointer>::value;
 
+  template<typename Alloc, typename Pointer, typename Size, typename = void>
+  struct has_reallocate : std::false_type {};
+
+  template<typename Alloc, typename Pointer, typename Size>
+  struct has_reallocate<
+    Alloc,
+    Pointer,
+    Size,
+    std::void_t<decltype(std::declval<Alloc&>().reallocate(std::declval<Pointer>(), std::declval<Size>(), std::declval<Size>()))>
+  > : std::true_type {
+  };
+
+  template<typename Alloc, typename Pointer, typename Size>
+  constexpr bool has_reallocate_v = has_reallocate<Alloc, Pointer, Size>::value;
+
   template<typename Alloc, typename Pointer, typename... Args>
   struct has_construct {
   private:
@@ -51,22 +51,31 @@
 #include <audioclient.h>
 #include <avrt.h>
 #include <comdef.h>
+#include <atomic>
 #include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <fstream>
+#include <future>
 #include <iostream>
+#include <span>
 #include <string>
 #include <thread>
 #include <vector>
 
 #include "whisper.h"
+#include <platform/cpu_topology.h>
+#include <platform/thread_priority.h>
+#include <inference/auto_tuner.h>
+#include <containers/impl/heap_array.h>
+#include <audio/realtime/capture_converter.h>
+#include <audio/realtime/capture_ring.h>
 
-static const int n_threads = std::min(4, (int)std::thread::hardware_concurrency());
 static const int step_ms = 15000;
 static const int length_ms = 15000;
 static const int keep_ms = 0;
+static const int capture_chunk_ms = 100; // capture thread -> main thread hand-off
 
 //
 // Minimal WASAPI loopback capture helper
@@ -134,6 +143,10 @@ public:
     channels = pwfx->nChannels;
     device_sample_rate = pwfx->nSamplesPerSec;
     bytes_per_sample = pwfx->wBitsPerSample / 8;
+    converter = audio::capture_converter<int16_t>(source_format_of(pwfx), (uint16_t)channels, device_sample_rate, WHISPER_SAMPLE_RATE);
+    if (!converter.supported()) {
+      fprintf(stderr, "WASAPI: unsupported mix format (tag 0x%04x, %u bits); capturing silence\n", pwfx->wFormatTag, pwfx->wBitsPerSample);
+    }
 
     return true;
   }
@@ -156,18 +169,15 @@ public:
     }
   }
 
-  bool get(int ms, std::vector<float>& out) {
+  // fills out until it holds ms worth of 16 kHz mono; device silence becomes a run length, not zeros.
+  // Packets are taken whole, so out may end up a few samples past ms; the caller keeps the rest.
+  // Returns false on a device error, or once stop is set (checked while idle and after each packet).
+  bool get(int ms, audio::capture_ring_s16& out, const std::atomic<bool>& stop) {
     if (!pCaptureClient || !pwfx) return false;
 
-    const uint32_t wanted_frames = (uint32_t)((int64_t)ms * WHISPER_SAMPLE_RATE / 1000);
-    out.clear();
-    out.reserve(wanted_frames);
-
-    uint32_t collected = 0;
+    const size_t wanted = (size_t)((int64_t)ms * WHISPER_SAMPLE_RATE / 1000);
 
-    int loops = 0;
-
-    while (collected < wanted_frames) {
+    while (out.size() < wanted) {
       UINT32 packetFrames = 0;
       HRESULT hr = pCaptureClient->GetNextPacketSize(&packetFrames);
       if (FAILED(hr)) {
@@ -176,7 +186,8 @@ public:
       }
 
       if (packetFrames == 0) {
-        // no data yet: sleep small bit
+        // no data yet (loopback delivers nothing while nothing plays): sleep small bit
+        if (stop.load(std::memory_order_relaxed)) return false;
         std::this_thread::sleep_for(std::chrono::milliseconds(5));
         continue;
       }
@@ -190,51 +201,13 @@ public:
         return false;
       }
 
-      if (flags & AUDCLNT_BUFFERFLAGS_SILENT) {
-        for (UINT32 f = 0; f < framesAvailable && collected < wanted_frames; ++f) {
-          out.push_back(0.0f);
-          ++collected;
-        }
+      // convert, downmix and resample in one pass straight into out; unsupported formats are
+      // recorded as silence, as they were zero-filled before
+      if ((flags & AUDCLNT_BUFFERFLAGS_SILENT) || !converter.supported()) {
+        out.append_silence(converter.skip(framesAvailable));
       }
       else {
-        if (pwfx->wFormatTag == WAVE_FORMAT_IEEE_FLOAT ||
-          (pwfx->wFormatTag == WAVE_FORMAT_EXTENSIBLE && ((WAVEFORMATEXTENSIBLE*)pwfx)->SubFormat == KSDATAFORMAT_SUBTYPE_IEEE_FLOAT)) {
-
-          const float* src = reinterpret_cast<const float*>(pData);
-          for (UINT32 f = 0; f < framesAvailable; ++f) {
-            float sample = 0.0f;
-            for (int c = 0; c < channels; ++c) {
-              sample += src[f * channels + c];
-            }
-            sample /= (float)channels;
-            append_sample_resample(sample, device_sample_rate, out, collected, wanted_frames);
-          }
-        }
-        else if (pwfx->wFormatTag == WAVE_FORMAT_PCM) {
-          if (bytes_per_sample == 2) {
-            const int16_t* src = reinterpret_cast<const int16_t*>(pData);
-            for (UINT32 f = 0; f < framesAvailable; ++f) {
-              float sample = 0.0f;
-              for (int c = 0; c < channels; ++c) {
-                sample += src[f * channels + c] / 32768.0f;
-              }
-              sample /= (float)channels;
-              append_sample_resample(sample, device_sample_rate, out, collected, wanted_frames);
-            }
-          }
-          else {
-            for (UINT32 f = 0; f < framesAvailable && collected < wanted_frames; ++f) {
-              out.push_back(0.0f);
-              ++collected;
-            }
-          }
-        }
-        else {
-          for (UINT32 f = 0; f < framesAvailable && collected < wanted_frames; ++f) {
-            out.push_back(0.0f);
-            ++collected;
-          }
-        }
+        converter.process(pData, framesAvailable, out);
       }
 
       hr = pCaptureClient->ReleaseBuffer(framesAvailable);
@@ -242,11 +215,8 @@ public:
         fprintf(stderr, "WASAPI: ReleaseBuffer failed: 0x%08x\n", hr);
         return false;
       }
-    }
-
-    while (collected < wanted_frames) {
-      out.push_back(0.0f);
-      ++collected;
+      // under continuous playback packets never run out, so the idle check alone could miss stop
+      if (stop.load(std::memory_order_relaxed)) return false;
     }
 
     return true;
@@ -263,25 +233,42 @@ private:
   UINT32 bytes_per_sample;
   bool running;
 
-  void append_sample_resample(float sample, uint32_t dev_rate, std::vector<float>& out, uint32_t& collected, uint32_t wanted_frames) {
-    static double acc = 0.0;
-    const double ratio = (double)dev_rate / (double)WHISPER_SAMPLE_RATE;
-    if (dev_rate == WHISPER_SAMPLE_RATE) {
-      if (collected < wanted_frames) { out.push_back(sample); ++collected; }
-      return;
-    }
-    acc += 1.0 / ratio;
-    if (acc >= 1.0) {
-      if (collected < wanted_frames) { out.push_back(sample); ++collected; }
-      acc -= 1.0;
+  audio::capture_converter<int16_t> converter;
+
+  static audio::source_format source_format_of(const WAVEFORMATEX* wfx) {
+    bool is_float = wfx->wFormatTag == WAVE_FORMAT_IEEE_FLOAT;
+    bool is_pcm = wfx->wFormatTag == WAVE_FORMAT_PCM;
+    if (wfx->wFormatTag == WAVE_FORMAT_EXTENSIBLE) {
+      const GUID& sub = ((const WAVEFORMATEXTENSIBLE*)wfx)->SubFormat;
+      is_float = sub == KSDATAFORMAT_SUBTYPE_IEEE_FLOAT;
+      is_pcm = sub == KSDATAFORMAT_SUBTYPE_PCM;
     }
-    else {
-      //skip
+    // the container size decides the layout; 24 valid bits in 32 read fine as s32
+    if (is_float && wfx->wBitsPerSample == 32) return audio::source_format::f32;
+    if (is_pcm) {
+      switch (wfx->wBitsPerSample) {
+      case 16: return audio::source_format::s16;
+      case 24: return audio::source_format::s24;
+      case 32: return audio::source_format::s32;
+      }
     }
+    return audio::source_format::unsupported;
   }
 };
 
-int main() {
+int main(int argc, char** argv) {
+  // one inference thread per physical core sharing an L3; SMT siblings and the capture core stay free.
+  // whisper/ggml spawn their workers without exposing placement, so they get the process-wide default
+  // (inherited mask on Linux, default CPU sets on Windows); the capture thread pins itself elsewhere.
+  const voxory::platform::cpu_topology topology = voxory::platform::cpu_topology::detect();
+  const voxory::platform::placement_plan placement = voxory::platform::plan_placement(topology);
+  int n_threads = std::max(1, (int)placement.inference_cpus.size());
+  const bool inference_pinned = voxory::platform::set_worker_affinity(placement.inference_cpus);
+  fprintf(stderr, "placement: %zu logical / %zu physical cpus, %d inference threads (pinned=%d), %zu capture cpus\n",
+    topology.logical_count(), topology.physical_count(), n_threads, inference_pinned ? 1 : 0, placement.capture_cpus.size());
+  // before the model is mapped: pages touched so far (and later ones, when the limit allows) stay resident
+  const bool memory_locked = voxory::platform::lock_process_memory();
+
   ggml_backend_load_all();
 
   const int n_samples_step = (1e-3 * step_ms) * WHISPER_SAMPLE_RATE;
@@ -298,24 +285,84 @@ int main() {
   cparams.use_gpu = true;
   cparams.flash_attn = true;
 
+  // thread count and flash-attn measured once per CPU model and model file, then cached; --retune forces a new sweep
+  voxory::inference::tuner_options tune_opts;
+  tune_opts.max_threads = n_threads;
+  for (int i = 1; i < argc; ++i) {
+    if (std::string(argv[i]) == "--retune") tune_opts.force = true;
+  }
+  bool tuned_from_cache = false;
+  const voxory::inference::tuned_params tuned = voxory::inference::load_or_tune(model_path, cparams, tune_opts, voxory::inference::tuning_cache(), &tuned_from_cache);
+  n_threads = tuned.n_threads;
+  cparams.flash_attn = tuned.flash_attn;
+  fprintf(stderr, "tuning (%s): %d threads, flash_attn=%d\n", tuned_from_cache ? "cached" : "measured", n_threads, tuned.flash_attn ? 1 : 0);
+
   struct whisper_context* ctx = whisper_init_from_file_with_params(model_path.c_str(), cparams);
   if (ctx == nullptr) {
     fprintf(stderr, "error: failed to initialize whisper context\n");
     return 2;
   }
 
-  std::vector<float> pcmf32(n_samples_30s, 0.0f);
-  std::vector<float> pcmf32_old;
-  std::vector<float> pcmf32_new(n_samples_30s, 0.0f);
+  // 64 B aligned; every element is written each iteration, so resizing must not zero-fill first
+  voxory::containers::aligned_heap_array<float> pcmf32(n_samples_30s, voxory::containers::default_init);
+  // captured audio, the window and its history stay int16 (half the bytes of float);
+  // float exists only in pcmf32, filled right before whisper_full()
+  voxory::containers::aligned_heap_array<int16_t> pcm16(n_samples_30s, voxory::containers::default_init);
+  std::vector<int16_t> pcm16_old;
+  audio::capture_ring_s16 captured(n_samples_30s);
   std::vector<whisper_token> prompt_tokens;
 
-  WasapiLoopback wasapi;
-  if (!wasapi.init(WHISPER_SAMPLE_RATE)) {
-    fprintf(stderr, "Failed to init WASAPI loopback\n");
-    return 1;
-  }
-  if (!wasapi.start()) {
-    fprintf(stderr, "Failed to start WASAPI capture\n");
+  // Capture runs on its own thread, pinned to the reserved capture cores at real-time priority,
+  // so a whisper_full() call never delays the device reads. Every capture_chunk_ms it publishes what
+  // it got through a preallocated lock-free hand-off (silence stays a run length) and bumps
+  // capture_epoch; it never takes a lock or allocates. This thread drains it into captured.
+  // 30 s in flight; WASAPI packets are ~10 ms, so one run per millisecond leaves ample room.
+  const size_t capture_chunk_samples = (size_t)capture_chunk_ms * WHISPER_SAMPLE_RATE / 1000;
+  const size_t runs_per_ms = WHISPER_SAMPLE_RATE / 1000;
+  audio::capture_handoff_s16 capture_handoff(n_samples_30s, n_samples_30s / runs_per_ms);
+  std::atomic<uint32_t> capture_epoch{ 0 };
+  std::atomic<bool> capture_failed{ false };
+  std::atomic<bool> capture_stop{ false };
+  std::promise<bool> capture_started;
+  std::future<bool> capture_started_result = capture_started.get_future();
+
+  std::thread capture_thread([&] {
+    const voxory::platform::capture_thread_report report = voxory::platform::prepare_capture_thread(placement.capture_cpus);
+    fprintf(stderr, "capture thread: pinned=%d, priority=%d, memory locked=%d\n",
+      report.pinned ? 1 : 0, (int)report.priority, memory_locked ? 1 : 0);
+
+    WasapiLoopback wasapi; // COM is initialized per thread, so the device lives here
+    if (!wasapi.init(WHISPER_SAMPLE_RATE)) {
+      fprintf(stderr, "Failed to init WASAPI loopback\n");
+      capture_started.set_value(false);
+      return;
+    }
+    if (!wasapi.start()) {
+      fprintf(stderr, "Failed to start WASAPI capture\n");
+      capture_started.set_value(false);
+      return;
+    }
+
+    // sized so a chunk never grows it: whole packets can overshoot the chunk, and at most every
+    // millisecond of it switches between silence and signal
+    audio::capture_ring_s16 pending(capture_chunk_samples * 2, capture_chunk_samples * 2 / runs_per_ms);
+    capture_started.set_value(true);
+
+    while (!capture_stop.load(std::memory_order_relaxed)) {
+      const bool ok = wasapi.get(capture_chunk_ms, pending, capture_stop);
+      (void)capture_handoff.push(pending); // a full hand-off counts the chunk as dropped
+      pending.clear();
+      if (!ok && !capture_stop.load(std::memory_order_relaxed)) capture_failed.store(true, std::memory_order_release);
+      capture_epoch.fetch_add(1, std::memory_order_release);
+      capture_epoch.notify_one();
+      if (!ok) break;
+    }
+    wasapi.stop();
+  });
+
+  if (!capture_started_result.get()) {
+    capture_thread.join();
+    whisper_free(ctx);
     return 1;
   }
 
@@ -324,23 +371,42 @@ int main() {
 
   int n_iter = 0;
   bool is_running = true;
+  size_t capture_dropped_reported = 0;
 
   while (is_running) {
     if (!use_vad) {
-      if (!wasapi.get(step_ms, pcmf32_new)) {
+      // read the epoch before draining, so a chunk published in between still wakes the wait
+      for (;;) {
+        const uint32_t epoch = capture_epoch.load(std::memory_order_acquire);
+        capture_handoff.drain_into(captured);
+        if (captured.size() >= (size_t)n_samples_step || capture_failed.load(std::memory_order_acquire)) break;
+        capture_epoch.wait(epoch, std::memory_order_acquire);
+      }
+      if (captured.size() < (size_t)n_samples_step) {
         fprintf(stderr, "WASAPI get failed\n");
         break;
       }
+      if (const size_t dropped = capture_handoff.dropped(); dropped != capture_dropped_reported) {
+        fprintf(stderr, "capture: %zu samples dropped, inference fell behind\n", dropped - capture_dropped_reported);
+        capture_dropped_reported = dropped;
+      }
 
-      const int n_samples_new = pcmf32_new.size();
-      const int n_samples_take = std::min((int)pcmf32_old.size(), std::max(0, n_samples_keep + n_samples_len - n_samples_new));
+      // the capture thread hands over whole packets; what goes past the step waits for the next one
+      const int n_samples_new = n_samples_step;
+      const bool silent_step = captured.is_silent(n_samples_new); // O(runs), not O(samples)
+      const int n_samples_take = std::min((int)pcm16_old.size(), std::max(0, n_samples_keep + n_samples_len - n_samples_new));
 
-      pcmf32.resize(n_samples_new + n_samples_take);
-      for (int i = 0; i < n_samples_take; ++i) {
-        pcmf32[i] = pcmf32_old[pcmf32_old.size() - n_samples_take + i];
-      }
-      memcpy(pcmf32.data() + n_samples_take, pcmf32_new.data(), n_samples_new * sizeof(float));
-      pcmf32_old = pcmf32;
+      pcm16.resize_for_overwrite(n_samples_new + n_samples_take);
+      std::copy_n(pcm16_old.end() - n_samples_take, n_samples_take, pcm16.data());
+      captured.read(std::span<int16_t>(pcm16.data() + n_samples_take, n_samples_new));
+      pcm16_old.assign(pcm16.begin(), pcm16.end());
+
+      // the device reported nothing but silence and there is no history: nothing to transcribe
+      if (silent_step && n_samples_take == 0) continue;
+
+      // inference boundary: one SIMD pass to float
+      pcmf32.resize_for_overwrite(pcm16.size());
+      audio::s16_to_f32(pcm16.data(), pcmf32.data(), pcm16.size());
     }
     else {
       std::this_thread::sleep_for(std::chrono::milliseconds(100));
@@ -373,11 +439,12 @@ int main() {
     ++n_iter;
 
     if (!use_vad && (n_iter % n_new_line) == 0) {
-      pcmf32_old = std::vector<float>(pcmf32.end() - n_samples_keep, pcmf32.end());
+      pcm16_old.assign(pcm16.end() - n_samples_keep, pcm16.end());
     }
   }
 
-  wasapi.stop();
+  capture_stop.store(true, std::memory_order_relaxed);
+  capture_thread.join();
   whisper_free(ctx);
   return 0;
 }
@@ -0,0 +1,84 @@
+#include <tests_details.h>
+#include <audio/audio.h>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+using audio::audio_buffer;
+using audio::audio_format;
+using audio::audio_view;
+using namespace std::chrono_literals;
+
+NOYX_TEST(audio_buffer_test, aligned_frame_aware_storage) {
+  audio_buffer<> buf(audio_format{ 48000, 2 }, 100);
+  NOYX_ASSERT_EQ(buf.size(), (size_t)200);
+  NOYX_ASSERT_EQ(buf.frames(), (size_t)100);
+  NOYX_ASSERT_EQ(reinterpret_cast<std::uintptr_t>(buf.data()) % 64, (std::uintptr_t)0);
+  for (float s : buf) NOYX_ASSERT_EQ(s, 0.0f);
+
+  buf.resize_frames(10);
+  NOYX_ASSERT_EQ(buf.size(), (size_t)20);
+  buf << 1.0f << 2.0f;
+  NOYX_ASSERT_EQ(buf.frames(), (size_t)11);
+  NOYX_ASSERT_EQ(buf[21], 2.0f);
+
+  buf.clear();
+  NOYX_ASSERT_TRUE(buf.empty());
+  NOYX_ASSERT_EQ(buf.channels(), (uint16_t)2);
+}
+
+NOYX_TEST(audio_buffer_test, copy_move_and_swap) {
+  const float src[] = { 0.5f, -0.5f, 0.25f, -0.25f };
+  audio_buffer<> a(src, 4, audio_format{ 16000, 1 });
+  a.set_timestamp(1s);
+
+  audio_buffer<> b(a);
+  NOYX_ASSERT_EQ(b.size(), (size_t)4);
+  NOYX_ASSERT_EQ(b[3], -0.25f);
+  NOYX_ASSERT_TRUE(b.data() != a.data());
+  NOYX_ASSERT_TRUE(b.timestamp() == 1s);
+
+  const float* p = a.data();
+  audio_buffer<> c(std::move(a));
+  NOYX_ASSERT_TRUE(c.data() == p);
+  NOYX_ASSERT_TRUE(a.empty());
+
+  audio_buffer<> d;
+  d = c;
+  NOYX_ASSERT_EQ(d.size(), (size_t)4);
+  d.assign(3, 1.0f);
+  swap(c, d);
+  NOYX_ASSERT_EQ(c.size(), (size_t)3);
+  NOYX_ASSERT_EQ(d[0], 0.5f);
+}
+
+NOYX_TEST(audio_buffer_test, views_share_storage_and_carry_time) {
+  audio_buffer<> buf(audio_format{ 1000, 2 }, 1000); // 1 s of stereo
+  for (size_t i = 0; i < buf.size(); ++i) buf[i] = static_cast<float>(i);
+  buf.set_timestamp(5s);
+
+  audio_view all = buf;
+  NOYX_ASSERT_EQ(all.frames(), (size_t)1000);
+  NOYX_ASSERT_TRUE(all.duration() == 1s);
+
+  audio_view mid = buf.view(250, 500);
+  NOYX_ASSERT_TRUE(mid.data() == buf.data() + 500);
+  NOYX_ASSERT_EQ(mid.sample(0, 1), 501.0f);
+  NOYX_ASSERT_TRUE(mid.start_time() == 5250ms);
+  NOYX_ASSERT_TRUE(mid.end_time() == 5750ms);
+
+  audio_view tail = mid.last(100);
+  NOYX_ASSERT_EQ(tail.offset(), (size_t)650);
+  NOYX_ASSERT_TRUE(tail.start_time() == 5650ms);
+
+  audio_view window = all.between(5100ms, 5200ms);
+  NOYX_ASSERT_EQ(window.frames(), (size_t)100);
+  NOYX_ASSERT_EQ(window.sample(0), 200.0f);
+
+  NOYX_ASSERT_EQ(all.subview(900, 500).frames(), (size_t)100);
+
+  audio_buffer<> copy(mid);
+  NOYX_ASSERT_EQ(copy.frames(), (size_t)500);
+  NOYX_ASSERT_TRUE(copy.timestamp() == 5250ms);
+  NOYX_ASSERT_EQ(copy[0], 500.0f);
+}
@@ -0,0 +1,155 @@
+#include <tests_details.h>
+#include <audio/realtime/capture_converter.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using audio::capture_converter;
+using audio::capture_ring;
+using audio::capture_ring_s16;
+using audio::source_format;
+
+NOYX_TEST(capture_converter_test, stereo_s16_48k_to_16k_mono) {
+  // left 0.5, right 0.25: every output is the average of three mono frames of 0.375
+  std::vector<int16_t> packet(2 * 480);
+  for (size_t f = 0; f < 480; ++f) {
+    packet[2 * f] = 16384;
+    packet[2 * f + 1] = 8192;
+  }
+  capture_converter<float> conv(source_format::s16, 2, 48000, 16000);
+  NOYX_ASSERT_TRUE(conv.supported());
+  capture_ring ring(8); // small, so the kernel writes across the wrap point and the ring grows
+  size_t produced = 0;
+  for (int i = 0; i < 10; ++i) produced += conv.process(packet.data(), 480, ring);
+
+  NOYX_ASSERT_EQ(produced, (size_t)1600);
+  NOYX_ASSERT_EQ(ring.size(), (size_t)1600);
+  std::vector<float> out(1600);
+  NOYX_ASSERT_EQ(ring.read(out), (size_t)1600);
+  bool all = true;
+  for (float v : out) all = all && v == 0.375f;
+  NOYX_ASSERT_TRUE(all);
+
+  NOYX_ASSERT_FALSE(capture_converter<float>(source_format::unsupported, 2, 48000).supported());
+  NOYX_ASSERT_FALSE(capture_converter<float>(source_format::f32, 0, 48000).supported());
+}
+
+NOYX_TEST(capture_converter_test, packet_boundaries_do_not_change_the_output) {
+  // 44.1 kHz 5.1 float (generic channel loop), 8 kHz mono (interpolation), 16 kHz stereo
+  // (no resampling) and 48 kHz stereo (integer ratio), one stream each
+  struct config { uint16_t channels; uint32_t rate; };
+  const config configs[] = { { 6, 44100 }, { 1, 8000 }, { 2, 16000 }, { 2, 48000 } };
+  for (const config& c : configs) {
+    const size_t frames = 9000;
+    std::vector<float> stream(frames * c.channels);
+    for (size_t i = 0; i < stream.size(); ++i) stream[i] = std::sin(0.001f * static_cast<float>(i));
+
+    capture_converter<int16_t> whole(source_format::f32, c.channels, c.rate);
+    capture_ring_s16 a;
+    whole.process(stream.data(), frames, a);
+
+    capture_converter<int16_t> split(source_format::f32, c.channels, c.rate);
+    capture_ring_s16 b;
+    size_t done = 0;
+    unsigned seed = 7;
+    while (done < frames) {
+      seed = seed * 1103515245u + 12345u;
+      const size_t n = std::min<size_t>(frames - done, (seed >> 16) % 700);
+      split.process(stream.data() + done * c.channels, n, b);
+      done += n;
+    }
+
+    NOYX_ASSERT_EQ(a.size(), b.size());
+    NOYX_ASSERT_GE(a.size(), frames * 16000 / c.rate - 1);
+    NOYX_ASSERT_TRUE(a.size() <= frames * 16000 / c.rate + 1);
+    std::vector<int16_t> x(a.size()), y(b.size());
+    a.read(x);
+    b.read(y);
+    NOYX_ASSERT_TRUE(x == y);
+  }
+}
+
+NOYX_TEST(capture_converter_test, silent_packets_keep_the_output_rate) {
+  // 44.1 kHz: mixing process() and skip() must produce as many samples as process() alone
+  std::vector<int32_t> packet(441 * 2, 1 << 30); // s32 stereo at 0.5
+  capture_converter<float> conv(source_format::s32, 2, 44100);
+  capture_converter<float> reference(source_format::s32, 2, 44100);
+  capture_ring ring;
+  capture_ring ref_ring;
+  for (int i = 0; i < 100; ++i) {
+    const size_t frames = 441 - static_cast<size_t>(i % 5) * 37;
+    if (i % 3 == 0) ring.append_silence(conv.skip(frames));
+    else conv.process(packet.data(), frames, ring);
+    reference.process(packet.data(), frames, ref_ring);
+  }
+  NOYX_ASSERT_EQ(ring.size(), ref_ring.size());
+  NOYX_ASSERT_TRUE(ring.silent() > 0);
+
+  capture_converter<float> up(source_format::s16, 1, 8000);
+  capture_converter<float> up_reference(source_format::s16, 1, 8000);
+  std::vector<int16_t> mono(333, 1000);
+  capture_ring up_ring;
+  capture_ring up_ref_ring;
+  for (int i = 0; i < 50; ++i) {
+    if (i % 2 == 0) up_ring.append_silence(up.skip(mono.size()));
+    else up.process(mono.data(), mono.size(), up_ring);
+    up_reference.process(mono.data(), mono.size(), up_ref_ring);
+  }
+  NOYX_ASSERT_EQ(up_ring.size(), up_ref_ring.size());
+}
+
+// one pass over the packet vs. the separate convert, downmix and resample stages it replaces
+NOYX_TEST(capture_converter_test, fused_vs_staged_timing) {
+  using clk = std::chrono::steady_clock;
+  using rep = std::chrono::duration<double, std::milli>;
+  constexpr size_t frames = 480; // 10 ms at 48 kHz, a typical shared-mode packet
+  constexpr int packets = 5000;
+  std::vector<int16_t> packet(frames * 2);
+  for (size_t i = 0; i < packet.size(); ++i) packet[i] = static_cast<int16_t>(i * 37);
+
+  auto report = [](const char* name, rep d) {
+    std::cout.setf(std::ios::fixed); std::cout << std::setprecision(3);
+    std::cout << "[TIMING] " << name << " : " << d.count() << " ms\n";
+    std::cout.unsetf(std::ios::fixed);
+  };
+
+  // best of a few rounds after a warm-up one, so neither side pays for cold caches
+  auto best_of = [](auto&& round) {
+    round();
+    rep best = rep::max();
+    for (int r = 0; r < 5; ++r) {
+      const auto s = clk::now();
+      round();
+      best = std::min<rep>(best, clk::now() - s);
+    }
+    return best;
+  };
+
+  capture_converter<int16_t> conv(source_format::s16, 2, 48000);
+  capture_ring_s16 fused_ring(frames);
+  report("fused s16 stereo 48k -> 16k", best_of([&] {
+    for (int p = 0; p < packets; ++p) {
+      conv.process(packet.data(), frames, fused_ring);
+      fused_ring.discard(fused_ring.size());
+    }
+  }));
+
+  capture_ring_s16 staged_ring(frames);
+  std::vector<float> converted(frames * 2), mono(frames), resampled(frames);
+  report("staged s16 stereo 48k -> 16k", best_of([&] {
+    for (int p = 0; p < packets; ++p) {
+      audio::s16_to_f32(packet.data(), converted.data(), converted.size());
+      for (size_t f = 0; f < frames; ++f) mono[f] = (converted[2 * f] + converted[2 * f + 1]) * 0.5f;
+      size_t n = 0;
+      for (size_t f = 0; f + 3 <= frames; f += 3) resampled[n++] = (mono[f] + mono[f + 1] + mono[f + 2]) / 3.0f;
+      staged_ring.append(std::span<const float>(resampled.data(), n));
+      staged_ring.discard(staged_ring.size());
+    }
+  }));
+  NOYX_ASSERT_TRUE(fused_ring.empty() && staged_ring.empty());
+}
@@ -0,0 +1,183 @@
+#include <tests_details.h>
+#include <audio/realtime/capture_ring.h>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <vector>
+
+using audio::capture_ring;
+using audio::capture_ring_s16;
+using audio::capture_handoff_s16;
+
+NOYX_TEST(capture_ring_test, silence_is_stored_as_runs) {
+  capture_ring ring(16);
+  const float speech[] = { 0.5f, -0.5f, 0.25f };
+  ring.append(speech);
+  ring.append_silence(48000 * 60); // a minute of device silence
+  ring.append_silence(480);        // extends the same run
+  ring.append(speech);
+
+  NOYX_ASSERT_EQ(ring.size(), (size_t)(6 + 48000 * 60 + 480));
+  NOYX_ASSERT_EQ(ring.stored(), (size_t)6);
+  NOYX_ASSERT_EQ(ring.silent(), (size_t)(48000 * 60 + 480));
+  NOYX_ASSERT_EQ(ring.runs(), (size_t)3);
+  NOYX_ASSERT_EQ(ring.leading_silence(), (size_t)0);
+  NOYX_ASSERT_FALSE(ring.is_silent(4));
+  NOYX_ASSERT_EQ(ring.energy(ring.size()), 2 * (0.25 + 0.25 + 0.0625));
+
+  // PCM readers see the zeros
+  std::vector<float> out(8, 9.0f);
+  NOYX_ASSERT_EQ(ring.copy_front(out), (size_t)8);
+  NOYX_ASSERT_EQ(out[2], 0.25f);
+  for (size_t i = 3; i < 8; ++i) NOYX_ASSERT_EQ(out[i], 0.0f);
+
+  NOYX_ASSERT_EQ(ring.read(std::span<float>(out).first(3)), (size_t)3);
+  NOYX_ASSERT_EQ(ring.leading_silence(), (size_t)(48000 * 60 + 480));
+  NOYX_ASSERT_TRUE(ring.is_silent(48000 * 60));
+  NOYX_ASSERT_EQ(ring.discard(48000 * 60), (size_t)(48000 * 60));
+  NOYX_ASSERT_EQ(ring.leading_silence(), (size_t)480);
+
+  out.assign(483, 9.0f);
+  NOYX_ASSERT_EQ(ring.read(out), (size_t)483);
+  NOYX_ASSERT_EQ(out[479], 0.0f);
+  NOYX_ASSERT_EQ(out[480], 0.5f);
+  NOYX_ASSERT_EQ(out[482], 0.25f);
+  NOYX_ASSERT_TRUE(ring.empty());
+  NOYX_ASSERT_EQ(ring.runs(), (size_t)0);
+  NOYX_ASSERT_EQ(ring.silent(), (size_t)0);
+}
+
+NOYX_TEST(capture_ring_test, matches_a_plain_fifo_across_wraps) {
+  capture_ring ring(8); // small, so the sample ring wraps and grows
+  std::vector<float> model;
+  size_t model_front = 0;
+  unsigned state = 12345;
+  auto next = [&] { state = state * 1103515245u + 12345u; return (state >> 16) & 0x7fff; };
+
+  bool same = true;
+  for (int step = 0; step < 2000; ++step) {
+    const size_t n = next() % 24;
+    switch (next() % 3) {
+    case 0: {
+      std::vector<float> packet(n);
+      for (size_t i = 0; i < n; ++i) packet[i] = static_cast<float>(next() % 200) / 100.0f - 1.0f;
+      ring.append(packet);
+      model.insert(model.end(), packet.begin(), packet.end());
+      break;
+    }
+    case 1:
+      ring.append_silence(n);
+      model.insert(model.end(), n, 0.0f);
+      break;
+    default: {
+      std::vector<float> out(n, 9.0f);
+      const size_t got = ring.read(out);
+      if (got != std::min(n, model.size() - model_front)) same = false;
+      for (size_t i = 0; i < got; ++i) same = same && out[i] == model[model_front + i];
+      model_front += got;
+      break;
+    }
+    }
+    if (ring.size() != model.size() - model_front) same = false;
+  }
+  NOYX_ASSERT_TRUE(same);
+
+  double expected = 0.0;
+  for (size_t i = model_front; i < model.size(); ++i) expected += static_cast<double>(model[i]) * model[i];
+  NOYX_ASSERT_EQ(ring.energy(ring.size()), expected);
+  NOYX_ASSERT_TRUE(ring.stored() + ring.silent() == ring.size());
+}
+
+NOYX_TEST(capture_ring_test, int16_storage_converts_at_the_boundary) {
+  capture_ring_s16 ring(4);
+  const float packet[] = { 0.5f, -0.25f, 1.0f, -1.0f, 0.125f };
+  ring.append(packet);           // float in, stored as int16
+  ring.append_silence(3);
+  const int16_t raw[] = { 16384, -32768 };
+  ring.append(raw);              // already int16: copied as is
+
+  NOYX_ASSERT_EQ(ring.size(), (size_t)10);
+  NOYX_ASSERT_EQ(ring.stored(), (size_t)7);
+  NOYX_ASSERT_EQ(ring.energy(5), 0.25 + 0.0625 + (32767.0 / 32768) * (32767.0 / 32768) + 1.0 + 0.015625);
+
+  int16_t first[2] = {};
+  NOYX_ASSERT_EQ(ring.copy_front(first), (size_t)2);
+  NOYX_ASSERT_EQ(first[0], (int16_t)16384);
+  NOYX_ASSERT_EQ(first[1], (int16_t)-8192);
+
+  std::vector<float> window(10, 9.0f); // the float window handed to inference
+  NOYX_ASSERT_EQ(ring.read(window), (size_t)10);
+  const float expected[] = { 0.5f, -0.25f, 32767.0f / 32768, -1.0f, 0.125f, 0.0f, 0.0f, 0.0f, 0.5f, -1.0f };
+  for (size_t i = 0; i < 10; ++i) NOYX_ASSERT_EQ(window[i], expected[i]);
+  NOYX_ASSERT_TRUE(ring.empty());
+}
+
+NOYX_TEST(capture_ring_test, handoff_keeps_runs_and_drops_what_does_not_fit) {
+  capture_handoff_s16 handoff(8, 4);
+  capture_ring_s16 batch(8);
+  const int16_t speech[] = { 1, 2, 3 };
+  batch.append(speech);
+  batch.append_silence(16000);
+  NOYX_ASSERT_TRUE(handoff.push(batch));
+
+  // 3 of 8 samples in flight: a 6-sample batch is dropped whole
+  capture_ring_s16 big(8);
+  const int16_t more[] = { 4, 5, 6, 7, 8, 9 };
+  big.append(more);
+  NOYX_ASSERT_FALSE(handoff.push(big));
+  NOYX_ASSERT_EQ(handoff.dropped(), (size_t)6);
+
+  capture_ring_s16 out(2);
+  NOYX_ASSERT_EQ(handoff.drain_into(out), (size_t)16003);
+  NOYX_ASSERT_EQ(out.stored(), (size_t)3);
+  NOYX_ASSERT_EQ(out.silent(), (size_t)16000);
+  NOYX_ASSERT_EQ(out.runs(), (size_t)2);
+  NOYX_ASSERT_EQ(handoff.drain_into(out), (size_t)0);
+
+  // drained: the same batch fits again
+  NOYX_ASSERT_TRUE(handoff.push(big));
+}
+
+NOYX_TEST(capture_ring_test, handoff_across_threads) {
+  constexpr int chunks = 2000;
+  capture_handoff_s16 handoff(64, 16);
+  std::atomic<bool> done{ false };
+
+  // every chunk is 5 counting samples then 3 silent ones
+  std::thread producer([&] {
+    capture_ring_s16 chunk(8);
+    int16_t next = 0;
+    for (int c = 0; c < chunks; ++c) {
+      int16_t samples[5];
+      for (int16_t& v : samples) v = next++;
+      chunk.append(std::span<const int16_t>(samples));
+      chunk.append_silence(3);
+      while (!handoff.push(chunk)) std::this_thread::yield();
+      chunk.clear();
+    }
+    done.store(true, std::memory_order_release);
+  });
+
+  capture_ring_s16 out(64);
+  std::vector<int16_t> seen;
+  size_t silent = 0;
+  auto take = [&] {
+    handoff.drain_into(out);
+    out.for_each_segment(out.size(), [&](const int16_t* samples, size_t count) {
+      if (samples == nullptr) silent += count;
+      else seen.insert(seen.end(), samples, samples + count);
+    });
+    out.discard(out.size());
+  };
+  while (!done.load(std::memory_order_acquire)) take();
+  producer.join();
+  take();
+
+  bool in_order = seen.size() == (size_t)chunks * 5;
+  for (size_t i = 0; in_order && i < seen.size(); ++i) in_order = seen[i] == (int16_t)i;
+  NOYX_ASSERT_TRUE(in_order);
+  NOYX_ASSERT_EQ(silent, (size_t)chunks * 3);
+}
@@ -0,0 +1,45 @@
+#include <tests_details.h>
+#include <audio/sample_format.h>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+NOYX_TEST(sample_format_test, s16_round_trips_through_float) {
+  // every int16 value, and an odd count so the scalar tail runs too
+  std::vector<int16_t> src(65536 + 3);
+  for (size_t i = 0; i < src.size(); ++i) src[i] = static_cast<int16_t>(static_cast<uint16_t>(i * 7919));
+  std::vector<float> f(src.size());
+  std::vector<int16_t> back(src.size());
+
+  audio::s16_to_f32(src.data(), f.data(), src.size());
+  audio::f32_to_s16(f.data(), back.data(), f.size());
+
+  bool exact = true;
+  bool in_range = true;
+  for (size_t i = 0; i < src.size(); ++i) {
+    exact = exact && back[i] == src[i] && f[i] == src[i] / 32768.0f;
+    in_range = in_range && f[i] >= -1.0f && f[i] < 1.0f;
+  }
+  NOYX_ASSERT_TRUE(exact);
+  NOYX_ASSERT_TRUE(in_range);
+}
+
+NOYX_TEST(sample_format_test, f32_to_s16_rounds_and_saturates) {
+  const float src[] = { 0.0f, 1.0f, -1.0f, 2.5f, -7.0f, 0.5f / 32768.0f, 1.5f / 32768.0f, -0.25f,
+                        std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+                        3.0f / 32768.0f, 1e30f, -1e30f, 0.999f, 100.4f / 32768.0f, -100.6f / 32768.0f, 0.75f };
+  const int16_t expected[] = { 0, 32767, -32768, 32767, -32768, 0, 2, -8192,
+                               32767, -32768,
+                               3, 32767, -32768, 32735, 100, -101, 24576 };
+  constexpr size_t n = sizeof(src) / sizeof(src[0]);
+  int16_t out[n] = {};
+  audio::f32_to_s16(src, out, n); // 16 through the SIMD path, the last one through the tail
+  for (size_t i = 0; i < n; ++i) NOYX_ASSERT_EQ(out[i], expected[i]);
+
+  // the converting copy picks the direction from the pointer types
+  float f[n] = {};
+  audio::convert_samples(out, f, n);
+  NOYX_ASSERT_EQ(f[2], -1.0f);
+  NOYX_ASSERT_EQ(f[7], -0.25f);
+}
@@ -0,0 +1,62 @@
+#include <tests_details.h>
+#include <memory/arena.h>
+#include <containers/impl/ring_buffer.h>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+using voxory::memory::monotonic_arena;
+using voxory::memory::arena_allocator;
+
+NOYX_TEST(arena_test, bump_and_alignment) {
+  monotonic_arena arena(1024);
+  void* a = arena.allocate(3, 1);
+  void* b = arena.allocate(8, 64);
+  NOYX_ASSERT_TRUE(a != nullptr);
+  NOYX_ASSERT_EQ(reinterpret_cast<std::uintptr_t>(b) % 64, (std::uintptr_t)0);
+  NOYX_ASSERT_GE(arena.bytes_used(), (size_t)11);
+  NOYX_ASSERT_EQ(arena.upstream_allocations(), (size_t)1);
+}
+
+NOYX_TEST(arena_test, reset_reuses_blocks) {
+  monotonic_arena arena(1024);
+  for (int window = 0; window < 5; ++window) {
+    std::pmr::vector<float> pcm(&arena);
+    pcm.resize(16000);
+    std::pmr::string text("a segment long enough to skip the small string buffer", &arena);
+    arena.reset();
+    NOYX_ASSERT_EQ(arena.bytes_used(), (size_t)0);
+  }
+  // the first window grows the arena; later windows are served from retained blocks
+  const size_t steady = arena.upstream_allocations();
+  for (int window = 0; window < 5; ++window) {
+    std::pmr::vector<float> pcm(&arena);
+    pcm.resize(16000);
+    arena.reset();
+  }
+  NOYX_ASSERT_EQ(arena.upstream_allocations(), steady);
+}
+
+NOYX_TEST(arena_test, external_buffer) {
+  alignas(std::max_align_t) unsigned char storage[4096];
+  monotonic_arena arena(storage, sizeof(storage));
+  void* p = arena.allocate(1000);
+  NOYX_ASSERT_TRUE(p >= (void*)storage && p < (void*)(storage + sizeof(storage)));
+  NOYX_ASSERT_EQ(arena.upstream_allocations(), (size_t)0);
+  (void)arena.allocate(8000);
+  NOYX_ASSERT_EQ(arena.upstream_allocations(), (size_t)1);
+  arena.release();
+  NOYX_ASSERT_EQ(arena.capacity(), (size_t)0);
+  NOYX_ASSERT_TRUE(arena.allocate(16) != nullptr);
+  NOYX_ASSERT_EQ(arena.upstream_allocations(), (size_t)1);
+}
+
+NOYX_TEST(arena_test, ring_buffer_with_arena_allocator) {
+  monotonic_arena arena(1024);
+  using rb_t = voxory::containers::ring_buffer<int, arena_allocator<int>>;
+  rb_t rb(8, arena_allocator<int>(arena));
+  rb.set_overwrite(false);
+  for (int i = 0; i < 100; ++i) rb.push_back(i);
+  NOYX_ASSERT_EQ(rb.size(), (rb_t::size_type)100);
+  NOYX_ASSERT_EQ(rb[99], 99);
+}
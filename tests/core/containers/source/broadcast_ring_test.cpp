@@ -0,0 +1,114 @@
+#include <tests_details.h>
+#include <containers/impl/broadcast_ring.h>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using voxory::containers::broadcast_ring;
+namespace ring_policy = voxory::containers::ring_policy;
+
+NOYX_TEST(broadcast_ring_test, readers_share_one_write) {
+  broadcast_ring<int, ring_policy::overflow_reject> ring(6, 2); // rounded up to 8
+  NOYX_ASSERT_EQ(ring.capacity(), (size_t)8);
+  auto a = ring.add_reader();
+  auto b = ring.add_reader();
+  NOYX_ASSERT_TRUE(a != b);
+  NOYX_ASSERT_EQ(ring.add_reader(), ring.npos);
+
+  const int src[] = { 1, 2, 3, 4, 5, 6 };
+  NOYX_ASSERT_EQ(ring.push(src, 6), (size_t)6);
+
+  auto spans_a = ring.read_spans(a);
+  auto spans_b = ring.read_spans(b);
+  NOYX_ASSERT_EQ(spans_a.size(), (size_t)6);
+  NOYX_ASSERT_TRUE(spans_a.first.data() == spans_b.first.data()); // zero-copy: same storage
+  NOYX_ASSERT_TRUE(ring.commit_read(a, 6));
+
+  // b still holds 6 slots, so only 2 of the next 4 fit
+  NOYX_ASSERT_EQ(ring.push(src, 4), (size_t)2);
+  NOYX_ASSERT_EQ(ring.dropped(), (uint64_t)2);
+
+  // the run wraps for a
+  auto wrapped = ring.read_spans(a);
+  NOYX_ASSERT_EQ(wrapped.first.size(), (size_t)2);
+  NOYX_ASSERT_TRUE(wrapped.second.empty());
+  int out[8] = {};
+  NOYX_ASSERT_EQ(ring.pop(b, out, 8), (size_t)8);
+  NOYX_ASSERT_EQ(out[5], 6);
+  NOYX_ASSERT_EQ(out[7], 2);
+
+  // a departed reader no longer holds the producer back
+  ring.remove_reader(a);
+  NOYX_ASSERT_EQ(ring.readers(), (size_t)1);
+  NOYX_ASSERT_EQ(ring.push(src, 6), (size_t)6);
+  auto split = ring.read_spans(b);
+  NOYX_ASSERT_EQ(split.first.size(), (size_t)6);
+  NOYX_ASSERT_TRUE(split.second.empty());
+}
+
+NOYX_TEST(broadcast_ring_test, overwrite_reports_lapped_readers) {
+  broadcast_ring<int> ring(4, 1);
+  auto r = ring.add_reader();
+  int src[10];
+  for (int i = 0; i < 10; ++i) src[i] = i;
+  NOYX_ASSERT_EQ(ring.push(src, 10), (size_t)10);
+
+  // the reader skips to the oldest slot the producer has not claimed
+  auto spans = ring.read_spans(r);
+  NOYX_ASSERT_EQ(ring.lapped(r), (uint64_t)6);
+  NOYX_ASSERT_EQ(spans.size(), (size_t)4);
+  NOYX_ASSERT_EQ(spans.first[0], 6);
+
+  // the producer claims slots under a reader in the middle of reading them
+  auto in_flight = ring.read_spans(r, 2);
+  (void)ring.write_spans(3);
+  NOYX_ASSERT_FALSE(ring.commit_read(r, in_flight.size()));
+  NOYX_ASSERT_EQ(ring.lapped(r), (uint64_t)9);
+
+  ring.commit_write(3);
+  int out[4] = {};
+  NOYX_ASSERT_EQ(ring.pop(r, out, 4), (size_t)4);
+  NOYX_ASSERT_EQ(out[0], 9);
+}
+
+NOYX_TEST(broadcast_ring_test, blocking_producer_feeds_every_reader) {
+  constexpr int total = 20000;
+  constexpr int reader_count = 3;
+  broadcast_ring<int, ring_policy::overflow_block> ring(64, reader_count);
+  std::vector<broadcast_ring<int, ring_policy::overflow_block>::reader_id> ids;
+  for (int i = 0; i < reader_count; ++i) ids.push_back(ring.add_reader());
+
+  std::vector<int64_t> sums(reader_count, 0);
+  std::vector<int> ordered(reader_count, 1);
+  std::vector<std::thread> readers;
+  for (int i = 0; i < reader_count; ++i) {
+    readers.emplace_back([&, i] {
+      int expected = 0;
+      while (expected < total) {
+        ring.wait_for_data(ids[i], 1);
+        auto spans = ring.read_spans(ids[i], 17);
+        spans.for_each([&](std::span<const int> s) {
+          for (int v : s) {
+            if (v != expected) ordered[i] = 0;
+            sums[i] += v;
+            ++expected;
+          }
+        });
+        ring.commit_read(ids[i], spans.size());
+      }
+    });
+  }
+
+  for (int base = 0; base < total; base += 50) {
+    int chunk[50];
+    for (int k = 0; k < 50; ++k) chunk[k] = base + k;
+    NOYX_ASSERT_EQ(ring.push(chunk, 50), (size_t)50);
+  }
+  for (auto& t : readers) t.join();
+
+  const int64_t expected_sum = int64_t(total) * (total - 1) / 2;
+  for (int i = 0; i < reader_count; ++i) {
+    NOYX_ASSERT_EQ(sums[i], expected_sum);
+    NOYX_ASSERT_EQ(ordered[i], 1);
+  }
+}
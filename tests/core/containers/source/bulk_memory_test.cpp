@@ -0,0 +1,84 @@
+#include <tests_details.h>
+#include <containers/detail/bulk_memory.h>
+#include <containers/impl/heap_array.h>
+#include <platform/cpu_features.h>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace internal = voxory::containers::internal;
+
+namespace {
+  // sizes around the SIMD and streaming thresholds, in elements of 4 bytes
+  constexpr size_t sizes[] = { 0, 1, 7, 63, 64, 65, 1000, (1 << 18) - 3, (1 << 18) + 37 };
+}
+
+NOYX_TEST(bulk_memory_test, fill_and_zero_match_scalar_loops) {
+  const auto& cpu = voxory::platform::cpu_features::get();
+#if defined(X64)
+  NOYX_ASSERT_TRUE(cpu.sse2);
+#endif
+  (void)cpu;
+
+  std::vector<float> buf((1 << 18) + 64);
+  for (size_t offset = 0; offset < 3; ++offset) {
+    for (size_t n : sizes) {
+      float* p = buf.data() + offset;
+      std::fill(buf.begin(), buf.end(), -1.0f);
+      internal::bulk_fill(p, n, 0.25f);
+      bool ok = true;
+      for (size_t i = 0; i < n; ++i) ok &= p[i] == 0.25f;
+      ok &= buf[offset + n] == -1.0f; // nothing written past the end
+      if (offset) ok &= buf[offset - 1] == -1.0f;
+      NOYX_ASSERT_TRUE(ok);
+
+      internal::bulk_zero(p, n * sizeof(float));
+      ok = true;
+      for (size_t i = 0; i < n; ++i) ok &= p[i] == 0.0f;
+      ok &= buf[offset + n] == -1.0f;
+      NOYX_ASSERT_TRUE(ok);
+    }
+  }
+
+  std::vector<double> d(100000, 1.0);
+  internal::bulk_fill(d.data() + 1, d.size() - 2, 3.5);
+  NOYX_ASSERT_EQ(d[0], 1.0);
+  NOYX_ASSERT_EQ(d[1], 3.5);
+  NOYX_ASSERT_EQ(d[d.size() - 2], 3.5);
+  NOYX_ASSERT_EQ(d.back(), 1.0);
+}
+
+NOYX_TEST(bulk_memory_test, copy_and_move) {
+  const size_t n = (1 << 20) + 123; // bytes, above the streaming threshold
+  std::vector<unsigned char> src(n + 64), dst(n + 64, 0);
+  for (size_t i = 0; i < src.size(); ++i) src[i] = static_cast<unsigned char>(i * 31 + 7);
+
+  for (size_t so : { 0, 3 }) {
+    for (size_t d_off : { 0, 5, 32 }) {
+      std::fill(dst.begin(), dst.end(), 0);
+      internal::bulk_copy(dst.data() + d_off, src.data() + so, n);
+      NOYX_ASSERT_TRUE(std::memcmp(dst.data() + d_off, src.data() + so, n) == 0);
+      NOYX_ASSERT_EQ(dst[d_off + n], (unsigned char)0);
+    }
+  }
+
+  // overlapping ranges fall back to memmove
+  std::vector<unsigned char> expected(src.begin(), src.begin() + n);
+  internal::bulk_move(src.data() + 17, src.data(), n);
+  NOYX_ASSERT_TRUE(std::memcmp(src.data() + 17, expected.data(), n) == 0);
+}
+
+NOYX_TEST(bulk_memory_test, containers_take_the_bulk_paths) {
+  using voxory::containers::heap_array;
+  heap_array<float> window(480000, 0.0f); // 30 s at 16 kHz
+  heap_array<float> ones(480000, 1.0f);
+  bool ok = true;
+  for (size_t i = 0; i < window.size(); ++i) ok &= window[i] == 0.0f && ones[i] == 1.0f;
+  NOYX_ASSERT_TRUE(ok);
+
+  heap_array<float> copy(ones);
+  NOYX_ASSERT_EQ(copy[479999], 1.0f);
+  copy.resize(500000);
+  NOYX_ASSERT_EQ(copy[499999], 0.0f);
+  NOYX_ASSERT_EQ(copy[479999], 1.0f);
+}
@@ -0,0 +1,90 @@
+#include <tests_details.h>
+#include <containers/impl/chunk_buffer.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using voxory::ChunkRing;
+
+NOYX_TEST(chunk_ring_test, in_place_write_and_read) {
+  ChunkRing ring(4, 8);
+  float* slot = ring.acquire_write();
+  for (int i = 0; i < 8; ++i) slot[i] = (float)i;
+  ring.publish();
+
+  auto view = ring.begin_read();
+  NOYX_ASSERT_TRUE((bool)view);
+  NOYX_ASSERT_EQ(view.count, (size_t)8);
+  NOYX_ASSERT_EQ(view.data[7], 7.f);
+  NOYX_ASSERT_TRUE(ring.end_read(view));
+  NOYX_ASSERT_FALSE((bool)ring.begin_read());
+  NOYX_ASSERT_EQ(ring.dropped(), (uint64_t)0);
+}
+
+NOYX_TEST(chunk_ring_test, overwrite_counts_drops) {
+  ChunkRing ring(4, 2);
+  for (int i = 0; i < 10; ++i) {
+    float chunk[2] = { (float)i, (float)i };
+    ring.push_chunk(chunk);
+  }
+
+  // one slot stays reserved for the producer, so the newest slots - 1 chunks survive
+  float out[2];
+  NOYX_ASSERT_TRUE(ring.pop_chunk(out));
+  NOYX_ASSERT_EQ(out[0], 7.f);
+  NOYX_ASSERT_EQ(ring.dropped(), (uint64_t)7);
+  NOYX_ASSERT_TRUE(ring.pop_chunk(out));
+  NOYX_ASSERT_TRUE(ring.pop_chunk(out));
+  NOYX_ASSERT_EQ(out[1], 9.f);
+  NOYX_ASSERT_FALSE(ring.pop_chunk(out));
+}
+
+NOYX_TEST(chunk_ring_test, overwritten_while_reading) {
+  ChunkRing ring(2, 1);
+  float v = 1.f;
+  ring.push_chunk(&v);
+  auto view = ring.begin_read();
+  NOYX_ASSERT_TRUE((bool)view);
+
+  // the producer laps the reader on the same slot
+  ring.push_chunk(&v);
+  ring.push_chunk(&v);
+  NOYX_ASSERT_FALSE(ring.end_read(view));
+  NOYX_ASSERT_EQ(ring.dropped(), (uint64_t)1);
+}
+
+NOYX_TEST(chunk_ring_test, concurrent_chunks_are_never_torn) {
+  constexpr size_t chunk = 64;
+  constexpr int total = 20000;
+  ChunkRing ring(8, chunk);
+  std::atomic<bool> done{ false };
+
+  std::thread producer([&] {
+    for (int i = 1; i <= total; ++i) {
+      float* slot = ring.acquire_write();
+      for (size_t j = 0; j < chunk; ++j) slot[j] = (float)i;
+      ring.publish();
+    }
+    done.store(true, std::memory_order_release);
+  });
+
+  std::vector<float> out(chunk);
+  uint64_t received = 0;
+  bool torn = false;
+  float last = 0.f;
+  for (;;) {
+    bool finished = done.load(std::memory_order_acquire);
+    if (!ring.pop_chunk(out.data())) {
+      if (finished) break;
+      continue;
+    }
+    ++received;
+    for (size_t j = 1; j < chunk; ++j) torn |= out[j] != out[0];
+    torn |= out[0] <= last;
+    last = out[0];
+  }
+  producer.join();
+
+  NOYX_ASSERT_FALSE(torn);
+  NOYX_ASSERT_LE(received + ring.dropped(), (uint64_t)total);
+}
@@ -584,4 +584,122 @@ NOYX_TEST(heap_array_test, one_alive_obj) {
   };
   using heap_t = heap_array<Resource>;
   heap_t a(1);
-}
\ No newline at end of file
+}
+// checked iterators: writes through the array keep iterators valid, a copy has its own
+NOYX_TEST(heap_array_test, iterators_stay_valid_without_reallocation) {
+  using heap_t = heap_array<int>;
+  heap_t a(8, 0);
+  auto it = a.begin();
+  auto last = a.end();
+  for (int i = 0; i < 8; ++i) a[(heap_t::size_type)i] = i * 2;
+  NOYX_ASSERT_EQ(*(it + 3), 6);
+  NOYX_ASSERT_EQ((int)(last - it), 8);
+
+  heap_t b = a;
+  auto bit = b.begin();
+  *bit = 42;
+  NOYX_ASSERT_EQ(*it, 0);
+  NOYX_ASSERT_EQ(*bit, 42);
+  NOYX_ASSERT_TRUE(std::equal(it + 1, last, bit + 1));
+}
+
+NOYX_TEST(heap_array_test, aligned_resize_for_overwrite) {
+  using voxory::containers::aligned_heap_array;
+  aligned_heap_array<float> a(100, voxory::containers::default_init);
+  NOYX_ASSERT_EQ(a.size(), (size_t)100);
+  NOYX_ASSERT_EQ(reinterpret_cast<std::uintptr_t>(a.data()) % 64, (std::uintptr_t)0);
+  for (size_t i = 0; i < a.size(); ++i) a[i] = (float)i;
+
+  // growing keeps the old elements; the new ones are left for the caller to fill
+  a.resize_for_overwrite(480000);
+  NOYX_ASSERT_EQ(a.size(), (size_t)480000);
+  NOYX_ASSERT_EQ(reinterpret_cast<std::uintptr_t>(a.data()) % 64, (std::uintptr_t)0);
+  NOYX_ASSERT_EQ(a[99], 99.f);
+
+  a.resize_for_overwrite(10);
+  NOYX_ASSERT_EQ(a.size(), (size_t)10);
+  NOYX_ASSERT_EQ(a.capacity(), (size_t)480000);
+  a.resize_for_overwrite(200); // within capacity: no reallocation
+  NOYX_ASSERT_EQ(a.capacity(), (size_t)480000);
+  NOYX_ASSERT_EQ(a[9], 9.f);
+
+  // non-trivial types are still constructed
+  heap_array<std::string> s(3, voxory::containers::default_init);
+  s.resize_for_overwrite(5);
+  NOYX_ASSERT_TRUE(s[4].empty());
+}
+
+namespace {
+  struct relocatable_counter {
+    static inline int moves = 0;
+    static inline int destroyed = 0;
+    std::unique_ptr<int> value;
+
+    relocatable_counter() : value(std::make_unique<int>(0)) {}
+    relocatable_counter(relocatable_counter&& o) noexcept : value(std::move(o.value)) { ++moves; }
+    ~relocatable_counter() { ++destroyed; }
+  };
+}
+
+template<>
+struct type_traits::is_trivially_relocatable<relocatable_counter> : std::true_type {};
+
+NOYX_TEST(heap_array_test, growth_relocates_with_memcpy) {
+  heap_array<relocatable_counter> a(4);
+  for (size_t i = 0; i < a.size(); ++i) *a[i].value = static_cast<int>(i) + 1;
+
+  relocatable_counter::moves = 0;
+  relocatable_counter::destroyed = 0;
+  a.reserve(16);
+  a.resize(8);
+  NOYX_ASSERT_EQ(relocatable_counter::moves, 0);
+  NOYX_ASSERT_EQ(relocatable_counter::destroyed, 0);
+  for (size_t i = 0; i < 4; ++i) NOYX_ASSERT_EQ(*a[i].value, static_cast<int>(i) + 1);
+  NOYX_ASSERT_EQ(*a[7].value, 0);
+
+  // std types: unique_ptr is relocatable everywhere
+  static_assert(type_traits::is_trivially_relocatable_v<std::unique_ptr<int>>);
+  heap_array<std::unique_ptr<int>> p(2);
+  p[1] = std::make_unique<int>(42);
+  p.resize(20);
+  NOYX_ASSERT_EQ(*p[1], 42);
+}
+
+NOYX_TEST(heap_array_test, mapped_growth_keeps_contents) {
+  using voxory::containers::mapped_heap_array;
+  mapped_heap_array<float> a(1000); // below the mapping threshold: heap block
+  a[999] = 1.0f;
+  a.resize(1 << 20);                // 4 MiB: first mapping (copy)
+  NOYX_ASSERT_EQ(a[999], 1.0f);
+  NOYX_ASSERT_EQ(reinterpret_cast<std::uintptr_t>(a.data()) % 64, (std::uintptr_t)0);
+
+  for (size_t i = 0; i < a.size(); i += 4096) a[i] = static_cast<float>(i);
+  a.resize_for_overwrite(16 << 20); // 64 MiB: remapped in place
+  a.resize(24 << 20);
+  NOYX_ASSERT_EQ(a.size(), (size_t)(24 << 20));
+  for (size_t i = 0; i < (size_t)(1 << 20); i += 4096) NOYX_ASSERT_EQ(a[i], static_cast<float>(i));
+  NOYX_ASSERT_EQ(a[(24 << 20) - 1], 0.0f);
+
+  a.resize(10);
+  a.shrink_to_fit();
+  NOYX_ASSERT_EQ(a.capacity(), (size_t)10);
+  NOYX_ASSERT_EQ(a[0], 0.0f);
+}
+
+#ifdef DEBUG_ITERATORS
+NOYX_TEST(heap_array_test, reused_storage_does_not_revive_iterators) {
+  // a loop-scoped container is rebuilt at the same address: the new one must not start at the
+  // generation the old one's iterators carry
+  using array_t = voxory::containers::heap_array<int>;
+  alignas(array_t) unsigned char storage[sizeof(array_t)];
+  array_t* a = ::new (static_cast<void*>(storage)) array_t(4);
+  array_t::iterator stale = a->begin();
+  NOYX_ASSERT_TRUE(stale._is_valid());
+  a->~array_t();
+
+  a = ::new (static_cast<void*>(storage)) array_t(4);
+  NOYX_ASSERT_FALSE(stale._is_valid());
+  NOYX_ASSERT_TRUE(a->begin()._is_valid());
+  a->~array_t();
+}
+#endif // DEBUG_ITERATORS
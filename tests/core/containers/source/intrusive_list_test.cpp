@@ -0,0 +1,81 @@
+#include <tests_details.h>
+#include <containers/impl/intrusive_list.h>
+#include <utility>
+#include <vector>
+
+using voxory::containers::intrusive_list;
+using voxory::containers::intrusive_list_hook;
+
+namespace {
+  struct lru_tag {};
+  struct stream : intrusive_list_hook<>, intrusive_list_hook<lru_tag> {
+    explicit stream(int i) : id(i) {}
+    int id;
+  };
+}
+
+NOYX_TEST(intrusive_list_test, push_and_unlink) {
+  std::vector<stream> streams;
+  for (int i = 0; i < 5; ++i) streams.emplace_back(i);
+
+  intrusive_list<stream> all;
+  for (auto& s : streams) all.push_back(s);
+  NOYX_ASSERT_EQ(all.size(), (size_t)5);
+  NOYX_ASSERT_EQ(all.front().id, 0);
+  NOYX_ASSERT_EQ(all.back().id, 4);
+
+  // O(1) unlink through the hook, without the list
+  streams[2].intrusive_list_hook<>::unlink();
+  NOYX_ASSERT_EQ(all.size(), (size_t)4);
+
+  auto it = all.erase(all.iterator_to(streams[1]));
+  NOYX_ASSERT_EQ(it->id, 3);
+
+  NOYX_ASSERT_EQ(all.remove_if([](const stream& s) { return s.id == 3; }), (size_t)1);
+  int sum = 0;
+  for (const auto& s : std::as_const(all)) sum += s.id;
+  NOYX_ASSERT_EQ(sum, 4);
+
+  all.clear();
+  for (auto& s : streams) NOYX_ASSERT_FALSE(s.intrusive_list_hook<>::is_linked());
+}
+
+NOYX_TEST(intrusive_list_test, two_hooks_and_lru) {
+  std::vector<stream> streams;
+  for (int i = 0; i < 3; ++i) streams.emplace_back(i);
+
+  intrusive_list<stream> all;
+  intrusive_list<stream, lru_tag> lru;
+  for (auto& s : streams) {
+    all.push_back(s);
+    lru.push_front(s);
+  }
+  NOYX_ASSERT_EQ(lru.front().id, 2);
+  lru.move_to_front(streams[0]);
+  NOYX_ASSERT_EQ(lru.front().id, 0);
+  NOYX_ASSERT_EQ(lru.back().id, 1);
+  // the other list is untouched
+  NOYX_ASSERT_EQ(all.front().id, 0);
+  NOYX_ASSERT_EQ(all.back().id, 2);
+
+  lru.clear();
+  all.clear();
+}
+
+NOYX_TEST(intrusive_list_test, move_and_swap) {
+  stream a(1), b(2);
+  intrusive_list<stream> first;
+  first.push_back(a);
+  first.push_back(b);
+
+  intrusive_list<stream> second(std::move(first));
+  NOYX_ASSERT_TRUE(first.empty());
+  NOYX_ASSERT_EQ(second.size(), (size_t)2);
+
+  first.swap(second);
+  NOYX_ASSERT_TRUE(second.empty());
+  NOYX_ASSERT_EQ(first.back().id, 2);
+  first.pop_front();
+  NOYX_ASSERT_EQ(first.front().id, 2);
+  first.clear();
+}
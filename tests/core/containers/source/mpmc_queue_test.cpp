@@ -0,0 +1,208 @@
+#include <tests_details.h>
+#include <containers/impl/mpmc_queue.h>
+#include <memory/aligned_allocator.h>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using voxory::containers::mpmc_queue;
+
+NOYX_TEST(mpmc_queue_test, bounded_fifo_and_bulk) {
+  mpmc_queue<int, voxory::memory::aligned_allocator<int>> q(5); // rounded up to 8
+  NOYX_ASSERT_EQ(q.capacity(), (size_t)8);
+
+  for (int i = 0; i < 8; ++i) NOYX_ASSERT_TRUE(q.try_push(i));
+  NOYX_ASSERT_FALSE(q.try_push(8));
+  NOYX_ASSERT_EQ(q.size_approx(), (size_t)8);
+
+  int out[8] = {};
+  NOYX_ASSERT_EQ(q.try_pop_bulk(out, 3), (size_t)3);
+  NOYX_ASSERT_EQ(out[2], 2);
+
+  // a batch larger than the free space enqueues the prefix that fits (and wraps)
+  const int batch[5] = { 10, 11, 12, 13, 14 };
+  NOYX_ASSERT_EQ(q.try_push_bulk(batch, 5), (size_t)3);
+
+  NOYX_ASSERT_EQ(q.try_pop_bulk(out, 8), (size_t)8);
+  NOYX_ASSERT_EQ(out[0], 3);
+  NOYX_ASSERT_EQ(out[4], 7);
+  NOYX_ASSERT_EQ(out[7], 12);
+  NOYX_ASSERT_FALSE(q.try_pop().has_value());
+}
+
+NOYX_TEST(mpmc_queue_test, non_trivial_elements_and_close) {
+  auto q = std::make_unique<mpmc_queue<std::string>>(4);
+  NOYX_ASSERT_TRUE(q->try_emplace(40, 'x'));
+  NOYX_ASSERT_TRUE(q->push(std::string("job")));
+  NOYX_ASSERT_EQ(q->pop().value(), std::string(40, 'x'));
+
+  q->close();
+  NOYX_ASSERT_FALSE(q->push(std::string("late")));
+  NOYX_ASSERT_EQ(q->pop().value(), std::string("job")); // closed queues still drain
+  NOYX_ASSERT_FALSE(q->pop().has_value());
+
+  q->try_emplace(std::string(64, 'y')); // left queued: the destructor must free it
+  q.reset();
+}
+
+namespace {
+  // copies throw once the shared countdown reaches zero; moves never throw
+  struct throwing_copy {
+    static inline int copies_left = 0;
+    std::unique_ptr<int> value;
+
+    explicit throwing_copy(int v) : value(std::make_unique<int>(v)) {}
+    throwing_copy(const throwing_copy& o) : value(std::make_unique<int>(*o.value)) {
+      if (copies_left-- == 0) throw std::runtime_error("copy");
+    }
+    throwing_copy(throwing_copy&&) noexcept = default;
+    throwing_copy& operator=(throwing_copy&&) noexcept = default;
+  };
+}
+
+NOYX_TEST(mpmc_queue_test, throwing_bulk_copy_leaves_the_queue_usable) {
+  mpmc_queue<throwing_copy> q(8);
+  std::vector<throwing_copy> src;
+  for (int i = 0; i < 5; ++i) src.emplace_back(i);
+
+  throwing_copy::copies_left = 2; // the 3rd copy throws
+  bool threw = false;
+  try {
+    (void)q.try_push_bulk(src.begin(), src.size());
+  }
+  catch (const std::runtime_error&) {
+    threw = true;
+  }
+  NOYX_ASSERT_TRUE(threw);
+  NOYX_ASSERT_EQ(q.size_approx(), (size_t)0); // nothing was claimed
+
+  throwing_copy::copies_left = 100;
+  NOYX_ASSERT_EQ(q.try_push_bulk(src.begin(), src.size()), (size_t)5);
+  NOYX_ASSERT_TRUE(q.try_push(throwing_copy(5)));
+  for (int i = 0; i < 6; ++i) {
+    std::optional<throwing_copy> v = q.try_pop();
+    NOYX_ASSERT_TRUE(v.has_value());
+    NOYX_ASSERT_EQ(*v->value, i);
+  }
+  NOYX_ASSERT_FALSE(q.try_pop().has_value());
+}
+
+NOYX_TEST(mpmc_queue_test, blocking_workers_receive_every_job) {
+  constexpr int producers = 3;
+  constexpr int consumers = 3;
+  constexpr int per_producer = 20000;
+  mpmc_queue<uint32_t> q(64);
+
+  std::atomic<uint64_t> sum{ 0 };
+  std::atomic<int> received{ 0 };
+  std::vector<std::thread> threads;
+  for (int c = 0; c < consumers; ++c) {
+    threads.emplace_back([&] {
+      uint32_t buf[16];
+      while (size_t n = q.pop_bulk(buf, 16)) {
+        for (size_t i = 0; i < n; ++i) sum.fetch_add(buf[i], std::memory_order_relaxed);
+        received.fetch_add(static_cast<int>(n), std::memory_order_relaxed);
+      }
+    });
+  }
+  std::atomic<size_t> pushed{ 0 };
+  std::vector<std::thread> senders;
+  for (int p = 0; p < producers; ++p) {
+    senders.emplace_back([&, p] {
+      std::vector<uint32_t> jobs(per_producer);
+      for (int i = 0; i < per_producer; ++i) jobs[i] = static_cast<uint32_t>(p * per_producer + i);
+      // mix single and batched pushes
+      pushed += q.push(jobs[0]) ? 1 : 0;
+      pushed += q.push_bulk(jobs.begin() + 1, per_producer - 1);
+    });
+  }
+  for (auto& t : senders) t.join();
+  q.close();
+  for (auto& t : threads) t.join();
+
+  const uint64_t n = uint64_t(producers) * per_producer;
+  NOYX_ASSERT_EQ(pushed.load(), (size_t)n);
+  NOYX_ASSERT_EQ(received.load(), (int)n);
+  NOYX_ASSERT_EQ(sum.load(), n * (n - 1) / 2);
+}
+
+// contention benchmark: the same job stream through mpmc_queue and through a mutex + std::deque
+NOYX_TEST(mpmc_queue_test, contention_vs_mutex_deque) {
+  using clk = std::chrono::steady_clock;
+  using rep = std::chrono::duration<double, std::milli>;
+  constexpr int threads_per_side = 4;
+  constexpr int per_producer = 50000;
+  constexpr uint64_t total = uint64_t(threads_per_side) * per_producer;
+
+  auto run = [&](auto&& push, auto&& pop, const char* name) {
+    std::atomic<uint64_t> consumed{ 0 };
+    std::atomic<uint64_t> sum{ 0 };
+    std::vector<std::thread> threads;
+    auto s = clk::now();
+    for (int t = 0; t < threads_per_side; ++t) {
+      threads.emplace_back([&] {
+        for (int i = 0; i < per_producer; ++i) push(static_cast<uint32_t>(i));
+      });
+      threads.emplace_back([&] {
+        uint64_t local = 0;
+        while (consumed.load(std::memory_order_relaxed) < total) {
+          uint32_t v;
+          if (pop(v)) {
+            local += v;
+            consumed.fetch_add(1, std::memory_order_relaxed);
+          }
+          else {
+            std::this_thread::yield();
+          }
+        }
+        sum.fetch_add(local);
+      });
+    }
+    for (auto& t : threads) t.join();
+    rep d = clk::now() - s;
+    std::cout.setf(std::ios::fixed); std::cout << std::setprecision(3);
+    std::cout << "[TIMING] " << name << " : " << d.count() << " ms\n";
+    std::cout.unsetf(std::ios::fixed);
+    return sum.load();
+  };
+
+  const uint64_t expected = uint64_t(threads_per_side) * (uint64_t(per_producer) * (per_producer - 1) / 2);
+
+  mpmc_queue<uint32_t> q(1024);
+  uint64_t lock_free = run(
+    [&](uint32_t v) { while (!q.try_push(v)) std::this_thread::yield(); },
+    [&](uint32_t& v) { return q.try_pop(v); },
+    "mpmc_queue 4P/4C");
+  NOYX_ASSERT_EQ(lock_free, expected);
+
+  std::mutex m;
+  std::deque<uint32_t> d;
+  uint64_t locked = run(
+    [&](uint32_t v) {
+      for (;;) {
+        {
+          std::lock_guard<std::mutex> lk(m);
+          if (d.size() < 1024) { d.push_back(v); return; }
+        }
+        std::this_thread::yield();
+      }
+    },
+    [&](uint32_t& v) {
+      std::lock_guard<std::mutex> lk(m);
+      if (d.empty()) return false;
+      v = d.front();
+      d.pop_front();
+      return true;
+    },
+    "mutex + std::deque 4P/4C");
+  NOYX_ASSERT_EQ(locked, expected);
+}
@@ -0,0 +1,96 @@
+#include <tests_details.h>
+#include <memory/object_pool.h>
+#include <containers/impl/mpmc_queue.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using voxory::memory::object_pool;
+
+namespace {
+  struct segment_result {
+    std::string text;
+    int64_t t0 = 0;
+    int64_t t1 = 0;
+    std::vector<int> tokens;
+  };
+}
+
+NOYX_TEST(object_pool_test, objects_are_recycled_with_their_capacity) {
+  object_pool<segment_result> pool(32);
+  NOYX_ASSERT_EQ(pool.capacity(), (size_t)32);
+  NOYX_ASSERT_EQ(pool.blocks(), (size_t)1);
+
+  const segment_result* first = nullptr;
+  {
+    auto h = pool.acquire();
+    first = h.get();
+    h->text.assign(200, 'a');
+    h->tokens.resize(64);
+  }
+  // the same thread gets its most recently released object back, storage included
+  auto h = pool.acquire();
+  NOYX_ASSERT_TRUE(h.get() == first);
+  NOYX_ASSERT_GE(h->text.capacity(), (size_t)200);
+  NOYX_ASSERT_GE(h->tokens.capacity(), (size_t)64);
+
+  auto moved = std::move(h);
+  NOYX_ASSERT_FALSE(static_cast<bool>(h));
+  NOYX_ASSERT_TRUE(moved.get() == first);
+  moved.reset();
+  NOYX_ASSERT_FALSE(static_cast<bool>(moved));
+}
+
+NOYX_TEST(object_pool_test, grows_by_blocks_then_stays_put) {
+  object_pool<int> pool(32);
+  std::vector<object_pool<int>::handle> held;
+  for (int i = 0; i < 100; ++i) held.push_back(pool.acquire());
+  NOYX_ASSERT_EQ(pool.capacity(), (size_t)224); // 32 + 64 + 128
+  NOYX_ASSERT_EQ(pool.blocks(), (size_t)3);
+
+  // distinct objects
+  for (int i = 0; i < 100; ++i) *held[i] = i;
+  for (int i = 0; i < 100; ++i) NOYX_ASSERT_EQ(*held[i], i);
+
+  held.clear();
+  for (int round = 0; round < 10; ++round) {
+    for (int i = 0; i < 100; ++i) held.push_back(pool.acquire());
+    held.clear();
+  }
+  NOYX_ASSERT_EQ(pool.blocks(), (size_t)3);
+}
+
+NOYX_TEST(object_pool_test, release_on_another_thread) {
+  object_pool<segment_result> pool(64);
+  voxory::containers::mpmc_queue<object_pool<segment_result>::handle> results(64);
+  constexpr int count = 20000;
+
+  // the inference thread fills results; the output thread consumes and releases them
+  std::thread output([&] {
+    while (auto r = results.pop()) {
+      r->reset();
+    }
+  });
+  std::vector<std::thread> producers;
+  std::atomic<int> bad{ 0 };
+  for (int p = 0; p < 2; ++p) {
+    producers.emplace_back([&, p] {
+      for (int i = 0; i < count; ++i) {
+        auto h = pool.acquire();
+        h->t0 = p;
+        h->t1 = i;
+        h->text = "segment";
+        if (!results.push(std::move(h))) bad.fetch_add(1);
+      }
+    });
+  }
+  for (auto& t : producers) t.join();
+  results.close();
+  output.join();
+
+  NOYX_ASSERT_EQ(bad.load(), 0);
+  // objects migrate between thread caches through the global list instead of piling up
+  NOYX_ASSERT_TRUE(pool.capacity() <= (size_t)64 + 128 + 256 + 512);
+}
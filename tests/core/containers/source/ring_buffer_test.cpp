@@ -1,11 +1,15 @@
 #include <tests_details.h>
 #include <containers/impl/ring_buffer.h>
+#include <platform/locked_memory.h>
 #include <iostream>
 #include <memory>
 #include <vector>
 #include <string>
 #include <type_traits>
 #include <iomanip>
+#include <algorithm>
+#include <span>
+#include <thread>
 
 template<typename T>
 class simple_allocator {
@@ -269,4 +273,271 @@ NOYX_TEST(shitttt, sadsadad) {
 //  time_and_run(ring_buffer_test_stress_alloc_dealloc, "stress_alloc_dealloc");
 //
 //  return;
-//}
\ No newline at end of file
+//}
+
+using voxory::containers::ring_buffer;
+
+NOYX_TEST(ring_buffer_test, bulk_append_wraps) {
+  ring_buffer<float> rb(8);
+  const float src[5] = { 1.f, 2.f, 3.f, 4.f, 5.f };
+
+  rb.append(src);
+  NOYX_ASSERT_EQ(rb.discard_front(3), (ring_buffer<float>::size_type)3);
+  rb.append(src); // 4 5 | 1 2 3 4 5, second block crosses the wrap point
+  NOYX_ASSERT_EQ(rb.size(), (ring_buffer<float>::size_type)7);
+
+  auto [first, second] = rb.read_spans_for_pop_front();
+  NOYX_ASSERT_EQ(first.size() + second.size(), (size_t)7);
+
+  float out[7] = {};
+  NOYX_ASSERT_EQ(rb.pop_front_into(out), (ring_buffer<float>::size_type)7);
+  const float expected[7] = { 4.f, 5.f, 1.f, 2.f, 3.f, 4.f, 5.f };
+  for (size_t i = 0; i < 7; ++i) NOYX_ASSERT_EQ(out[i], expected[i]);
+  NOYX_ASSERT_TRUE(rb.empty());
+}
+
+NOYX_TEST(ring_buffer_test, bulk_append_overwrite_and_grow) {
+  ring_buffer<int> rb(4);
+  std::vector<int> src(10);
+  for (int i = 0; i < 10; ++i) src[i] = i;
+
+  // overwrite: only the newest capacity() elements survive
+  rb.push_back_range(src.begin(), src.end());
+  NOYX_ASSERT_EQ(rb.size(), (ring_buffer<int>::size_type)4);
+  NOYX_ASSERT_EQ(rb[0], 6);
+  NOYX_ASSERT_EQ(rb[3], 9);
+
+  // grow: nothing is lost
+  rb.set_overwrite(false);
+  rb.push_back_range(src.begin(), src.end());
+  NOYX_ASSERT_EQ(rb.size(), (ring_buffer<int>::size_type)14);
+  NOYX_ASSERT_EQ(rb[0], 6);
+  NOYX_ASSERT_EQ(rb[4], 0);
+  NOYX_ASSERT_EQ(rb[13], 9);
+}
+
+NOYX_TEST(ring_buffer_test, bulk_non_trivial) {
+  ring_buffer<std::string> rb(3);
+  std::vector<std::string> src = { "a", "b", "c", "d", "e" };
+
+  rb.push_back_range(src.begin(), src.end());
+  NOYX_ASSERT_EQ(rb.size(), (ring_buffer<std::string>::size_type)3);
+  NOYX_ASSERT_EQ(rb[0], std::string("c"));
+
+  std::string out[2];
+  NOYX_ASSERT_EQ(rb.pop_front_into(out), (ring_buffer<std::string>::size_type)2);
+  NOYX_ASSERT_EQ(out[0], std::string("c"));
+  NOYX_ASSERT_EQ(out[1], std::string("d"));
+  NOYX_ASSERT_EQ(rb.size(), (ring_buffer<std::string>::size_type)1);
+  NOYX_ASSERT_EQ(rb[0], std::string("e"));
+}
+
+NOYX_TEST(ring_buffer_test, pow2_capacity_policy) {
+  using rb_t = ring_buffer<int, std::allocator<int>, voxory::containers::ring_policy::pow2_capacity>;
+  rb_t rb(5);
+  NOYX_ASSERT_EQ(rb.capacity(), (rb_t::size_type)8);
+
+  for (int i = 0; i < 20; ++i) rb.push_back(i);
+  NOYX_ASSERT_EQ(rb.size(), (rb_t::size_type)8);
+  NOYX_ASSERT_EQ(rb[0], 12);
+  NOYX_ASSERT_EQ(rb[7], 19);
+
+  rb.set_overwrite(false);
+  rb.push_back(20);
+  NOYX_ASSERT_EQ(rb.capacity(), (rb_t::size_type)16);
+  NOYX_ASSERT_EQ(rb[8], 20);
+}
+
+NOYX_TEST(ring_buffer_test, fixed_capacity_policy) {
+  using rb_t = ring_buffer<std::string, std::allocator<std::string>, voxory::containers::ring_policy::fixed_capacity<3>>;
+  rb_t rb;
+  NOYX_ASSERT_EQ(rb.capacity(), (rb_t::size_type)3);
+  NOYX_ASSERT_TRUE(rb.overwrite_allowed());
+
+  for (int i = 0; i < 5; ++i) rb.push_back(std::to_string(i));
+  NOYX_ASSERT_EQ(rb.size(), (rb_t::size_type)3);
+  NOYX_ASSERT_EQ(rb[0], std::string("2"));
+
+  rb.reserve(100);
+  NOYX_ASSERT_EQ(rb.capacity(), (rb_t::size_type)3);
+
+  rb_t copy = rb;
+  NOYX_ASSERT_EQ(copy[2], std::string("4"));
+
+  rb_t moved = std::move(copy);
+  NOYX_ASSERT_EQ(moved.size(), (rb_t::size_type)3);
+  NOYX_ASSERT_TRUE(copy.empty());
+  NOYX_ASSERT_EQ(moved[0], std::string("2"));
+}
+
+NOYX_TEST(ring_buffer_test, reject_overflow_policy) {
+  using rb_t = ring_buffer<int, std::allocator<int>,
+    voxory::containers::ring_policy::dynamic_capacity, voxory::containers::ring_policy::overflow_reject>;
+  rb_t rb(4);
+  NOYX_ASSERT_TRUE(rb.push_back(1));
+
+  const int src[5] = { 2, 3, 4, 5, 6 };
+  NOYX_ASSERT_EQ(rb.append(src), (rb_t::size_type)3);
+  NOYX_ASSERT_FALSE(rb.push_back(7));
+  NOYX_ASSERT_EQ(rb.size(), (rb_t::size_type)4);
+  NOYX_ASSERT_EQ(rb.capacity(), (rb_t::size_type)4);
+  NOYX_ASSERT_EQ(rb[3], 4);
+}
+
+NOYX_TEST(ring_buffer_test, locked_allocator) {
+  using alloc_t = voxory::platform::locked_allocator<float>;
+  using rb_t = ring_buffer<float, alloc_t>;
+  auto& stats = voxory::platform::locked_memory_report();
+  const size_t before = stats.allocations.load();
+  {
+    rb_t rb(48000);
+    NOYX_ASSERT_EQ(stats.allocations.load(), before + 1);
+    for (int i = 0; i < 50000; ++i) rb.push_back((float)i);
+    NOYX_ASSERT_EQ(rb.size(), (rb_t::size_type)48000);
+    NOYX_ASSERT_EQ(rb[0], 2000.f);
+  }
+  auto region = voxory::platform::allocate_locked(1);
+  NOYX_ASSERT_TRUE(region.ptr != nullptr);
+  NOYX_ASSERT_TRUE(region.prefaulted);
+  voxory::platform::free_locked(region.ptr, 1);
+}
+
+NOYX_TEST(ring_buffer_test, wrapped_growth_relocates_move_only) {
+  ring_buffer<std::unique_ptr<int>> rb(4);
+  rb.set_overwrite(false);
+  for (int i = 0; i < 4; ++i) rb.push_back(std::make_unique<int>(i));
+  (void)rb.try_pop_front();
+  (void)rb.try_pop_front();
+  rb.push_back(std::make_unique<int>(4));
+  rb.push_back(std::make_unique<int>(5)); // storage is wrapped: [4 5 | 2 3]
+
+  rb.push_back(std::make_unique<int>(6)); // grows
+  NOYX_ASSERT_EQ(rb.size(), (ring_buffer<std::unique_ptr<int>>::size_type)5);
+  for (int i = 0; i < 5; ++i) NOYX_ASSERT_EQ(*rb[i], i + 2);
+}
+
+NOYX_TEST(ring_buffer_test, iterators_and_segments_over_wrapped_storage) {
+  using rb_t = ring_buffer<float>;
+  static_assert(std::random_access_iterator<rb_t::iterator>);
+  static_assert(std::random_access_iterator<rb_t::const_iterator>);
+
+  rb_t rb(8);
+  for (int i = 0; i < 8; ++i) rb.push_back(static_cast<float>(i));
+  rb.discard_front(5);
+  for (int i = 8; i < 12; ++i) rb.push_back(static_cast<float>(i)); // [8 9 10 11 _ 5 6 7]
+
+  rb_t::size_type n = 0;
+  for (float v : rb) NOYX_ASSERT_EQ(v, static_cast<float>(5 + n++));
+  NOYX_ASSERT_EQ(n, rb.size());
+  NOYX_ASSERT_EQ(rb.end() - rb.begin(), (std::ptrdiff_t)7);
+  NOYX_ASSERT_EQ(rb.begin()[4], 9.0f);
+  NOYX_ASSERT_EQ(*std::ranges::max_element(rb), 11.0f);
+
+  std::vector<float> out(rb.size());
+  std::ranges::copy(rb, out.begin());
+  NOYX_ASSERT_EQ(out.front(), 5.0f);
+  NOYX_ASSERT_EQ(out.back(), 11.0f);
+
+  std::transform(rb.begin(), rb.end(), rb.begin(), [](float v) { return v * 2.0f; });
+  NOYX_ASSERT_EQ(rb[0], 10.0f);
+
+  auto seg = rb.segments();
+  NOYX_ASSERT_EQ(seg.first.size(), (size_t)3);
+  NOYX_ASSERT_EQ(seg.second.size(), (size_t)4);
+  NOYX_ASSERT_EQ(seg.size(), rb.size());
+  NOYX_ASSERT_TRUE(seg.second.data() == rb.data());
+
+  float sum = 0.0f;
+  const rb_t& crb = rb;
+  crb.segments().for_each([&](std::span<const float> run) {
+    for (float v : run) sum += v;
+  });
+  NOYX_ASSERT_EQ(sum, 112.0f);
+
+  rb.clear();
+  NOYX_ASSERT_TRUE(rb.begin() == rb.end());
+  NOYX_ASSERT_TRUE(rb.segments().empty());
+}
+
+NOYX_TEST(ring_buffer_test, default_constructed_overwrite_and_block) {
+  using namespace voxory::containers::ring_policy;
+  // overwrite without storage allocates on the first push instead of writing through null
+  ring_buffer<int, std::allocator<int>, dynamic_capacity, overflow_overwrite> dyn;
+  NOYX_ASSERT_TRUE(dyn.push_back(1));
+  NOYX_ASSERT_EQ(dyn.size(), (size_t)1);
+  NOYX_ASSERT_EQ(dyn[0], 1);
+  const int src[6] = { 2, 3, 4, 5, 6, 7 };
+  ring_buffer<int, std::allocator<int>, dynamic_capacity, overflow_overwrite> bulk;
+  NOYX_ASSERT_EQ(bulk.append(src), (size_t)6);
+  NOYX_ASSERT_EQ(bulk[5], 7);
+
+  ring_buffer<int, std::allocator<int>, pow2_capacity, overflow_overwrite> pow2;
+  for (int i = 0; i < 10; ++i) pow2.push_back(i);
+  NOYX_ASSERT_EQ(pow2.size(), pow2.capacity());
+  NOYX_ASSERT_EQ(pow2[pow2.size() - 1], 9);
+
+  // block without storage rejects instead of waiting forever
+  ring_buffer<int, std::allocator<int>, dynamic_capacity, overflow_block> blocking;
+  NOYX_ASSERT_FALSE(blocking.push_back(1));
+  NOYX_ASSERT_EQ(blocking.append(src), (size_t)0);
+  NOYX_ASSERT_TRUE(blocking.empty());
+}
+
+NOYX_TEST(ring_buffer_test, block_producer_waits_for_consumer) {
+  using namespace voxory::containers::ring_policy;
+  constexpr int count = 100000;
+  ring_buffer<int, std::allocator<int>, dynamic_capacity, overflow_block> rb(8);
+
+  // the producer overruns the ring many times over; each pop must wake it
+  std::thread producer([&] {
+    for (int i = 0; i < count; ++i) rb.push_back(i);
+  });
+
+  bool in_order = true;
+  int expected = 0;
+  while (expected < count) {
+    auto v = rb.try_pop_front();
+    if (!v) {
+      std::this_thread::yield();
+      continue;
+    }
+    in_order &= (*v == expected);
+    ++expected;
+  }
+  producer.join();
+
+  NOYX_ASSERT_TRUE(in_order);
+  NOYX_ASSERT_EQ(expected, count);
+  NOYX_ASSERT_TRUE(rb.empty());
+}
+
+#ifdef DEBUG_ITERATORS
+NOYX_TEST(ring_buffer_test, pops_and_overwrites_invalidate_iterators) {
+  ring_buffer<int> rb(4);
+  for (int i = 0; i < 4; ++i) rb.push_back(i);
+
+  auto it = rb.begin();
+  NOYX_ASSERT_TRUE(it._is_valid());
+  (void)rb.try_pop_front();
+  NOYX_ASSERT_FALSE(it._is_valid());
+
+  it = rb.begin();
+  rb.push_back(4); // into free space: still valid
+  NOYX_ASSERT_TRUE(it._is_valid());
+  rb.push_back(5); // full: overwrites the oldest
+  NOYX_ASSERT_FALSE(it._is_valid());
+
+  it = rb.begin();
+  rb.discard_front(1);
+  NOYX_ASSERT_FALSE(it._is_valid());
+
+  it = rb.begin();
+  int out[2];
+  rb.pop_front_into(out);
+  NOYX_ASSERT_FALSE(it._is_valid());
+
+  it = rb.begin();
+  rb.commit_read(1);
+  NOYX_ASSERT_FALSE(it._is_valid());
+}
+#endif // DEBUG_ITERATORS
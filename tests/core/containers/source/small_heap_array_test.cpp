@@ -0,0 +1,84 @@
+// small_heap_array_tests.cpp
+#include <tests_details.h>
+#include <containers/impl/small_heap_array.h>
+#include <string>
+#include <utility>
+
+using voxory::containers::small_heap_array;
+
+NOYX_TEST(small_heap_array_test, stays_inline_until_it_spills) {
+  small_heap_array<int, 4> a(3, 7);
+  NOYX_ASSERT_TRUE(a.is_inlined());
+  NOYX_ASSERT_EQ(a.capacity(), (size_t)4);
+  NOYX_ASSERT_EQ(a.size(), (size_t)3);
+  NOYX_ASSERT_TRUE(reinterpret_cast<const char*>(a.data()) >= reinterpret_cast<const char*>(&a) &&
+                   reinterpret_cast<const char*>(a.data()) < reinterpret_cast<const char*>(&a + 1));
+
+  a.resize(4);
+  NOYX_ASSERT_TRUE(a.is_inlined());
+  a[3] = 9;
+
+  a.resize(10);
+  NOYX_ASSERT_FALSE(a.is_inlined());
+  NOYX_ASSERT_EQ(a.capacity(), (size_t)10);
+  NOYX_ASSERT_EQ(a[0], 7);
+  NOYX_ASSERT_EQ(a[3], 9);
+  NOYX_ASSERT_EQ(a[9], 0);
+
+  a.resize(2);
+  a.shrink_to_fit();
+  NOYX_ASSERT_TRUE(a.is_inlined());
+  NOYX_ASSERT_EQ(a.size(), (size_t)2);
+  NOYX_ASSERT_EQ(a[1], 7);
+
+  a.clear();
+  NOYX_ASSERT_TRUE(a.empty());
+  NOYX_ASSERT_TRUE(a.is_inlined());
+}
+
+NOYX_TEST(small_heap_array_test, copy_and_move_inline_and_heap) {
+  using arr_t = small_heap_array<std::string, 2>;
+  arr_t small(2, std::string(40, 'x'));
+  arr_t big(5, std::string("y"));
+  NOYX_ASSERT_TRUE(small.is_inlined());
+  NOYX_ASSERT_FALSE(big.is_inlined());
+
+  arr_t small_copy(small);
+  NOYX_ASSERT_TRUE(small_copy.is_inlined());
+  NOYX_ASSERT_EQ(small_copy[1], std::string(40, 'x'));
+
+  arr_t moved(std::move(small));
+  NOYX_ASSERT_TRUE(moved.is_inlined());
+  NOYX_ASSERT_EQ(moved.size(), (size_t)2);
+  NOYX_ASSERT_TRUE(small.empty());
+
+  const std::string* heap_data = big.data();
+  arr_t stolen(std::move(big));
+  NOYX_ASSERT_TRUE(stolen.data() == heap_data);
+  NOYX_ASSERT_TRUE(big.empty());
+  NOYX_ASSERT_TRUE(big.is_inlined());
+
+  moved = stolen;
+  NOYX_ASSERT_EQ(moved.size(), (size_t)5);
+  NOYX_ASSERT_FALSE(moved.is_inlined());
+  moved = std::move(small_copy);
+  NOYX_ASSERT_TRUE(moved.is_inlined());
+  NOYX_ASSERT_EQ(moved[0], std::string(40, 'x'));
+
+  size_t count = 0;
+  for (const auto& s : stolen) count += s.size();
+  NOYX_ASSERT_EQ(count, (size_t)5);
+}
+
+NOYX_TEST(small_heap_array_test, default_init_and_reserve) {
+  small_heap_array<float, 8> a(6, voxory::containers::default_init);
+  NOYX_ASSERT_EQ(a.size(), (size_t)6);
+  NOYX_ASSERT_TRUE(a.is_inlined());
+  a.reserve(4);
+  NOYX_ASSERT_TRUE(a.is_inlined());
+  a.reserve(32);
+  NOYX_ASSERT_FALSE(a.is_inlined());
+  NOYX_ASSERT_EQ(a.size(), (size_t)6);
+  a.resize_for_overwrite(32);
+  NOYX_ASSERT_EQ(a.capacity(), (size_t)32);
+}
@@ -0,0 +1,70 @@
+#include <tests_details.h>
+#include <containers/impl/triple_buffer.h>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+using voxory::containers::triple_buffer;
+
+NOYX_TEST(triple_buffer_test, reader_sees_latest_snapshot) {
+  triple_buffer<std::string> captions(std::string("..."));
+  NOYX_ASSERT_FALSE(captions.has_update());
+  NOYX_ASSERT_EQ(captions.read(), std::string("..."));
+
+  captions.write(std::string("hello"));
+  captions.write(std::string("hello world")); // the reader never saw "hello": it is skipped
+  NOYX_ASSERT_TRUE(captions.has_update());
+  NOYX_ASSERT_EQ(captions.read(), std::string("hello world"));
+  NOYX_ASSERT_FALSE(captions.update());
+
+  // the snapshot does not change under the reader while the writer keeps going
+  const std::string& held = captions.read_buffer();
+  captions.write_buffer() = "next";
+  captions.publish();
+  NOYX_ASSERT_EQ(held, std::string("hello world"));
+  NOYX_ASSERT_TRUE(captions.update());
+  NOYX_ASSERT_EQ(captions.read_buffer(), std::string("next"));
+}
+
+NOYX_TEST(triple_buffer_test, concurrent_snapshots_are_never_torn) {
+  struct caption_state {
+    uint64_t revision = 0;
+    uint64_t committed_words = 0;
+    char partial[32] = {};
+  };
+  constexpr uint64_t updates = 200000;
+  triple_buffer<caption_state> state;
+  std::atomic<bool> done{ false };
+
+  std::thread writer([&] {
+    for (uint64_t i = 1; i <= updates; ++i) {
+      caption_state& s = state.write_buffer();
+      s.revision = i;
+      s.committed_words = i * 3;
+      for (char& c : s.partial) c = static_cast<char>('a' + i % 26);
+      state.publish();
+    }
+    done.store(true, std::memory_order_release);
+  });
+
+  uint64_t last = 0;
+  bool consistent = true;
+  bool monotonic = true;
+  for (;;) {
+    const bool finished = done.load(std::memory_order_acquire);
+    const caption_state& s = state.read();
+    if (s.committed_words != s.revision * 3) consistent = false;
+    for (char c : s.partial) {
+      if (s.revision != 0 && c != static_cast<char>('a' + s.revision % 26)) consistent = false;
+    }
+    if (s.revision < last) monotonic = false;
+    last = s.revision;
+    if (finished) break;
+  }
+  writer.join();
+
+  NOYX_ASSERT_TRUE(consistent);
+  NOYX_ASSERT_TRUE(monotonic);
+  NOYX_ASSERT_EQ(state.read().revision, updates);
+}
@@ -0,0 +1,121 @@
+#include <tests_details.h>
+#include <inference/tuning_cache.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using voxory::inference::model_fingerprint;
+using voxory::inference::tuned_params;
+using voxory::inference::tuning_cache;
+using voxory::inference::tuning_key;
+
+namespace {
+  // a fresh directory under the system temp dir, removed again on scope exit
+  struct temp_dir {
+    std::filesystem::path path;
+
+    explicit temp_dir(const char* name) : path(std::filesystem::temp_directory_path() / name) {
+      std::filesystem::remove_all(path);
+      std::filesystem::create_directories(path);
+    }
+    ~temp_dir() {
+      std::error_code ec;
+      std::filesystem::remove_all(path, ec);
+    }
+  };
+
+  void write_file(const std::filesystem::path& file, const std::string& text) {
+    std::ofstream out(file, std::ios::binary | std::ios::trunc);
+    out << text;
+  }
+}
+
+NOYX_TEST(tuning_cache_test, store_find_and_replace) {
+  temp_dir dir("voxory_tuning_cache_store");
+  tuning_cache cache(dir.path / "sub" / "tuning.tsv"); // store() creates the directory
+
+  const tuning_key cpu_a{ "Test CPU A", "1234-abcd", false, 8 };
+  const tuning_key cpu_a_gpu{ "Test CPU A", "1234-abcd", true, 8 };
+  const tuning_key cpu_a_narrow{ "Test CPU A", "1234-abcd", false, 4 };
+  NOYX_ASSERT_FALSE(cache.find(cpu_a).has_value());
+
+  tuned_params p;
+  p.n_threads = 6;
+  p.flash_attn = false;
+  p.encode_ms = 812.5;
+  p.decode_ms = 40.25;
+  NOYX_ASSERT_TRUE(cache.store(cpu_a, p));
+  NOYX_ASSERT_TRUE(std::filesystem::exists(cache.path()));
+
+  auto found = cache.find(cpu_a);
+  NOYX_ASSERT_TRUE(found.has_value());
+  NOYX_ASSERT_EQ(found->n_threads, 6);
+  NOYX_ASSERT_FALSE(found->flash_attn);
+  NOYX_ASSERT_EQ(found->encode_ms, 812.5);
+  NOYX_ASSERT_EQ(found->decode_ms, 40.25);
+  NOYX_ASSERT_FALSE(cache.find(cpu_a_gpu).has_value()); // use_gpu is part of the key
+  NOYX_ASSERT_FALSE(cache.find(cpu_a_narrow).has_value()); // so is the thread ceiling
+
+  // a second key is added, an existing one replaced in place
+  tuned_params gpu;
+  gpu.n_threads = 2;
+  NOYX_ASSERT_TRUE(cache.store(cpu_a_gpu, gpu));
+  p.n_threads = 8;
+  NOYX_ASSERT_TRUE(cache.store(cpu_a, p));
+  NOYX_ASSERT_EQ(cache.find(cpu_a)->n_threads, 8);
+  NOYX_ASSERT_EQ(cache.find(cpu_a_gpu)->n_threads, 2);
+
+  std::ifstream in(cache.path());
+  std::string line;
+  int lines = 0;
+  while (std::getline(in, line)) ++lines;
+  NOYX_ASSERT_EQ(lines, 2);
+}
+
+NOYX_TEST(tuning_cache_test, malformed_lines_are_skipped) {
+  temp_dir dir("voxory_tuning_cache_malformed");
+  const std::filesystem::path file = dir.path / "tuning.tsv";
+  write_file(file,
+    "garbage\n"
+    "cpu\thash\t0\t4\tnot-a-number\t1\t1\t1\n"
+    "cpu\thash\t0\t4\t0\t1\t1\t1\n"             // zero threads is rejected
+    "cpu\thash\t0\t4\t1\t10.5\t2.5\n"            // a field short (no thread ceiling)
+    "cpu\thash\t0\t4\t4\t1\t10.5\t2.5\n"
+    "\n");
+  tuning_cache cache(file);
+
+  auto found = cache.find(tuning_key{ "cpu", "hash", false, 4 });
+  NOYX_ASSERT_TRUE(found.has_value());
+  NOYX_ASSERT_EQ(found->n_threads, 4);
+  NOYX_ASSERT_TRUE(found->flash_attn);
+  NOYX_ASSERT_EQ(found->encode_ms, 10.5);
+
+  // rewriting keeps only the readable entries
+  NOYX_ASSERT_TRUE(cache.store(tuning_key{ "other", "hash", false, 4 }, tuned_params{}));
+  std::ifstream in(file);
+  std::string line;
+  int lines = 0;
+  while (std::getline(in, line)) ++lines;
+  NOYX_ASSERT_EQ(lines, 2);
+}
+
+NOYX_TEST(tuning_cache_test, fingerprint_follows_the_file_contents) {
+  temp_dir dir("voxory_tuning_cache_fingerprint");
+  const std::filesystem::path model = dir.path / "model.bin";
+  NOYX_ASSERT_TRUE(model_fingerprint(model).empty()); // missing file
+
+  std::string bytes(3u << 20, 'a'); // 3 MiB: first, middle and last MiB are sampled
+  write_file(model, bytes);
+  const std::string original = model_fingerprint(model);
+  NOYX_ASSERT_FALSE(original.empty());
+  NOYX_ASSERT_EQ(model_fingerprint(model), original);
+
+  bytes[(3u << 20) / 2] = 'b'; // same size, one sampled byte differs
+  write_file(model, bytes);
+  const std::string edited = model_fingerprint(model);
+  NOYX_ASSERT_TRUE(edited != original);
+
+  bytes.push_back('a'); // size alone changes it too
+  write_file(model, bytes);
+  NOYX_ASSERT_TRUE(model_fingerprint(model) != edited);
+}
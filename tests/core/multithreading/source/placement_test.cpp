@@ -0,0 +1,91 @@
+#include <tests_details.h>
+#include <platform/cpu_topology.h>
+#include <algorithm>
+
+using namespace voxory::platform;
+
+namespace {
+  // cores x smt threads, cores_per_l3 cores share a cache; the last `e_cores` cores are efficiency cores
+  cpu_topology make_topology(unsigned cores, unsigned smt, unsigned cores_per_l3, unsigned e_cores = 0) {
+    cpu_topology topo;
+    for (unsigned t = 0; t < smt; ++t) {
+      for (unsigned c = 0; c < cores; ++c) {
+        logical_cpu cpu;
+        cpu.id = t * cores + c; // Linux numbering: siblings are cores apart
+        cpu.core = c;
+        cpu.smt_index = t;
+        cpu.l3 = (c / cores_per_l3) * cores_per_l3;
+        cpu.efficiency_class = c >= cores - e_cores ? 0 : 1;
+        topo.cpus.push_back(cpu);
+      }
+    }
+    std::sort(topo.cpus.begin(), topo.cpus.end(), [](auto& a, auto& b) { return a.id < b.id; });
+    return topo;
+  }
+}
+
+NOYX_TEST(placement_test, parse_cpu_list) {
+  auto v = internal::parse_cpu_list("0-3,8,10-11\n");
+  NOYX_ASSERT_EQ(v.size(), (size_t)7);
+  NOYX_ASSERT_EQ(v[3], 3u);
+  NOYX_ASSERT_EQ(v[4], 8u);
+  NOYX_ASSERT_EQ(v[6], 11u);
+  NOYX_ASSERT_TRUE(internal::parse_cpu_list("").empty());
+}
+
+// 8 cores with SMT: one thread per core, the last core kept for capture, no siblings used
+NOYX_TEST(placement_test, smt_siblings_are_skipped) {
+  auto topo = make_topology(8, 2, 8);
+  NOYX_ASSERT_TRUE(topo.has_smt());
+  NOYX_ASSERT_EQ(topo.physical_count(), (size_t)8);
+
+  auto plan = plan_placement(topo);
+  NOYX_ASSERT_EQ(plan.capture_cpus.size(), (size_t)1);
+  NOYX_ASSERT_EQ(plan.capture_cpus[0], 7u);
+  NOYX_ASSERT_EQ(plan.inference_cpus.size(), (size_t)7);
+  for (unsigned id : plan.inference_cpus) NOYX_ASSERT_LE(id, 6u);
+}
+
+NOYX_TEST(placement_test, hybrid_uses_p_cores_and_e_core_for_capture) {
+  auto topo = make_topology(12, 1, 12, 4);
+  NOYX_ASSERT_TRUE(topo.is_hybrid());
+  auto plan = plan_placement(topo);
+  NOYX_ASSERT_EQ(plan.inference_cpus.size(), (size_t)8);
+  NOYX_ASSERT_EQ(plan.capture_cpus.size(), (size_t)1);
+  NOYX_ASSERT_TRUE(plan.capture_cpus[0] >= 8u);
+}
+
+// two cache groups: a small request stays inside one L3
+NOYX_TEST(placement_test, workers_share_an_l3) {
+  auto topo = make_topology(16, 1, 8);
+  auto plan = plan_placement(topo, placement_request{ 4, 1 });
+  NOYX_ASSERT_EQ(plan.inference_cpus.size(), (size_t)4);
+  unsigned group = plan.inference_cpus[0] / 8;
+  for (unsigned id : plan.inference_cpus) NOYX_ASSERT_EQ(id / 8, group);
+}
+
+// a cpuset holding only second hardware threads still gets one cpu per core
+NOYX_TEST(placement_test, second_threads_only_fall_back_per_core) {
+  auto topo = make_topology(8, 2, 8);
+  topo.cpus.erase(std::remove_if(topo.cpus.begin(), topo.cpus.end(),
+    [](const logical_cpu& c) { return c.smt_index == 0; }), topo.cpus.end());
+
+  auto plan = plan_placement(topo);
+  NOYX_ASSERT_EQ(plan.capture_cpus.size(), (size_t)1);
+  NOYX_ASSERT_EQ(plan.inference_cpus.size(), (size_t)7);
+  for (unsigned id : plan.inference_cpus) NOYX_ASSERT_TRUE(id >= 8u);
+}
+
+NOYX_TEST(placement_test, tiny_machine_reserves_nothing) {
+  auto plan = plan_placement(make_topology(2, 1, 2));
+  NOYX_ASSERT_TRUE(plan.capture_cpus.empty());
+  NOYX_ASSERT_EQ(plan.inference_cpus.size(), (size_t)2);
+}
+
+// whatever the host, detection yields a usable plan
+NOYX_TEST(placement_test, host_detection) {
+  auto topo = cpu_topology::detect();
+  NOYX_ASSERT_TRUE(topo.logical_count() >= 1);
+  auto plan = plan_placement(topo);
+  NOYX_ASSERT_FALSE(plan.inference_cpus.empty());
+}
@@ -0,0 +1,45 @@
+#include <tests_details.h>
+#include <multithreading/spin_lock.h>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using voxory::multithreading::spin_lock;
+using voxory::multithreading::counted_spin_lock;
+
+NOYX_TEST(spin_lock_test, try_lock_and_unlock) {
+  spin_lock l;
+  NOYX_ASSERT_FALSE(l.is_locked());
+  NOYX_ASSERT_TRUE(l.try_lock());
+  NOYX_ASSERT_TRUE(l.is_locked());
+  NOYX_ASSERT_FALSE(l.try_lock());
+  l.unlock();
+  NOYX_ASSERT_FALSE(l.is_locked());
+  NOYX_ASSERT_EQ(sizeof(spin_lock), sizeof(uint32_t));
+}
+
+// more threads than cores: waiters have to park for the holder to make progress
+NOYX_TEST(spin_lock_test, oversubscribed_counter) {
+  counted_spin_lock l;
+  const size_t threads = std::thread::hardware_concurrency() * 2 + 2;
+  constexpr size_t iterations = 20000;
+  size_t counter = 0;
+
+  std::vector<std::thread> pool;
+  for (size_t t = 0; t < threads; ++t) {
+    pool.emplace_back([&] {
+      for (size_t i = 0; i < iterations; ++i) {
+        std::lock_guard<counted_spin_lock> guard(l);
+        ++counter;
+      }
+    });
+  }
+  for (auto& th : pool) th.join();
+
+  NOYX_ASSERT_EQ(counter, threads * iterations);
+  NOYX_ASSERT_FALSE(l.is_locked());
+  const auto& s = l.stats();
+  NOYX_ASSERT_EQ(s.acquisitions.load(), (uint64_t)(threads * iterations));
+  NOYX_ASSERT_LE(s.parked.load(), s.contended.load());
+  NOYX_ASSERT_LE(s.contended.load(), s.acquisitions.load());
+}
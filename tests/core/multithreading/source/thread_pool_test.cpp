@@ -0,0 +1,131 @@
+#include <tests_details.h>
+#include <multithreading/thread_pool.h>
+#include <multithreading/work_stealing_deque.h>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using voxory::multithreading::thread_pool;
+using voxory::multithreading::thread_pool_options;
+using voxory::multithreading::task_group;
+using voxory::multithreading::task_priority;
+using voxory::multithreading::work_stealing_deque;
+using voxory::multithreading::parallel_for;
+
+NOYX_TEST(work_stealing_deque_test, owner_lifo_thief_fifo) {
+  work_stealing_deque<int> dq(2);
+  for (int i = 0; i < 10; ++i) dq.push(i); // grows past the initial capacity
+  NOYX_ASSERT_EQ(dq.size(), (size_t)10);
+  NOYX_ASSERT_EQ(*dq.pop(), 9);
+  NOYX_ASSERT_EQ(*dq.steal(), 0);
+  NOYX_ASSERT_EQ(*dq.steal(), 1);
+  NOYX_ASSERT_EQ(*dq.pop(), 8);
+  NOYX_ASSERT_EQ(dq.size(), (size_t)6);
+}
+
+// every element is taken exactly once by either the owner or one of the thieves
+NOYX_TEST(work_stealing_deque_test, concurrent_steal) {
+  constexpr int N = 100000;
+  work_stealing_deque<int> dq(64);
+  std::vector<std::atomic<int>> seen(N);
+  std::atomic<bool> done{ false };
+  std::atomic<int> taken{ 0 };
+
+  std::vector<std::thread> thieves;
+  for (int t = 0; t < 3; ++t) {
+    thieves.emplace_back([&] {
+      while (!done.load(std::memory_order_acquire) || !dq.empty()) {
+        if (auto v = dq.steal()) {
+          seen[*v].fetch_add(1);
+          taken.fetch_add(1);
+        }
+      }
+    });
+  }
+  for (int i = 0; i < N; ++i) {
+    dq.push(i);
+    if ((i & 3) == 0) {
+      if (auto v = dq.pop()) {
+        seen[*v].fetch_add(1);
+        taken.fetch_add(1);
+      }
+    }
+  }
+  while (auto v = dq.pop()) {
+    seen[*v].fetch_add(1);
+    taken.fetch_add(1);
+  }
+  done.store(true, std::memory_order_release);
+  for (auto& t : thieves) t.join();
+
+  NOYX_ASSERT_EQ(taken.load(), N);
+  bool once = true;
+  for (auto& s : seen) once &= s.load() == 1;
+  NOYX_ASSERT_TRUE(once);
+}
+
+NOYX_TEST(thread_pool_test, task_group_runs_everything) {
+  thread_pool_options options;
+  options.threads = 4;
+  thread_pool pool(options);
+  std::atomic<int> sum{ 0 };
+  task_group group(pool);
+  for (int i = 1; i <= 1000; ++i) {
+    group.run([&sum, i] { sum.fetch_add(i, std::memory_order_relaxed); },
+              i % 3 == 0 ? task_priority::high : task_priority::low);
+  }
+  group.wait();
+  NOYX_ASSERT_EQ(sum.load(), 500500);
+}
+
+NOYX_TEST(thread_pool_test, task_group_rethrows) {
+  thread_pool_options options;
+  options.threads = 2;
+  thread_pool pool(options);
+  task_group group(pool);
+  group.run([] { throw std::runtime_error("boom"); });
+  group.run([] {});
+  bool thrown = false;
+  try {
+    group.wait();
+  }
+  catch (const std::runtime_error&) {
+    thrown = true;
+  }
+  NOYX_ASSERT_TRUE(thrown);
+}
+
+// parallel_for called from inside pool tasks must not deadlock
+NOYX_TEST(thread_pool_test, nested_parallel_for) {
+  thread_pool_options options;
+  options.threads = 2;
+  thread_pool pool(options);
+  constexpr size_t outer = 8, inner = 1000;
+  std::vector<std::atomic<int>> hits(outer * inner);
+
+  parallel_for(pool, size_t(0), outer, [&](size_t lo, size_t hi) {
+    for (size_t o = lo; o < hi; ++o) {
+      parallel_for(pool, size_t(0), inner, [&](size_t a, size_t b) {
+        for (size_t i = a; i < b; ++i) hits[o * inner + i].fetch_add(1, std::memory_order_relaxed);
+      }, size_t(64));
+    }
+  }, size_t(1));
+
+  bool once = true;
+  for (auto& h : hits) once &= h.load() == 1;
+  NOYX_ASSERT_TRUE(once);
+  NOYX_ASSERT_EQ(pool.pending(), (size_t)0);
+}
+
+NOYX_TEST(thread_pool_test, destructor_drains_queue) {
+  std::atomic<int> ran{ 0 };
+  {
+    thread_pool_options options;
+    options.threads = 2;
+    options.pin_threads = true;
+    thread_pool pool(options);
+    for (int i = 0; i < 100; ++i) pool.submit([&ran] { ran.fetch_add(1); });
+  }
+  NOYX_ASSERT_EQ(ran.load(), 100);
+}